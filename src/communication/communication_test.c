@@ -1,7 +1,136 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 #include <stdio.h>
+#include <string.h>
+#include <time.h>
 #include "protocol_stack.h"
 #include "data_transfer.h"
 #include "synchronization.h"
+#include "crc32.h"
+#include "packet_codec.h"
+#include "packet_pool.h"
+#include "process_image.h"
+#include "tx_queue.h"
+#include "trace.h"
+#include "udp_transport.h"
+
+// 过程映像测试：一个节点的输出，经回环作为同一节点的输入收回
+typedef struct {
+    float position_command[4];
+    float torque_limit;
+    uint16_t control_word;
+} TestNodeImage_t;
+
+static const PdoEntry_t g_test_pdo_entries[] = {
+    PDO_ENTRY(TestNodeImage_t, control_word),
+    PDO_ENTRY(TestNodeImage_t, position_command),
+    PDO_ENTRY(TestNodeImage_t, torque_limit),
+};
+
+// 发送队列测试：记录发送顺序（帧头第3字节为优先级）
+static uint8_t g_sent_priorities[64];
+static int g_sent_count = 0;
+
+static bool record_transmit(ProtocolType link, const uint8_t* frame, uint16_t length)
+{
+    (void)link;
+    (void)length;
+    if (g_sent_count < (int)sizeof(g_sent_priorities))
+    {
+        g_sent_priorities[g_sent_count] = frame[2];
+    }
+    g_sent_count++;
+    return true;
+}
+
+// 编码一个指定优先级的空数据包并入队
+static bool queue_test_packet(PriorityLevel priority)
+{
+    PacketBuffer_t* buffer = PacketPool_Acquire();
+    if (buffer == NULL)
+    {
+        return false;
+    }
+    
+    buffer->header = (PacketHeader_t){ PROTOCOL_CANOPEN, DATA_TYPE_REAL_TIME, priority, 0, 0, 1, 2, 0 };
+    buffer->frame_length = PacketCodec_EncodeHeader(&buffer->header, buffer->frame, sizeof(buffer->frame));
+    return TxQueue_Enqueue(PROTOCOL_CANOPEN, buffer);
+}
+
+// 关闭发送队列时并发入队的生产者线程，统计被接受的数据包数
+static atomic_int g_accepted_count;
+
+static void* shutdown_producer(void* arg)
+{
+    (void)arg;
+    for (int i = 0; i < 2000; i++)
+    {
+        if (queue_test_packet((i % 10 == 0) ? PRIORITY_HIGH : PRIORITY_LOW))
+        {
+            atomic_fetch_add(&g_accepted_count, 1);
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+// 多个生产者同时向高优先级队列入队，缓冲池空时让出CPU重试
+#define HIGH_PRODUCER_PACKETS 5000
+
+static void* high_priority_producer(void* arg)
+{
+    (void)arg;
+    for (int i = 0; i < HIGH_PRODUCER_PACKETS; i++)
+    {
+        while (!queue_test_packet(PRIORITY_HIGH))
+        {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+// 跟踪测试：每个线程记录一个事件后退出
+static void* trace_thread(void* arg)
+{
+    (void)arg;
+    Trace_SetThreadName("trace_test");
+    Trace_Record(TRACE_LEVEL_INFO, TRACE_FRAME_SENT, PROTOCOL_CANOPEN, 0, 0);
+    return NULL;
+}
+
+// 经当前传输发送关节数据和系统状态再接收，检查内容和顺序，最后队列应为空
+static bool transport_round_trip(const JointData_t* joint_data, const SystemState_t* system_state)
+{
+    uint16_t joint_id = 0;
+    JointData_t received_joint;
+    SystemState_t received_state;
+    
+    if (!DataTransfer_SendJointData(3, joint_data, PRIORITY_HIGH) ||
+        !DataTransfer_SendSystemState(system_state, PRIORITY_MEDIUM))
+    {
+        return false;
+    }
+    
+    if (!DataTransfer_ReceiveJointData(&joint_id, &received_joint) || joint_id != 3 ||
+        memcmp(&received_joint, joint_data, sizeof(JointData_t)) != 0)
+    {
+        return false;
+    }
+    
+    if (!DataTransfer_ReceiveSystemState(&received_state) ||
+        memcmp(&received_state, system_state, sizeof(SystemState_t)) != 0)
+    {
+        return false;
+    }
+    
+    // 没有更多的帧
+    return !DataTransfer_ReceiveJointData(&joint_id, &received_joint);
+}
 
 int main(void)
 {
@@ -9,6 +138,11 @@ int main(void)
     
     // 1. 测试协议栈初始化
     printf("1. 测试协议栈初始化...\n");
+    if (PacketPool_Acquire() != NULL)  // 缓冲池初始化之前不能申请缓冲区
+    {
+        printf("   ❌ 缓冲池初始化之前申请到缓冲区\n");
+        return -1;
+    }
     if (ProtocolStack_Init(PROTOCOL_CANOPEN))
     {
         printf("   ✅ 协议栈初始化成功\n");
@@ -135,6 +269,598 @@ int main(void)
     Synchronization_Close();
     printf("   ✅ 同步模块关闭成功\n");
     
+    // 10. 测试CRC实现一致性
+    printf("\n10. 测试CRC实现一致性...\n");
+    static uint8_t crc_buffer[2048];
+    for (uint32_t i = 0; i < sizeof(crc_buffer); i++)
+    {
+        crc_buffer[i] = (uint8_t)(i * 131 + 7);
+    }
+    
+    bool crc_ok = true;
+    for (int variant = 0; variant < CRC32_VARIANT_MAX; variant++)
+    {
+        Crc32Impl selected = Crc32_GetImplementation((Crc32Variant)variant);
+        
+        // 标准校验值："123456789"
+        uint32_t expected = (variant == CRC32_VARIANT_IEEE) ? 0xCBF43926 : 0xE3069283;
+        for (int impl = 0; impl < CRC32_IMPL_MAX; impl++)
+        {
+            if (!Crc32_SetImplementation((Crc32Variant)variant, (Crc32Impl)impl))
+            {
+                printf("   - %s: 当前CPU不支持\n", Crc32_GetImplementationName((Crc32Variant)variant, (Crc32Impl)impl));
+                continue;
+            }
+            
+            uint32_t check = (variant == CRC32_VARIANT_IEEE)
+                ? crc32_calculate((const uint8_t*)"123456789", 9)
+                : crc32c_calculate((const uint8_t*)"123456789", 9);
+            if (check != expected)
+            {
+                crc_ok = false;
+            }
+            
+            // 各种长度和对齐方式下与逐位参考实现比较
+            for (uint32_t offset = 0; offset < 8; offset++)
+            {
+                for (uint32_t length = 0; length + offset <= sizeof(crc_buffer); length += 7)
+                {
+                    uint32_t crc = (variant == CRC32_VARIANT_IEEE)
+                        ? crc32_calculate(crc_buffer + offset, length)
+                        : crc32c_calculate(crc_buffer + offset, length);
+                    Crc32_SetImplementation((Crc32Variant)variant, CRC32_IMPL_BITWISE);
+                    uint32_t reference = (variant == CRC32_VARIANT_IEEE)
+                        ? crc32_calculate(crc_buffer + offset, length)
+                        : crc32c_calculate(crc_buffer + offset, length);
+                    Crc32_SetImplementation((Crc32Variant)variant, (Crc32Impl)impl);
+                    if (crc != reference)
+                    {
+                        crc_ok = false;
+                    }
+                }
+            }
+            printf("   - %s: 0x%08X\n", Crc32_GetImplementationName((Crc32Variant)variant, (Crc32Impl)impl), check);
+        }
+        
+        Crc32_SetImplementation((Crc32Variant)variant, selected);
+    }
+    
+    // 分段计算与整体计算结果一致
+    uint32_t split_crc = crc32_update(crc32_calculate(crc_buffer, 100), crc_buffer + 100, 900);
+    if (split_crc != crc32_calculate(crc_buffer, 1000))
+    {
+        crc_ok = false;
+    }
+    
+    if (crc_ok)
+    {
+        printf("   ✅ CRC实现一致性测试通过\n");
+    }
+    else
+    {
+        printf("   ❌ CRC实现一致性测试失败\n");
+    }
+    
+    // 11. 测试数据包编解码
+    printf("\n11. 测试数据包编解码...\n");
+    Packet_t packet;
+    packet.protocol_type = PROTOCOL_CANOPEN;
+    packet.data_type = DATA_TYPE_REAL_TIME;
+    packet.priority = PRIORITY_HIGH;
+    packet.packet_id = 0x1234;
+    packet.timestamp = 0xA1B2C3D4;
+    packet.source_id = 0x0001;
+    packet.destination_id = 0x0002;
+    packet.payload_length = sizeof(uint16_t) + sizeof(JointData_t);
+    uint16_t joint_id = 3;
+    memcpy(packet.payload, &joint_id, sizeof(uint16_t));
+    memcpy(packet.payload + sizeof(uint16_t), &joint_data, sizeof(JointData_t));
+    
+    uint8_t frame[PACKET_WIRE_MAX_SIZE];
+    uint16_t frame_length = PacketCodec_Encode(&packet, frame, sizeof(frame));
+    printf("   关节数据帧长度：%d 字节 (Packet_t: %d 字节)\n", frame_length, (int)sizeof(Packet_t));
+    
+    Packet_t decoded;
+    bool codec_ok = (frame_length == PACKET_WIRE_HEADER_SIZE + packet.payload_length + PACKET_WIRE_CRC_SIZE) &&
+                    PacketCodec_Decode(frame, frame_length, &decoded) &&
+                    decoded.protocol_type == packet.protocol_type &&
+                    decoded.data_type == packet.data_type &&
+                    decoded.priority == packet.priority &&
+                    decoded.packet_id == packet.packet_id &&
+                    decoded.timestamp == packet.timestamp &&
+                    decoded.source_id == packet.source_id &&
+                    decoded.destination_id == packet.destination_id &&
+                    decoded.payload_length == packet.payload_length &&
+                    memcmp(decoded.payload, packet.payload, packet.payload_length) == 0;
+    
+    // 任意一个字节出错或长度不符都应被拒绝
+    for (uint16_t i = 0; i < frame_length; i++)
+    {
+        frame[i] ^= 0x01;
+        if (PacketCodec_Decode(frame, frame_length, &decoded))
+        {
+            codec_ok = false;
+        }
+        frame[i] ^= 0x01;
+    }
+    if (PacketCodec_Decode(frame, frame_length - 1, &decoded) ||
+        PacketCodec_Encode(&packet, frame, frame_length - 1) != 0)
+    {
+        codec_ok = false;
+    }
+    
+    if (codec_ok)
+    {
+        printf("   ✅ 数据包编解码测试通过\n");
+    }
+    else
+    {
+        printf("   ❌ 数据包编解码测试失败\n");
+    }
+    
+    // 12. 测试数据包缓冲池
+    printf("\n12. 测试数据包缓冲池...\n");
+    PacketPoolStats_t pool_stats;
+    PacketPool_GetStats(&pool_stats);
+    bool pool_ok = (pool_stats.in_use == 0) && (pool_stats.acquire_count > 0);  // 前面的发送已归还缓冲区
+    printf("   前面的测试：申请 %u 次，最大占用 %d\n", (unsigned)pool_stats.acquire_count, pool_stats.high_water);
+    
+    PacketBuffer_t* buffers[PACKET_POOL_CAPACITY];
+    for (int i = 0; i < PACKET_POOL_CAPACITY; i++)
+    {
+        buffers[i] = PacketPool_Acquire();
+        if (buffers[i] == NULL)
+        {
+            pool_ok = false;
+        }
+    }
+    if (PacketPool_Acquire() != NULL)  // 缓冲池已耗尽
+    {
+        pool_ok = false;
+    }
+    
+    // 有效载荷在缓冲区内就地写入，编码后直接解析
+    PacketBuffer_t* pool_buffer = buffers[0];
+    memcpy(PacketPool_Payload(pool_buffer), &joint_data, sizeof(JointData_t));
+    pool_buffer->header = (PacketHeader_t){ PROTOCOL_CANOPEN, DATA_TYPE_REAL_TIME, PRIORITY_HIGH, 7, 0, 1, 2, sizeof(JointData_t) };
+    pool_buffer->frame_length = PacketCodec_EncodeHeader(&pool_buffer->header, pool_buffer->frame, sizeof(pool_buffer->frame));
+    PacketHeader_t pool_header;
+    if (!PacketCodec_DecodeHeader(pool_buffer->frame, pool_buffer->frame_length, &pool_header) ||
+        pool_header.packet_id != 7 ||
+        memcmp(PacketPool_ConstPayload(pool_buffer), &joint_data, sizeof(JointData_t)) != 0)
+    {
+        pool_ok = false;
+    }
+    
+    for (int i = 0; i < PACKET_POOL_CAPACITY; i++)
+    {
+        PacketPool_Release(buffers[i]);
+    }
+    PacketPool_Release(buffers[0]);  // 重复释放应被拒绝
+    
+    PacketPool_GetStats(&pool_stats);
+    if (pool_stats.in_use != 0 || pool_stats.high_water != PACKET_POOL_CAPACITY ||
+        pool_stats.acquire_failures != 1 || pool_stats.release_errors != 1)
+    {
+        pool_ok = false;
+    }
+    
+    if (pool_ok)
+    {
+        printf("   ✅ 数据包缓冲池测试通过\n");
+    }
+    else
+    {
+        printf("   ❌ 数据包缓冲池测试失败\n");
+    }
+    
+    // 13. 测试优先级发送队列
+    printf("\n13. 测试优先级发送队列...\n");
+    TxQueueConfig_t tx_config;
+    TxQueue_GetDefaultConfig(&tx_config);
+    tx_config.weights[PRIORITY_MEDIUM] = 3;  // 中/低优先级按3:1轮转
+    tx_config.weights[PRIORITY_LOW] = 1;
+    tx_config.transmit = record_transmit;
+    bool tx_ok = TxQueue_Init(&tx_config);
+    
+    // 低优先级先入队，高优先级后入队但先发送
+    for (int i = 0; i < 4; i++)
+    {
+        tx_ok = queue_test_packet(PRIORITY_LOW) && tx_ok;
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        tx_ok = queue_test_packet(PRIORITY_MEDIUM) && tx_ok;
+    }
+    tx_ok = queue_test_packet(PRIORITY_HIGH) && queue_test_packet(PRIORITY_HIGH) && tx_ok;
+    
+    const uint8_t expected_order[] = { PRIORITY_HIGH, PRIORITY_HIGH,
+                                       PRIORITY_MEDIUM, PRIORITY_MEDIUM, PRIORITY_MEDIUM, PRIORITY_LOW,
+                                       PRIORITY_MEDIUM, PRIORITY_LOW, PRIORITY_LOW, PRIORITY_LOW };
+    if (TxQueue_Process(PROTOCOL_CANOPEN, -1) != (int)sizeof(expected_order) ||
+        memcmp(g_sent_priorities, expected_order, sizeof(expected_order)) != 0)
+    {
+        tx_ok = false;
+    }
+    
+    // 低优先级排队上限：超出的数据包被丢弃，不会占满缓冲池
+    for (int i = 0; i <= tx_config.queue_limits[PRIORITY_LOW]; i++)
+    {
+        queue_test_packet(PRIORITY_LOW);
+    }
+    TxQueueStats_t tx_stats;
+    TxQueue_GetStats(PROTOCOL_CANOPEN, PRIORITY_LOW, &tx_stats);
+    if (tx_stats.dropped != 1 || tx_stats.depth != tx_config.queue_limits[PRIORITY_LOW])
+    {
+        tx_ok = false;
+    }
+    TxQueue_Process(PROTOCOL_CANOPEN, -1);
+    
+    // 工作线程发送，关闭时发送剩余数据包；只统计这一阶段的排队延迟
+    g_sent_count = 0;
+    TxQueue_ResetStats();
+    tx_ok = TxQueue_StartWorker(PROTOCOL_CANOPEN) && tx_ok;
+    for (int i = 0; i < 1000; i++)
+    {
+        while (!queue_test_packet((i % 10 == 0) ? PRIORITY_HIGH : PRIORITY_LOW))
+        {
+            sched_yield();  // 低优先级队列满时让工作线程发送
+        }
+    }
+    TxQueue_Shutdown();
+    
+    TxQueue_GetStats(PROTOCOL_CANOPEN, PRIORITY_HIGH, &tx_stats);
+    printf("   高优先级排队延迟：平均 %u ns，p99.9 %u ns，最大 %u ns\n",
+           tx_stats.delay_mean, tx_stats.delay_p999, tx_stats.delay_max);
+    PacketPool_GetStats(&pool_stats);
+    if (g_sent_count != 1000 || tx_stats.sent != 100 || TxQueue_IsEnabled() || pool_stats.in_use != 0)
+    {
+        tx_ok = false;
+    }
+    
+    // 多生产者并发入队：高优先级队列容量不小于缓冲池，不应丢包
+    g_sent_count = 0;
+    tx_ok = TxQueue_Init(&tx_config) && TxQueue_StartWorker(PROTOCOL_CANOPEN) && tx_ok;
+    pthread_t producers[4];
+    for (int i = 0; i < 4; i++)
+    {
+        pthread_create(&producers[i], NULL, high_priority_producer, NULL);
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        pthread_join(producers[i], NULL);
+    }
+    TxQueue_Shutdown();
+    TxQueue_GetStats(PROTOCOL_CANOPEN, PRIORITY_HIGH, &tx_stats);
+    PacketPool_GetStats(&pool_stats);
+    printf("   多生产者高优先级入队：发送 %d 个，丢弃 %u 个\n", g_sent_count, tx_stats.dropped);
+    if (tx_stats.dropped != 0 || g_sent_count != 4 * HIGH_PRODUCER_PACKETS || pool_stats.in_use != 0)
+    {
+        tx_ok = false;
+    }
+    
+    // 生产者入队的同时关闭：每个被接受的数据包都被发送，缓冲区全部归还
+    g_sent_count = 0;
+    atomic_store(&g_accepted_count, 0);
+    tx_ok = TxQueue_Init(&tx_config) && TxQueue_StartWorker(PROTOCOL_CANOPEN) && tx_ok;
+    for (int i = 0; i < 2; i++)
+    {
+        pthread_create(&producers[i], NULL, shutdown_producer, NULL);
+    }
+    struct timespec shutdown_delay = { 0, 2000000 };
+    nanosleep(&shutdown_delay, NULL);
+    TxQueue_Shutdown();
+    for (int i = 0; i < 2; i++)
+    {
+        pthread_join(producers[i], NULL);
+    }
+    PacketPool_GetStats(&pool_stats);
+    printf("   关闭时并发入队：接受 %d 个，发送 %d 个\n", atomic_load(&g_accepted_count), g_sent_count);
+    if (g_sent_count != atomic_load(&g_accepted_count) || pool_stats.in_use != 0)
+    {
+        tx_ok = false;
+    }
+    
+    if (tx_ok)
+    {
+        printf("   ✅ 优先级发送队列测试通过\n");
+    }
+    else
+    {
+        printf("   ❌ 优先级发送队列测试失败\n");
+    }
+    
+    // 14. 测试二进制跟踪
+    printf("\n14. 测试二进制跟踪...\n");
+    uint32_t trace_count = Trace_GetRecordCount();
+    bool trace_ok = (trace_count > 0);  // 前面的发送已记录跟踪事件
+    
+    const uint32_t trace_iterations = 1000000;
+    clock_t trace_start = clock();
+    for (uint32_t i = 0; i < trace_iterations; i++)
+    {
+        Trace_Record(TRACE_LEVEL_INFO, TRACE_FRAME_SENT, PROTOCOL_CANOPEN, i, 0);
+    }
+    double trace_ns = (double)(clock() - trace_start) / CLOCKS_PER_SEC * 1e9 / trace_iterations;
+    printf("   每个事件记录耗时：%.1f ns\n", trace_ns);
+    
+    if (Trace_GetRecordCount() - trace_count != trace_iterations ||
+        Trace_GetEventFormat(TRACE_FRAME_SENT) == NULL || Trace_GetEventFormat(TRACE_EVENT_MAX) != NULL)
+    {
+        trace_ok = false;
+    }
+    
+    // 退出的线程归还环形缓冲区：先后运行的线程数超过TRACE_MAX_THREADS时记录也不丢失
+    trace_count = Trace_GetRecordCount();
+    for (int i = 0; i < 2 * TRACE_MAX_THREADS; i++)
+    {
+        pthread_t trace_tid;
+        pthread_create(&trace_tid, NULL, trace_thread, NULL);
+        pthread_join(trace_tid, NULL);
+    }
+    if (Trace_GetRecordCount() - trace_count != 2 * TRACE_MAX_THREADS)
+    {
+        printf("   ❌ 已退出线程的环形缓冲区没有被复用\n");
+        trace_ok = false;
+    }
+    
+    // 导出后用trace_decode离线查看
+    if (Trace_Dump("communication_trace.bin"))
+    {
+        printf("   跟踪已导出到communication_trace.bin\n");
+    }
+    else
+    {
+        trace_ok = false;
+    }
+    
+    if (trace_ok)
+    {
+        printf("   ✅ 二进制跟踪测试通过\n");
+    }
+    else
+    {
+        printf("   ❌ 二进制跟踪测试失败\n");
+    }
+    
+    // 15. 测试回环和UDP传输
+    printf("\n15. 测试回环和UDP传输...\n");
+    if (ProtocolStack_Init(PROTOCOL_LOOPBACK) && transport_round_trip(&joint_data, &system_state))
+    {
+        printf("   ✅ 回环传输收发成功\n");
+    }
+    else
+    {
+        printf("   ❌ 回环传输收发失败\n");
+    }
+    ProtocolStack_Close();
+    
+    // 单节点测试需要接收本节点发送的帧
+    UdpTransportConfig_t udp_config;
+    UdpTransport_GetDefaultConfig(&udp_config);
+    udp_config.receive_own = true;
+    udp_config.receive_timeout_ms = 100;
+    UdpTransport_Configure(&udp_config);
+    if (ProtocolStack_Init(PROTOCOL_UDP) && transport_round_trip(&joint_data, &system_state))
+    {
+        printf("   ✅ UDP组播传输收发成功\n");
+    }
+    else
+    {
+        printf("   ❌ UDP组播传输收发失败\n");
+    }
+    ProtocolStack_Close();
+    
+    // 16. 测试多链路路由
+    printf("\n16. 测试多链路路由...\n");
+    bool route_ok = ProtocolStack_Init(PROTOCOL_LOOPBACK) &&
+                    ProtocolStack_OpenLink(PROTOCOL_UDP) &&
+                    ProtocolStack_SetRoute(DATA_TYPE_NON_REAL_TIME, PROTOCOL_UDP);
+    
+    // 关节数据走默认的回环链路，系统状态走UDP链路，回环链路上不应有系统状态
+    route_ok = route_ok && transport_round_trip(&joint_data, &system_state);
+    
+    // 头部记录实际发送的链路
+    route_ok = DataTransfer_SendSystemState(&system_state, PRIORITY_MEDIUM) && route_ok;
+    const PacketBuffer_t* route_buffer = ProtocolStack_ReceiveLinkBuffer(PROTOCOL_UDP);
+    if (route_buffer == NULL || route_buffer->header.protocol_type != PROTOCOL_UDP)
+    {
+        route_ok = false;
+    }
+    if (route_buffer != NULL)
+    {
+        PacketPool_Release(route_buffer);
+    }
+    
+    // 事件数据改走UDP链路：从UDP链路收到，默认的回环链路上没有数据包
+    EventData_t route_event;
+    route_ok = ProtocolStack_SetRoute(DATA_TYPE_EVENT, PROTOCOL_UDP) &&
+               DataTransfer_SendEventData(&event_data, PRIORITY_HIGH) && route_ok;
+    route_buffer = ProtocolStack_ReceiveLinkBuffer(PROTOCOL_LOOPBACK);
+    if (route_buffer != NULL)
+    {
+        PacketPool_Release(route_buffer);
+        route_ok = false;
+    }
+    if (!DataTransfer_ReceiveEventData(&route_event) || route_event.event_id != event_data.event_id ||
+        strcmp(route_event.event_description, event_data.event_description) != 0)
+    {
+        route_ok = false;
+    }
+    
+    // 每条链路一个工作线程，关闭发送队列时发送剩余数据包
+    route_ok = TxQueue_Init(NULL) && TxQueue_StartWorker(PROTOCOL_LOOPBACK) &&
+               TxQueue_StartWorker(PROTOCOL_UDP) && route_ok;
+    route_ok = DataTransfer_SendJointData(3, &joint_data, PRIORITY_HIGH) &&
+               DataTransfer_SendSystemState(&system_state, PRIORITY_MEDIUM) && route_ok;
+    TxQueue_Shutdown();
+    TxQueue_GetStats(PROTOCOL_UDP, PRIORITY_MEDIUM, &tx_stats);
+    if (tx_stats.sent != 1)
+    {
+        route_ok = false;
+    }
+    
+    uint16_t route_joint_id = 0;
+    JointData_t route_joint;
+    SystemState_t route_state;
+    if (!DataTransfer_ReceiveJointData(&route_joint_id, &route_joint) || route_joint_id != 3 ||
+        !DataTransfer_ReceiveSystemState(&route_state) ||
+        memcmp(&route_state, &system_state, sizeof(SystemState_t)) != 0)
+    {
+        route_ok = false;
+    }
+    
+    // 关闭链路后路由回到默认链路
+    if (!ProtocolStack_CloseLink(PROTOCOL_UDP) ||
+        ProtocolStack_GetRoute(DATA_TYPE_NON_REAL_TIME) != PROTOCOL_LOOPBACK ||
+        ProtocolStack_GetRoute(DATA_TYPE_EVENT) != PROTOCOL_LOOPBACK ||
+        ProtocolStack_CloseLink(PROTOCOL_LOOPBACK))
+    {
+        route_ok = false;
+    }
+    ProtocolStack_Close();
+    
+    if (route_ok)
+    {
+        printf("   ✅ 多链路路由测试通过\n");
+    }
+    else
+    {
+        printf("   ❌ 多链路路由测试失败\n");
+    }
+    
+    // 17. 测试关节帧
+    printf("\n17. 测试关节帧...\n");
+    JointData_t frame_joints[DATA_TRANSFER_MAX_JOINTS];
+    JointData_t received_joints[DATA_TRANSFER_MAX_JOINTS];
+    memset(received_joints, 0, sizeof(received_joints));
+    for (int i = 0; i < DATA_TRANSFER_MAX_JOINTS; i++)
+    {
+        frame_joints[i] = (JointData_t){ 0.1f * i, 0.2f, 3.0f, 0.0f };
+    }
+    
+    // 关节0、2、5、31共用一个数据包
+    const uint32_t frame_mask = (1u << 0) | (1u << 2) | (1u << 5) | (1u << 31);
+    uint32_t received_mask = 0;
+    uint32_t cycle_timestamp = 0;
+    bool frame_ok = ProtocolStack_Init(PROTOCOL_LOOPBACK) &&
+                    DataTransfer_SendJointFrame(frame_mask, frame_joints, 12345, PRIORITY_HIGH) &&
+                    DataTransfer_ReceiveJointFrame(&received_mask, received_joints, &cycle_timestamp);
+    if (received_mask != frame_mask || cycle_timestamp != 12345 ||
+        memcmp(&received_joints[5], &frame_joints[5], sizeof(JointData_t)) != 0 ||
+        memcmp(&received_joints[31], &frame_joints[31], sizeof(JointData_t)) != 0 ||
+        received_joints[1].position != 0.0f)
+    {
+        frame_ok = false;
+    }
+    
+    // 空位图被拒绝，单关节数据包不会被当作关节帧
+    uint16_t frame_joint_id;
+    frame_ok = !DataTransfer_SendJointFrame(0, frame_joints, 0, PRIORITY_HIGH) && frame_ok;
+    frame_ok = DataTransfer_SendJointData(1, &frame_joints[1], PRIORITY_HIGH) &&
+               !DataTransfer_ReceiveJointFrame(&received_mask, received_joints, NULL) && frame_ok;
+    frame_ok = DataTransfer_SendJointFrame(frame_mask, frame_joints, 0, PRIORITY_HIGH) &&
+               !DataTransfer_ReceiveJointData(&frame_joint_id, &received_joints[0]) && frame_ok;
+    
+    // 关节帧单独路由到UDP链路，与单关节数据交错发送时两者都不丢失
+    frame_ok = ProtocolStack_OpenLink(PROTOCOL_UDP) &&
+               ProtocolStack_SetRoute(DATA_TYPE_JOINT_FRAME, PROTOCOL_UDP) && frame_ok;
+    frame_ok = DataTransfer_SendJointFrame(frame_mask, frame_joints, 777, PRIORITY_HIGH) &&
+               DataTransfer_SendJointData(4, &frame_joints[4], PRIORITY_HIGH) && frame_ok;
+    memset(received_joints, 0, sizeof(received_joints));
+    if (!DataTransfer_ReceiveJointData(&frame_joint_id, &received_joints[4]) || frame_joint_id != 4 ||
+        !DataTransfer_ReceiveJointFrame(&received_mask, received_joints, &cycle_timestamp) ||
+        received_mask != frame_mask || cycle_timestamp != 777 ||
+        memcmp(&received_joints[31], &frame_joints[31], sizeof(JointData_t)) != 0)
+    {
+        frame_ok = false;
+    }
+    ProtocolStack_Close();
+    
+    if (frame_ok)
+    {
+        printf("   ✅ 关节帧测试通过\n");
+    }
+    else
+    {
+        printf("   ❌ 关节帧测试失败\n");
+    }
+    
+    // 18. 测试过程映像周期交换
+    printf("\n18. 测试过程映像周期交换...\n");
+    ProcessImage_Init();
+    PdoMapping_t pdo_mapping = { 7, PROCESS_IMAGE_OUTPUT, sizeof(TestNodeImage_t),
+                                 sizeof(g_test_pdo_entries) / sizeof(g_test_pdo_entries[0]), g_test_pdo_entries };
+    int output_image = ProcessImage_Register(&pdo_mapping);
+    pdo_mapping.direction = PROCESS_IMAGE_INPUT;
+    int input_image = ProcessImage_Register(&pdo_mapping);
+    bool image_ok = ProtocolStack_Init(PROTOCOL_UDP) && output_image >= 0 && input_image >= 0 &&
+                    ProcessImage_Register(&pdo_mapping) < 0;  // 同一节点和方向不能重复注册
+    
+    // 过程数据与其他数据类型共用链路时拒绝交换，不会取走其他数据类型的帧
+    image_ok = ProtocolStack_OpenLink(PROTOCOL_LOOPBACK) &&
+               DataTransfer_SendSystemState(&system_state, PRIORITY_MEDIUM) &&
+               ProtocolStack_SetRoute(DATA_TYPE_PROCESS_DATA, PROTOCOL_UDP) &&
+               !ProcessImage_Exchange(0) && image_ok;
+    
+    // 过程数据走专用的回环链路，其他数据类型留在默认的UDP链路上
+    SystemState_t shared_state;
+    image_ok = ProtocolStack_SetRoute(DATA_TYPE_PROCESS_DATA, PROTOCOL_LOOPBACK) &&
+               DataTransfer_ReceiveSystemState(&shared_state) &&
+               memcmp(&shared_state, &system_state, sizeof(SystemState_t)) == 0 &&
+               image_ok;
+    
+    // 控制代码直接写结构体，每个周期交换一次
+    for (uint32_t cycle = 1; image_ok && cycle <= 3; cycle++)
+    {
+        TestNodeImage_t* outputs = (TestNodeImage_t*)ProcessImage_Write(output_image);
+        outputs->position_command[3] = 0.25f * cycle;
+        outputs->control_word = (uint16_t)cycle;
+        if (cycle == 1)
+        {
+            outputs->torque_limit = 40.0f;
+        }
+        
+        image_ok = ProcessImage_Exchange(cycle * 1000);
+        const TestNodeImage_t* inputs = (const TestNodeImage_t*)ProcessImage_Read(input_image);
+        if (inputs->position_command[3] != 0.25f * cycle || inputs->control_word != cycle ||
+            inputs->torque_limit != 40.0f || ProcessImage_GetAge(input_image) != 0)
+        {
+            image_ok = false;
+        }
+    }
+    
+    // 没有新数据包时输入映像保持上一周期的值
+    ProcessImage_Init();
+    input_image = ProcessImage_Register(&pdo_mapping);
+    ProcessImage_Exchange(0);
+    if (ProcessImage_GetAge(input_image) != UINT32_MAX)
+    {
+        image_ok = false;
+    }
+    
+    // 映射不一致的数据包被拒绝
+    pdo_mapping.direction = PROCESS_IMAGE_OUTPUT;
+    pdo_mapping.entry_count = 2;
+    ProcessImage_Register(&pdo_mapping);
+    ProcessImage_Exchange(0);
+    ProcessImageStats_t image_stats;
+    ProcessImage_GetStats(&image_stats);
+    if (image_stats.sent != 1 || image_stats.rejected != 1 || image_stats.received != 0 || image_stats.missed != 2)
+    {
+        image_ok = false;
+    }
+    ProtocolStack_Close();
+    
+    if (image_ok)
+    {
+        printf("   ✅ 过程映像周期交换测试通过\n");
+    }
+    else
+    {
+        printf("   ❌ 过程映像周期交换测试失败\n");
+    }
+    
     printf("\n=== 通信模块测试完成 ===\n");
     return 0;
 }
@@ -0,0 +1,501 @@
+#include "crc32.h"
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRC32_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) && defined(__aarch64__) && defined(__linux__)
+#define CRC32_HAVE_ARMV8 1
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+#if defined(__clang__)
+#define CRC32_TARGET_ARMV8 __attribute__((target("crc")))
+#else
+#define CRC32_TARGET_ARMV8 __attribute__((target("+crc")))
+#endif
+#endif
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define CRC32_LITTLE_ENDIAN 1
+#endif
+
+// 反射多项式
+#define CRC32_POLY_IEEE       0xEDB88320u
+#define CRC32_POLY_CASTAGNOLI 0x82F63B78u
+
+// 计算函数：输入输出均为取反前的内部CRC状态
+typedef uint32_t (*crc32_function)(uint32_t crc, const uint8_t* data, size_t length);
+
+// 切片查找表：table[k][i]为字节i后面再跟k个零字节时的CRC
+static uint32_t g_table_ieee[8][256];
+static uint32_t g_table_castagnoli[8][256];
+static volatile bool g_crc32_initialized = false;
+
+static crc32_function g_functions[CRC32_VARIANT_MAX];
+static Crc32Impl g_implementations[CRC32_VARIANT_MAX];
+
+// 生成切片查找表
+static void build_table(uint32_t table[8][256], uint32_t poly)
+{
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t crc = i;
+        for (uint32_t j = 0; j < 8; j++)
+        {
+            if (crc & 1)
+                crc = (crc >> 1) ^ poly;
+            else
+                crc = crc >> 1;
+        }
+        table[0][i] = crc;
+    }
+
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        for (uint32_t k = 1; k < 8; k++)
+        {
+            table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+        }
+    }
+}
+
+// 逐位计算（每字节8次迭代）
+static uint32_t crc_bitwise(uint32_t crc, const uint8_t* data, size_t length, uint32_t poly)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (uint32_t j = 0; j < 8; j++)
+        {
+            if (crc & 1)
+                crc = (crc >> 1) ^ poly;
+            else
+                crc = crc >> 1;
+        }
+    }
+    return crc;
+}
+
+// 8字节切片查表：每8字节8次查表，各次查表互不依赖
+static uint32_t crc_slice8(const uint32_t table[8][256], uint32_t crc, const uint8_t* data, size_t length)
+{
+#if defined(CRC32_LITTLE_ENDIAN)
+    // 逐字节处理到8字节对齐
+    while (length > 0 && ((uintptr_t)data & 7) != 0)
+    {
+        crc = table[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+        length--;
+    }
+
+    while (length >= 8)
+    {
+        uint32_t low, high;
+        memcpy(&low, data, sizeof(low));
+        memcpy(&high, data + 4, sizeof(high));
+        low ^= crc;
+        crc = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF] ^
+              table[5][(low >> 16) & 0xFF] ^ table[4][low >> 24] ^
+              table[3][high & 0xFF] ^ table[2][(high >> 8) & 0xFF] ^
+              table[1][(high >> 16) & 0xFF] ^ table[0][high >> 24];
+        data += 8;
+        length -= 8;
+    }
+#endif
+
+    // 剩余字节（大端平台全部）逐字节查表
+    while (length > 0)
+    {
+        crc = table[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+        length--;
+    }
+    return crc;
+}
+
+static uint32_t crc32_bitwise_ieee(uint32_t crc, const uint8_t* data, size_t length)
+{
+    return crc_bitwise(crc, data, length, CRC32_POLY_IEEE);
+}
+
+static uint32_t crc32_bitwise_castagnoli(uint32_t crc, const uint8_t* data, size_t length)
+{
+    return crc_bitwise(crc, data, length, CRC32_POLY_CASTAGNOLI);
+}
+
+static uint32_t crc32_slice8_ieee(uint32_t crc, const uint8_t* data, size_t length)
+{
+    return crc_slice8(g_table_ieee, crc, data, length);
+}
+
+static uint32_t crc32_slice8_castagnoli(uint32_t crc, const uint8_t* data, size_t length)
+{
+    return crc_slice8(g_table_castagnoli, crc, data, length);
+}
+
+#if defined(CRC32_HAVE_X86)
+// PCLMULQDQ折叠（Intel白皮书 "Fast CRC Computation for Generic Polynomials
+// Using PCLMULQDQ Instruction"，反射域常数）。length至少64且为16的倍数：
+// 4路并行折叠64字节块，再折叠为128位，最后Barrett约简为32位
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t crc32_pclmul_fold(uint32_t crc, const uint8_t* data, size_t length)
+{
+    static const uint64_t k1k2[2] __attribute__((aligned(16))) = {0x0154442bd4ull, 0x01c6e41596ull};
+    static const uint64_t k3k4[2] __attribute__((aligned(16))) = {0x01751997d0ull, 0x00ccaa009eull};
+    static const uint64_t k5k0[2] __attribute__((aligned(16))) = {0x0163cd6124ull, 0x0000000000ull};
+    static const uint64_t poly[2] __attribute__((aligned(16))) = {0x01db710641ull, 0x01f7011641ull};
+
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+    x1 = _mm_loadu_si128((const __m128i*)(data + 0x00));
+    x2 = _mm_loadu_si128((const __m128i*)(data + 0x10));
+    x3 = _mm_loadu_si128((const __m128i*)(data + 0x20));
+    x4 = _mm_loadu_si128((const __m128i*)(data + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    x0 = _mm_load_si128((const __m128i*)k1k2);
+    data += 64;
+    length -= 64;
+
+    // 4路并行折叠
+    while (length >= 64)
+    {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+        y5 = _mm_loadu_si128((const __m128i*)(data + 0x00));
+        y6 = _mm_loadu_si128((const __m128i*)(data + 0x10));
+        y7 = _mm_loadu_si128((const __m128i*)(data + 0x20));
+        y8 = _mm_loadu_si128((const __m128i*)(data + 0x30));
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+
+        data += 64;
+        length -= 64;
+    }
+
+    // 折叠为128位
+    x0 = _mm_load_si128((const __m128i*)k3k4);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // 剩余16字节块逐块折叠
+    while (length >= 16)
+    {
+        x2 = _mm_loadu_si128((const __m128i*)data);
+
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+        data += 16;
+        length -= 16;
+    }
+
+    // 128位折叠为64位
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+
+    x0 = _mm_loadl_epi64((const __m128i*)k5k0);
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett约简为32位
+    x0 = _mm_load_si128((const __m128i*)poly);
+
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+static uint32_t crc32_pclmul_ieee(uint32_t crc, const uint8_t* data, size_t length)
+{
+    if (length >= 64)
+    {
+        size_t chunk = length & ~(size_t)15;
+        crc = crc32_pclmul_fold(crc, data, chunk);
+        data += chunk;
+        length -= chunk;
+    }
+    return crc_slice8(g_table_ieee, crc, data, length);
+}
+
+// SSE4.2 crc32指令只支持Castagnoli多项式
+__attribute__((target("sse4.2")))
+static uint32_t crc32_sse42_castagnoli(uint32_t crc, const uint8_t* data, size_t length)
+{
+    while (length > 0 && ((uintptr_t)data & 7) != 0)
+    {
+        crc = _mm_crc32_u8(crc, *data++);
+        length--;
+    }
+
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    while (length >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += 8;
+        length -= 8;
+    }
+    crc = (uint32_t)crc64;
+#endif
+
+    while (length >= 4)
+    {
+        uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+        data += 4;
+        length -= 4;
+    }
+
+    while (length > 0)
+    {
+        crc = _mm_crc32_u8(crc, *data++);
+        length--;
+    }
+    return crc;
+}
+#endif
+
+#if defined(CRC32_HAVE_ARMV8)
+// ARMv8 CRC32扩展同时提供IEEE和Castagnoli两种多项式的指令
+CRC32_TARGET_ARMV8
+static uint32_t crc32_armv8_ieee(uint32_t crc, const uint8_t* data, size_t length)
+{
+    while (length > 0 && ((uintptr_t)data & 7) != 0)
+    {
+        crc = __crc32b(crc, *data++);
+        length--;
+    }
+
+    while (length >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = __crc32d(crc, word);
+        data += 8;
+        length -= 8;
+    }
+
+    while (length > 0)
+    {
+        crc = __crc32b(crc, *data++);
+        length--;
+    }
+    return crc;
+}
+
+CRC32_TARGET_ARMV8
+static uint32_t crc32_armv8_castagnoli(uint32_t crc, const uint8_t* data, size_t length)
+{
+    while (length > 0 && ((uintptr_t)data & 7) != 0)
+    {
+        crc = __crc32cb(crc, *data++);
+        length--;
+    }
+
+    while (length >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = __crc32cd(crc, word);
+        data += 8;
+        length -= 8;
+    }
+
+    while (length > 0)
+    {
+        crc = __crc32cb(crc, *data++);
+        length--;
+    }
+    return crc;
+}
+#endif
+
+// 查找实现对应的计算函数，CPU不支持时返回NULL
+static crc32_function find_function(Crc32Variant variant, Crc32Impl impl)
+{
+    bool ieee = (variant == CRC32_VARIANT_IEEE);
+
+    switch (impl)
+    {
+        case CRC32_IMPL_BITWISE:
+            return ieee ? crc32_bitwise_ieee : crc32_bitwise_castagnoli;
+
+        case CRC32_IMPL_SLICE8:
+            return ieee ? crc32_slice8_ieee : crc32_slice8_castagnoli;
+
+        case CRC32_IMPL_HARDWARE:
+#if defined(CRC32_HAVE_X86)
+            __builtin_cpu_init();
+            if (ieee && __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1"))
+                return crc32_pclmul_ieee;
+            if (!ieee && __builtin_cpu_supports("sse4.2"))
+                return crc32_sse42_castagnoli;
+#elif defined(CRC32_HAVE_ARMV8)
+            if (getauxval(AT_HWCAP) & HWCAP_CRC32)
+                return ieee ? crc32_armv8_ieee : crc32_armv8_castagnoli;
+#endif
+            return NULL;
+
+        default:
+            return NULL;
+    }
+}
+
+// 初始化CRC模块
+void Crc32_Init(void)
+{
+    if (g_crc32_initialized)
+    {
+        return;
+    }
+
+    build_table(g_table_ieee, CRC32_POLY_IEEE);
+    build_table(g_table_castagnoli, CRC32_POLY_CASTAGNOLI);
+
+    for (int variant = 0; variant < CRC32_VARIANT_MAX; variant++)
+    {
+        Crc32Impl impl = CRC32_IMPL_HARDWARE;
+        crc32_function function = find_function((Crc32Variant)variant, impl);
+        if (function == NULL)
+        {
+            impl = CRC32_IMPL_SLICE8;
+            function = find_function((Crc32Variant)variant, impl);
+        }
+        g_functions[variant] = function;
+        g_implementations[variant] = impl;
+    }
+
+    g_crc32_initialized = true;
+}
+
+// 查询当前CPU是否支持某个实现
+bool Crc32_IsSupported(Crc32Variant variant, Crc32Impl impl)
+{
+    if (variant >= CRC32_VARIANT_MAX)
+    {
+        return false;
+    }
+    return find_function(variant, impl) != NULL;
+}
+
+// 强制使用某个实现
+bool Crc32_SetImplementation(Crc32Variant variant, Crc32Impl impl)
+{
+    Crc32_Init();
+
+    if (variant >= CRC32_VARIANT_MAX)
+    {
+        return false;
+    }
+
+    crc32_function function = find_function(variant, impl);
+    if (function == NULL)
+    {
+        return false;
+    }
+
+    g_functions[variant] = function;
+    g_implementations[variant] = impl;
+    return true;
+}
+
+// 获取当前使用的实现
+Crc32Impl Crc32_GetImplementation(Crc32Variant variant)
+{
+    Crc32_Init();
+
+    if (variant >= CRC32_VARIANT_MAX)
+    {
+        return CRC32_IMPL_MAX;
+    }
+    return g_implementations[variant];
+}
+
+// 获取实现名称
+const char* Crc32_GetImplementationName(Crc32Variant variant, Crc32Impl impl)
+{
+    (void)variant;
+
+    switch (impl)
+    {
+        case CRC32_IMPL_BITWISE:
+            return "bitwise";
+
+        case CRC32_IMPL_SLICE8:
+            return "slicing-by-8";
+
+        case CRC32_IMPL_HARDWARE:
+#if defined(CRC32_HAVE_ARMV8)
+            return "armv8-crc";
+#else
+            return variant == CRC32_VARIANT_IEEE ? "pclmul" : "sse4.2";
+#endif
+
+        default:
+            return "unknown";
+    }
+}
+
+// 在已有CRC-32结果上继续计算
+uint32_t crc32_update(uint32_t crc, const uint8_t* data, uint32_t length)
+{
+    Crc32_Init();
+    return ~g_functions[CRC32_VARIANT_IEEE](~crc, data, length);
+}
+
+// 计算CRC-32
+uint32_t crc32_calculate(const uint8_t* data, uint32_t length)
+{
+    return crc32_update(0, data, length);
+}
+
+// 在已有CRC-32C结果上继续计算
+uint32_t crc32c_update(uint32_t crc, const uint8_t* data, uint32_t length)
+{
+    Crc32_Init();
+    return ~g_functions[CRC32_VARIANT_CASTAGNOLI](~crc, data, length);
+}
+
+// 计算CRC-32C
+uint32_t crc32c_calculate(const uint8_t* data, uint32_t length)
+{
+    return crc32c_update(0, data, length);
+}
@@ -0,0 +1,51 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// CRC校验变体
+typedef enum {
+    CRC32_VARIANT_IEEE = 0,        // CRC-32 (IEEE 802.3, 多项式0xEDB88320反射)，数据包校验使用
+    CRC32_VARIANT_CASTAGNOLI = 1,  // CRC-32C (Castagnoli, 多项式0x82F63B78反射)
+    CRC32_VARIANT_MAX
+} Crc32Variant;
+
+// CRC计算实现
+typedef enum {
+    CRC32_IMPL_BITWISE = 0,        // 逐位计算，参考实现
+    CRC32_IMPL_SLICE8 = 1,         // 8字节切片查表，所有平台可用
+    CRC32_IMPL_HARDWARE = 2,       // 硬件加速：x86 PCLMULQDQ折叠/SSE4.2 crc32指令，ARMv8 CRC32指令
+    CRC32_IMPL_MAX
+} Crc32Impl;
+
+// 初始化CRC模块：生成查找表并按CPU特性选择最快的实现
+// 首次计算时会自动调用，多线程使用前应先显式调用一次
+void Crc32_Init(void);
+
+// 查询当前CPU是否支持某个实现
+bool Crc32_IsSupported(Crc32Variant variant, Crc32Impl impl);
+
+// 强制使用某个实现（用于测试和基准测试），CPU不支持时返回false
+bool Crc32_SetImplementation(Crc32Variant variant, Crc32Impl impl);
+
+// 获取当前使用的实现
+Crc32Impl Crc32_GetImplementation(Crc32Variant variant);
+
+// 获取实现名称
+const char* Crc32_GetImplementationName(Crc32Variant variant, Crc32Impl impl);
+
+// 计算CRC-32
+uint32_t crc32_calculate(const uint8_t* data, uint32_t length);
+
+// 在已有CRC-32结果上继续计算，用于分段数据；初始值为0
+// crc32_update(crc32_calculate(a, n), b, m) 等于a、b连续时的crc32_calculate结果
+uint32_t crc32_update(uint32_t crc, const uint8_t* data, uint32_t length);
+
+// 计算CRC-32C
+uint32_t crc32c_calculate(const uint8_t* data, uint32_t length);
+
+// 在已有CRC-32C结果上继续计算；初始值为0
+uint32_t crc32c_update(uint32_t crc, const uint8_t* data, uint32_t length);
+
+#endif // CRC32_H
@@ -0,0 +1,100 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "crc32.h"
+#include "protocol_stack.h"
+
+// CRC吞吐量基准测试：各实现在不同数据长度下的GB/s
+// 用法：crc32_benchmark [每项测试时间(秒)]
+
+// 获取单调时钟时间 (单位: 秒)
+static double get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char* argv[])
+{
+    double min_time = (argc > 1) ? atof(argv[1]) : 0.2;
+    if (min_time <= 0.0)
+    {
+        printf("Usage: %s [seconds per measurement]\n", argv[0]);
+        return 1;
+    }
+
+    // 18字节：一个关节数据包的有效载荷；sizeof(Packet_t)-4：编解码器之前整包校验的长度
+    const uint32_t lengths[] = {18, 64, sizeof(Packet_t) - sizeof(uint32_t), 4096, 1 << 20};
+    const int num_lengths = sizeof(lengths) / sizeof(lengths[0]);
+    const uint32_t max_length = 1 << 20;
+
+    uint8_t* buffer = (uint8_t*)malloc(max_length);
+    if (buffer == NULL)
+    {
+        printf("Failed to allocate benchmark buffer\n");
+        return 1;
+    }
+    for (uint32_t i = 0; i < max_length; i++)
+    {
+        buffer[i] = (uint8_t)(i * 2654435761u >> 24);
+    }
+
+    Crc32_Init();
+    printf("CRC throughput [GB/s], default: crc32 = %s, crc32c = %s\n",
+           Crc32_GetImplementationName(CRC32_VARIANT_IEEE, Crc32_GetImplementation(CRC32_VARIANT_IEEE)),
+           Crc32_GetImplementationName(CRC32_VARIANT_CASTAGNOLI, Crc32_GetImplementation(CRC32_VARIANT_CASTAGNOLI)));
+    printf("%-8s %-14s", "variant", "implementation");
+    for (int l = 0; l < num_lengths; l++)
+    {
+        printf(" %9uB", lengths[l]);
+    }
+    printf("\n");
+
+    volatile uint32_t sink = 0;
+    for (int variant = 0; variant < CRC32_VARIANT_MAX; variant++)
+    {
+        Crc32Impl selected = Crc32_GetImplementation((Crc32Variant)variant);
+        for (int impl = 0; impl < CRC32_IMPL_MAX; impl++)
+        {
+            if (!Crc32_SetImplementation((Crc32Variant)variant, (Crc32Impl)impl))
+            {
+                continue;
+            }
+            printf("%-8s %-14s", variant == CRC32_VARIANT_IEEE ? "crc32" : "crc32c",
+                   Crc32_GetImplementationName((Crc32Variant)variant, (Crc32Impl)impl));
+
+            for (int l = 0; l < num_lengths; l++)
+            {
+                // 重复计算直到超过测试时间，迭代次数按倍数增长
+                uint64_t iterations = 1;
+                double elapsed = 0.0;
+                for (;;)
+                {
+                    double start = get_time();
+                    for (uint64_t n = 0; n < iterations; n++)
+                    {
+                        sink += (variant == CRC32_VARIANT_IEEE)
+                            ? crc32_calculate(buffer, lengths[l])
+                            : crc32c_calculate(buffer, lengths[l]);
+                    }
+                    elapsed = get_time() - start;
+                    if (elapsed >= min_time)
+                    {
+                        break;
+                    }
+                    iterations *= 2;
+                }
+                printf(" %10.3f", (double)lengths[l] * iterations / elapsed * 1e-9);
+                fflush(stdout);
+            }
+            printf("\n");
+        }
+        Crc32_SetImplementation((Crc32Variant)variant, selected);
+    }
+
+    (void)sink;
+    free(buffer);
+    return 0;
+}
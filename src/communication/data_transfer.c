@@ -1,22 +1,81 @@
 #include "data_transfer.h"
+#include "packet_pool.h"
 #include <string.h>
 
 // 全局变量定义
 static DataTransferState g_transfer_state = DATA_TRANSFER_IDLE;
 static uint16_t g_packet_counter = 0;
 
-// 数据类型ID定义
-#define DATA_TYPE_JOINT     0x01
-#define DATA_TYPE_SYSTEM    0x02
-#define DATA_TYPE_EVENT     0x03
-#define DATA_TYPE_CUSTOM    0x04
-
 // 生成唯一数据包ID
 static uint16_t generate_packet_id(void)
 {
     return g_packet_counter++;
 }
 
+// 从缓冲池申请发送缓冲区并设置头部，有效载荷由调用者在缓冲区内直接写入
+// 头部的协议类型记录数据类型当前路由到的链路
+static PacketBuffer_t* acquire_buffer(DataType data_type, PriorityLevel priority, uint16_t destination_id)
+{
+    PacketBuffer_t* buffer = PacketPool_Acquire();
+    if (buffer == NULL)
+    {
+        g_transfer_state = DATA_TRANSFER_ERROR;
+        return NULL;
+    }
+    
+    PacketHeader_t* header = &buffer->header;
+    header->protocol_type = ProtocolStack_GetRoute(data_type);
+    header->data_type = data_type;
+    header->priority = priority;
+    header->packet_id = generate_packet_id();
+    header->timestamp = 0; // 待实现：获取系统时间戳
+    header->source_id = 0x0001; // 待实现：获取本地设备ID
+    header->destination_id = destination_id; // 待实现：获取目标设备ID
+    header->payload_length = 0;
+    return buffer;
+}
+
+// 发送缓冲区，缓冲区所有权交给协议栈
+static bool transmit_buffer(PacketBuffer_t* buffer)
+{
+    g_transfer_state = DATA_TRANSFER_SENDING;
+    bool result = ProtocolStack_SendBuffer(buffer);
+    
+    if (result)
+    {
+        g_transfer_state = DATA_TRANSFER_COMPLETED;
+    }
+    else
+    {
+        g_transfer_state = DATA_TRANSFER_ERROR;
+    }
+    
+    return result;
+}
+
+// 从数据类型路由到的链路接收数据包并检查数据类型和有效载荷长度，返回的缓冲区由调用者释放
+static const PacketBuffer_t* receive_buffer(DataType data_type, uint16_t min_length, uint16_t max_length)
+{
+    g_transfer_state = DATA_TRANSFER_RECEIVING;
+    const PacketBuffer_t* buffer = ProtocolStack_ReceiveLinkBuffer(ProtocolStack_GetRoute(data_type));
+    if (buffer == NULL)
+    {
+        g_transfer_state = DATA_TRANSFER_ERROR;
+        return NULL;
+    }
+    
+    // 检查数据包类型和长度
+    if (buffer->header.data_type != data_type ||
+        buffer->header.payload_length < min_length || buffer->header.payload_length > max_length)
+    {
+        PacketPool_Release(buffer);
+        g_transfer_state = DATA_TRANSFER_ERROR;
+        return NULL;
+    }
+    
+    return buffer;
+}
+
 // 初始化数据传输模块
 bool DataTransfer_Init(void)
 {
@@ -34,21 +93,15 @@ bool DataTransfer_SendJointData(uint16_t joint_id, const JointData_t* joint_data
         return false;
     }
     
-    // 创建数据包
-    Packet_t packet;
-    memset(&packet, 0, sizeof(Packet_t));
-    
-    // 设置数据包头部
-    packet.protocol_type = PROTOCOL_CANOPEN; // 默认使用CANopen协议
-    packet.data_type = DATA_TYPE_REAL_TIME;
-    packet.priority = priority;
-    packet.packet_id = generate_packet_id();
-    packet.timestamp = 0; // 待实现：获取系统时间戳
-    packet.source_id = 0x0001; // 待实现：获取本地设备ID
-    packet.destination_id = 0x0002; // 待实现：获取目标设备ID
+    // 申请数据包缓冲区
+    PacketBuffer_t* buffer = acquire_buffer(DATA_TYPE_REAL_TIME, priority, 0x0002);
+    if (buffer == NULL)
+    {
+        return false;
+    }
     
-    // 打包关节数据
-    uint8_t* payload_ptr = packet.payload;
+    // 在缓冲区内直接打包关节数据
+    uint8_t* payload_ptr = PacketPool_Payload(buffer);
     
     // 写入关节ID
     memcpy(payload_ptr, &joint_id, sizeof(uint16_t));
@@ -59,26 +112,10 @@ bool DataTransfer_SendJointData(uint16_t joint_id, const JointData_t* joint_data
     payload_ptr += sizeof(JointData_t);
     
     // 设置有效载荷长度
-    packet.payload_length = payload_ptr - packet.payload;
-    
-    // 计算CRC32校验
-    packet.crc32 = 0; // 先清零CRC字段
-    packet.crc32 = crc32_calculate((const uint8_t*)&packet, sizeof(Packet_t) - sizeof(packet.crc32));
-    
-    // 发送数据包
-    g_transfer_state = DATA_TRANSFER_SENDING;
-    bool result = ProtocolStack_SendPacket(&packet);
+    buffer->header.payload_length = payload_ptr - PacketPool_Payload(buffer);
     
-    if (result)
-    {
-        g_transfer_state = DATA_TRANSFER_COMPLETED;
-    }
-    else
-    {
-        g_transfer_state = DATA_TRANSFER_ERROR;
-    }
-    
-    return result;
+    // 编码（计算CRC32）并发送
+    return transmit_buffer(buffer);
 }
 
 // 接收关节数据
@@ -90,26 +127,16 @@ bool DataTransfer_ReceiveJointData(uint16_t* joint_id, JointData_t* joint_data)
         return false;
     }
     
-    // 接收数据包
-    Packet_t packet;
-    g_transfer_state = DATA_TRANSFER_RECEIVING;
-    bool result = ProtocolStack_ReceivePacket(&packet);
-    
-    if (!result)
-    {
-        g_transfer_state = DATA_TRANSFER_ERROR;
-        return false;
-    }
-    
-    // 检查数据包类型
-    if (packet.data_type != DATA_TYPE_REAL_TIME)
+    // 接收数据包并检查类型和长度
+    const uint16_t joint_payload_length = sizeof(uint16_t) + sizeof(JointData_t);
+    const PacketBuffer_t* buffer = receive_buffer(DATA_TYPE_REAL_TIME, joint_payload_length, joint_payload_length);
+    if (buffer == NULL)
     {
-        g_transfer_state = DATA_TRANSFER_ERROR;
         return false;
     }
     
     // 解包关节数据
-    const uint8_t* payload_ptr = packet.payload;
+    const uint8_t* payload_ptr = PacketPool_ConstPayload(buffer);
     
     // 读取关节ID
     memcpy(joint_id, payload_ptr, sizeof(uint16_t));
@@ -117,59 +144,117 @@ bool DataTransfer_ReceiveJointData(uint16_t* joint_id, JointData_t* joint_data)
     
     // 读取关节数据
     memcpy(joint_data, payload_ptr, sizeof(JointData_t));
+    PacketPool_Release(buffer);
     
     g_transfer_state = DATA_TRANSFER_COMPLETED;
     return true;
 }
 
-// 发送系统状态数据
-bool DataTransfer_SendSystemState(const SystemState_t* system_state, PriorityLevel priority)
+// 发送关节帧
+bool DataTransfer_SendJointFrame(uint32_t joint_mask, const JointData_t* joint_data, uint32_t cycle_timestamp,
+                                 PriorityLevel priority)
 {
-    if (system_state == NULL)
+    if (joint_mask == 0 || joint_data == NULL)
     {
         g_transfer_state = DATA_TRANSFER_ERROR;
         return false;
     }
     
-    // 创建数据包
-    Packet_t packet;
-    memset(&packet, 0, sizeof(Packet_t));
+    // 申请数据包缓冲区，头部时间戳为周期时间戳
+    PacketBuffer_t* buffer = acquire_buffer(DATA_TYPE_JOINT_FRAME, priority, 0x0002);
+    if (buffer == NULL)
+    {
+        return false;
+    }
+    buffer->header.timestamp = cycle_timestamp;
     
-    // 设置数据包头部
-    packet.protocol_type = PROTOCOL_ETHERCAT; // 默认使用EtherCAT协议
-    packet.data_type = DATA_TYPE_NON_REAL_TIME;
-    packet.priority = priority;
-    packet.packet_id = generate_packet_id();
-    packet.timestamp = 0; // 待实现：获取系统时间戳
-    packet.source_id = 0x0001; // 待实现：获取本地设备ID
-    packet.destination_id = 0x0003; // 待实现：获取目标设备ID
+    // 在缓冲区内直接打包关节位图和各关节数据
+    uint8_t* payload_ptr = PacketPool_Payload(buffer);
     
-    // 打包系统状态数据
-    memcpy(packet.payload, system_state, sizeof(SystemState_t));
-    packet.payload_length = sizeof(SystemState_t);
+    // 写入关节位图
+    memcpy(payload_ptr, &joint_mask, sizeof(uint32_t));
+    payload_ptr += sizeof(uint32_t);
     
-    // 计算CRC32校验
-    packet.crc32 = 0; // 先清零CRC字段
-    packet.crc32 = crc32_calculate((const uint8_t*)&packet, sizeof(Packet_t) - sizeof(packet.crc32));
+    // 按关节ID升序写入关节数据
+    for (uint32_t joint = 0; joint < DATA_TRANSFER_MAX_JOINTS; joint++)
+    {
+        if (joint_mask & (1u << joint))
+        {
+            memcpy(payload_ptr, &joint_data[joint], sizeof(JointData_t));
+            payload_ptr += sizeof(JointData_t);
+        }
+    }
     
-    // 发送数据包
-    g_transfer_state = DATA_TRANSFER_SENDING;
-    bool result = ProtocolStack_SendPacket(&packet);
+    // 设置有效载荷长度
+    buffer->header.payload_length = payload_ptr - PacketPool_Payload(buffer);
     
-    if (result)
+    // 编码（计算CRC32）并发送
+    return transmit_buffer(buffer);
+}
+
+// 接收关节帧
+bool DataTransfer_ReceiveJointFrame(uint32_t* joint_mask, JointData_t* joint_data, uint32_t* cycle_timestamp)
+{
+    if (joint_mask == NULL || joint_data == NULL)
     {
-        g_transfer_state = DATA_TRANSFER_COMPLETED;
+        g_transfer_state = DATA_TRANSFER_ERROR;
+        return false;
     }
-    else
+    
+    // 接收数据包并检查类型和长度，至少包含一个关节
+    const uint16_t min_length = sizeof(uint32_t) + sizeof(JointData_t);
+    const uint16_t max_length = sizeof(uint32_t) + DATA_TRANSFER_MAX_JOINTS * sizeof(JointData_t);
+    const PacketBuffer_t* buffer = receive_buffer(DATA_TYPE_JOINT_FRAME, min_length, max_length);
+    if (buffer == NULL)
+    {
+        return false;
+    }
+    
+    // 解包关节帧
+    const uint8_t* payload_ptr = PacketPool_ConstPayload(buffer);
+    
+    // 读取关节位图，置位的关节数必须与有效载荷长度一致
+    uint32_t mask;
+    memcpy(&mask, payload_ptr, sizeof(uint32_t));
+    payload_ptr += sizeof(uint32_t);
+    uint32_t joint_count = 0;
+    for (uint32_t joint = 0; joint < DATA_TRANSFER_MAX_JOINTS; joint++)
     {
+        if (mask & (1u << joint))
+        {
+            joint_count++;
+        }
+    }
+    if (buffer->header.payload_length != sizeof(uint32_t) + joint_count * sizeof(JointData_t))
+    {
+        PacketPool_Release(buffer);
         g_transfer_state = DATA_TRANSFER_ERROR;
+        return false;
     }
     
-    return result;
+    // 按关节ID升序读取关节数据
+    for (uint32_t joint = 0; joint < DATA_TRANSFER_MAX_JOINTS; joint++)
+    {
+        if (mask & (1u << joint))
+        {
+            memcpy(&joint_data[joint], payload_ptr, sizeof(JointData_t));
+            payload_ptr += sizeof(JointData_t);
+        }
+    }
+    
+    *joint_mask = mask;
+    if (cycle_timestamp != NULL)
+    {
+        *cycle_timestamp = buffer->header.timestamp;
+    }
+    PacketPool_Release(buffer);
+    
+    g_transfer_state = DATA_TRANSFER_COMPLETED;
+    return true;
 }
 
-// 接收系统状态数据
-bool DataTransfer_ReceiveSystemState(SystemState_t* system_state)
+// 发送系统状态数据
+bool DataTransfer_SendSystemState(const SystemState_t* system_state, PriorityLevel priority)
 {
     if (system_state == NULL)
     {
@@ -177,26 +262,40 @@ bool DataTransfer_ReceiveSystemState(SystemState_t* system_state)
         return false;
     }
     
-    // 接收数据包
-    Packet_t packet;
-    g_transfer_state = DATA_TRANSFER_RECEIVING;
-    bool result = ProtocolStack_ReceivePacket(&packet);
+    // 申请数据包缓冲区
+    PacketBuffer_t* buffer = acquire_buffer(DATA_TYPE_NON_REAL_TIME, priority, 0x0003);
+    if (buffer == NULL)
+    {
+        return false;
+    }
     
-    if (!result)
+    // 打包系统状态数据
+    memcpy(PacketPool_Payload(buffer), system_state, sizeof(SystemState_t));
+    buffer->header.payload_length = sizeof(SystemState_t);
+    
+    // 编码（计算CRC32）并发送
+    return transmit_buffer(buffer);
+}
+
+// 接收系统状态数据
+bool DataTransfer_ReceiveSystemState(SystemState_t* system_state)
+{
+    if (system_state == NULL)
     {
         g_transfer_state = DATA_TRANSFER_ERROR;
         return false;
     }
     
-    // 检查数据包类型
-    if (packet.data_type != DATA_TYPE_NON_REAL_TIME)
+    // 接收数据包并检查类型和长度
+    const PacketBuffer_t* buffer = receive_buffer(DATA_TYPE_NON_REAL_TIME, sizeof(SystemState_t), sizeof(SystemState_t));
+    if (buffer == NULL)
     {
-        g_transfer_state = DATA_TRANSFER_ERROR;
         return false;
     }
     
     // 解包系统状态数据
-    memcpy(system_state, packet.payload, sizeof(SystemState_t));
+    memcpy(system_state, PacketPool_ConstPayload(buffer), sizeof(SystemState_t));
+    PacketPool_Release(buffer);
     
     g_transfer_state = DATA_TRANSFER_COMPLETED;
     return true;
@@ -211,41 +310,19 @@ bool DataTransfer_SendEventData(const EventData_t* event_data, PriorityLevel pri
         return false;
     }
     
-    // 创建数据包
-    Packet_t packet;
-    memset(&packet, 0, sizeof(Packet_t));
-    
-    // 设置数据包头部
-    packet.protocol_type = PROTOCOL_WIFI; // 默认使用WiFi协议
-    packet.data_type = DATA_TYPE_EVENT;
-    packet.priority = priority;
-    packet.packet_id = generate_packet_id();
-    packet.timestamp = 0; // 待实现：获取系统时间戳
-    packet.source_id = 0x0001; // 待实现：获取本地设备ID
-    packet.destination_id = 0x0004; // 待实现：获取目标设备ID
-    
-    // 打包事件数据
-    memcpy(packet.payload, event_data, sizeof(EventData_t));
-    packet.payload_length = sizeof(EventData_t);
-    
-    // 计算CRC32校验
-    packet.crc32 = 0; // 先清零CRC字段
-    packet.crc32 = crc32_calculate((const uint8_t*)&packet, sizeof(Packet_t) - sizeof(packet.crc32));
-    
-    // 发送数据包
-    g_transfer_state = DATA_TRANSFER_SENDING;
-    bool result = ProtocolStack_SendPacket(&packet);
-    
-    if (result)
-    {
-        g_transfer_state = DATA_TRANSFER_COMPLETED;
-    }
-    else
+    // 申请数据包缓冲区
+    PacketBuffer_t* buffer = acquire_buffer(DATA_TYPE_EVENT, priority, 0x0004);
+    if (buffer == NULL)
     {
-        g_transfer_state = DATA_TRANSFER_ERROR;
+        return false;
     }
     
-    return result;
+    // 打包事件数据
+    memcpy(PacketPool_Payload(buffer), event_data, sizeof(EventData_t));
+    buffer->header.payload_length = sizeof(EventData_t);
+    
+    // 编码（计算CRC32）并发送
+    return transmit_buffer(buffer);
 }
 
 // 接收事件数据
@@ -257,26 +334,16 @@ bool DataTransfer_ReceiveEventData(EventData_t* event_data)
         return false;
     }
     
-    // 接收数据包
-    Packet_t packet;
-    g_transfer_state = DATA_TRANSFER_RECEIVING;
-    bool result = ProtocolStack_ReceivePacket(&packet);
-    
-    if (!result)
+    // 接收数据包并检查类型和长度
+    const PacketBuffer_t* buffer = receive_buffer(DATA_TYPE_EVENT, sizeof(EventData_t), sizeof(EventData_t));
+    if (buffer == NULL)
     {
-        g_transfer_state = DATA_TRANSFER_ERROR;
-        return false;
-    }
-    
-    // 检查数据包类型
-    if (packet.data_type != DATA_TYPE_EVENT)
-    {
-        g_transfer_state = DATA_TRANSFER_ERROR;
         return false;
     }
     
     // 解包事件数据
-    memcpy(event_data, packet.payload, sizeof(EventData_t));
+    memcpy(event_data, PacketPool_ConstPayload(buffer), sizeof(EventData_t));
+    PacketPool_Release(buffer);
     
     g_transfer_state = DATA_TRANSFER_COMPLETED;
     return true;
@@ -291,21 +358,15 @@ bool DataTransfer_SendCustomData(uint16_t data_id, const uint8_t* data, uint16_t
         return false;
     }
     
-    // 创建数据包
-    Packet_t packet;
-    memset(&packet, 0, sizeof(Packet_t));
-    
-    // 设置数据包头部
-    packet.protocol_type = PROTOCOL_USB; // 默认使用USB协议
-    packet.data_type = DATA_TYPE_NON_REAL_TIME;
-    packet.priority = priority;
-    packet.packet_id = generate_packet_id();
-    packet.timestamp = 0; // 待实现：获取系统时间戳
-    packet.source_id = 0x0001; // 待实现：获取本地设备ID
-    packet.destination_id = 0x0005; // 待实现：获取目标设备ID
+    // 申请数据包缓冲区
+    PacketBuffer_t* buffer = acquire_buffer(DATA_TYPE_NON_REAL_TIME, priority, 0x0005);
+    if (buffer == NULL)
+    {
+        return false;
+    }
     
-    // 打包自定义数据
-    uint8_t* payload_ptr = packet.payload;
+    // 在缓冲区内直接打包自定义数据
+    uint8_t* payload_ptr = PacketPool_Payload(buffer);
     
     // 写入数据ID
     memcpy(payload_ptr, &data_id, sizeof(uint16_t));
@@ -316,26 +377,10 @@ bool DataTransfer_SendCustomData(uint16_t data_id, const uint8_t* data, uint16_t
     payload_ptr += data_length;
     
     // 设置有效载荷长度
-    packet.payload_length = payload_ptr - packet.payload;
-    
-    // 计算CRC32校验
-    packet.crc32 = 0; // 先清零CRC字段
-    packet.crc32 = crc32_calculate((const uint8_t*)&packet, sizeof(Packet_t) - sizeof(packet.crc32));
+    buffer->header.payload_length = payload_ptr - PacketPool_Payload(buffer);
     
-    // 发送数据包
-    g_transfer_state = DATA_TRANSFER_SENDING;
-    bool result = ProtocolStack_SendPacket(&packet);
-    
-    if (result)
-    {
-        g_transfer_state = DATA_TRANSFER_COMPLETED;
-    }
-    else
-    {
-        g_transfer_state = DATA_TRANSFER_ERROR;
-    }
-    
-    return result;
+    // 编码（计算CRC32）并发送
+    return transmit_buffer(buffer);
 }
 
 // 接收自定义数据
@@ -347,41 +392,32 @@ bool DataTransfer_ReceiveCustomData(uint16_t* data_id, uint8_t* data, uint16_t*
         return false;
     }
     
-    // 接收数据包
-    Packet_t packet;
-    g_transfer_state = DATA_TRANSFER_RECEIVING;
-    bool result = ProtocolStack_ReceivePacket(&packet);
-    
-    if (!result)
-    {
-        g_transfer_state = DATA_TRANSFER_ERROR;
-        return false;
-    }
-    
-    // 检查数据包类型
-    if (packet.data_type != DATA_TYPE_NON_REAL_TIME)
+    // 接收数据包并检查类型和长度
+    const PacketBuffer_t* buffer = receive_buffer(DATA_TYPE_NON_REAL_TIME, sizeof(uint16_t), MAX_PAYLOAD_SIZE);
+    if (buffer == NULL)
     {
-        g_transfer_state = DATA_TRANSFER_ERROR;
         return false;
     }
     
     // 解包自定义数据
-    const uint8_t* payload_ptr = packet.payload;
+    const uint8_t* payload_ptr = PacketPool_ConstPayload(buffer);
     
     // 读取数据ID
     memcpy(data_id, payload_ptr, sizeof(uint16_t));
     payload_ptr += sizeof(uint16_t);
     
     // 读取自定义数据
-    uint16_t actual_data_length = packet.payload_length - sizeof(uint16_t);
+    uint16_t actual_data_length = buffer->header.payload_length - sizeof(uint16_t);
     if (actual_data_length > *data_length)
     {
+        PacketPool_Release(buffer);
         g_transfer_state = DATA_TRANSFER_ERROR;
         return false;
     }
     
     memcpy(data, payload_ptr, actual_data_length);
     *data_length = actual_data_length;
+    PacketPool_Release(buffer);
     
     g_transfer_state = DATA_TRANSFER_COMPLETED;
     return true;
@@ -3,6 +3,9 @@
 
 #include "protocol_stack.h"
 
+// 一个关节帧最多包含的关节数，关节ID为0到DATA_TRANSFER_MAX_JOINTS-1，对应关节位图的各位
+#define DATA_TRANSFER_MAX_JOINTS 32
+
 // 数据传输状态枚举
 typedef enum {
     DATA_TRANSFER_IDLE = 0,
@@ -48,6 +51,17 @@ bool DataTransfer_SendJointData(uint16_t joint_id, const JointData_t* joint_data
 // 接收关节数据
 bool DataTransfer_ReceiveJointData(uint16_t* joint_id, JointData_t* joint_data);
 
+// 发送关节帧：一个控制周期内多个关节的数据打包为一个数据包，共用一个头部、一个CRC32和一个周期时间戳
+// 有效载荷为[关节位图4][按关节ID升序排列的JointData_t]，joint_mask第i位为1表示包含关节i
+// 数据类型为DATA_TYPE_JOINT_FRAME，与单关节数据分开识别，可以单独路由到其他链路
+// joint_data按关节ID索引，只读取joint_mask中置位的关节
+bool DataTransfer_SendJointFrame(uint32_t joint_mask, const JointData_t* joint_data, uint32_t cycle_timestamp,
+                                 PriorityLevel priority);
+
+// 接收关节帧：joint_data按关节ID索引，至少有DATA_TRANSFER_MAX_JOINTS项，只写入*joint_mask中置位的关节
+// cycle_timestamp可以为NULL
+bool DataTransfer_ReceiveJointFrame(uint32_t* joint_mask, JointData_t* joint_data, uint32_t* cycle_timestamp);
+
 // 发送系统状态数据
 bool DataTransfer_SendSystemState(const SystemState_t* system_state, PriorityLevel priority);
 
@@ -0,0 +1,123 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "data_transfer.h"
+#include "loopback_transport.h"
+#include "protocol_stack.h"
+
+// 关节帧基准测试：12关节外骨骼每个控制周期发送全部关节数据，
+// 对比逐关节发送（每个关节一个数据包）和关节帧（所有关节一个数据包）的每周期线上字节数和CPU时间
+// 经回环传输发送后接收，CPU时间包括发送端和接收端
+// 用法：joint_frame_benchmark [关节数] [周期数]
+
+// 统计经过传输层的帧数和字节数
+static uint64_t g_frames = 0;
+static uint64_t g_bytes = 0;
+
+static bool counting_send(const uint8_t* frame, uint16_t length)
+{
+    g_frames++;
+    g_bytes += length;
+    return LoopbackTransport_Send(frame, length);
+}
+
+static const Transport_t g_counting_transport = {
+    "counting loopback", LoopbackTransport_Open, counting_send, LoopbackTransport_Receive, LoopbackTransport_Close
+};
+
+// 获取进程CPU时间 (单位: ns)
+static uint64_t cpu_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// 逐关节发送一个周期，然后接收
+static bool per_joint_cycle(int joint_count, const JointData_t* joints, JointData_t* received)
+{
+    for (int j = 0; j < joint_count; j++)
+    {
+        if (!DataTransfer_SendJointData((uint16_t)j, &joints[j], PRIORITY_HIGH))
+        {
+            return false;
+        }
+    }
+
+    for (int j = 0; j < joint_count; j++)
+    {
+        uint16_t joint_id;
+        JointData_t joint;
+        if (!DataTransfer_ReceiveJointData(&joint_id, &joint) || joint_id >= DATA_TRANSFER_MAX_JOINTS)
+        {
+            return false;
+        }
+        received[joint_id] = joint;
+    }
+    return true;
+}
+
+// 用一个关节帧发送一个周期，然后接收
+static bool joint_frame_cycle(int joint_count, const JointData_t* joints, JointData_t* received, uint32_t cycle)
+{
+    uint32_t joint_mask = (joint_count == 32) ? 0xFFFFFFFFu : ((1u << joint_count) - 1);
+    uint32_t received_mask;
+    uint32_t received_cycle;
+    return DataTransfer_SendJointFrame(joint_mask, joints, cycle, PRIORITY_HIGH) &&
+           DataTransfer_ReceiveJointFrame(&received_mask, received, &received_cycle) &&
+           received_mask == joint_mask && received_cycle == cycle;
+}
+
+static void run(const char* name, bool joint_frame, int joint_count, int cycles)
+{
+    JointData_t joints[DATA_TRANSFER_MAX_JOINTS];
+    JointData_t received[DATA_TRANSFER_MAX_JOINTS];
+    g_frames = 0;
+    g_bytes = 0;
+
+    int ok = 0;
+    uint64_t start = cpu_time_ns();
+    for (int c = 0; c < cycles; c++)
+    {
+        for (int j = 0; j < joint_count; j++)
+        {
+            joints[j] = (JointData_t){ (float)c, (float)j, 0.5f, 0.0f };
+        }
+
+        bool result = joint_frame ? joint_frame_cycle(joint_count, joints, received, (uint32_t)c)
+                                  : per_joint_cycle(joint_count, joints, received);
+        if (result && received[joint_count - 1].position == (float)c)
+        {
+            ok++;
+        }
+    }
+    uint64_t elapsed = cpu_time_ns() - start;
+
+    printf("%-12s %8d/%-8d %12.1f %14.1f %14.1f\n", name, ok, cycles,
+           (double)g_frames / cycles, (double)g_bytes / cycles, (double)elapsed / cycles);
+}
+
+int main(int argc, char* argv[])
+{
+    int joint_count = (argc > 1) ? atoi(argv[1]) : 12;
+    int cycles = (argc > 2) ? atoi(argv[2]) : 100000;
+    if (joint_count <= 0 || joint_count > DATA_TRANSFER_MAX_JOINTS || cycles <= 0)
+    {
+        printf("Usage: %s [joints 1-%d] [cycles]\n", argv[0], DATA_TRANSFER_MAX_JOINTS);
+        return 1;
+    }
+
+    if (!ProtocolStack_RegisterTransport(PROTOCOL_LOOPBACK, &g_counting_transport) ||
+        !ProtocolStack_Init(PROTOCOL_LOOPBACK) || !DataTransfer_Init())
+    {
+        return 1;
+    }
+
+    printf("%d joints per cycle over loopback, send + receive\n", joint_count);
+    printf("%-12s %17s %12s %14s %14s\n", "path", "cycles ok", "frames/cyc", "wire B/cyc", "CPU ns/cyc");
+    run("per-joint", false, joint_count, cycles);
+    run("joint-frame", true, joint_count, cycles);
+    ProtocolStack_Close();
+    return 0;
+}
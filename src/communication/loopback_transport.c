@@ -0,0 +1,126 @@
+#include "loopback_transport.h"
+#include "packet_codec.h"
+#include <stdatomic.h>
+#include <string.h>
+
+#if (LOOPBACK_QUEUE_CAPACITY & (LOOPBACK_QUEUE_CAPACITY - 1)) != 0
+#error "LOOPBACK_QUEUE_CAPACITY must be a power of two"
+#endif
+
+#define LOOPBACK_QUEUE_MASK (LOOPBACK_QUEUE_CAPACITY - 1)
+
+// 队列槽：sequence等于位置时可写，等于位置+1时可读
+typedef struct {
+    _Atomic uint32_t sequence;
+    uint16_t length;
+    uint8_t frame[PACKET_WIRE_MAX_SIZE];
+} LoopbackSlot_t;
+
+// 全局变量定义
+static _Alignas(64) _Atomic uint32_t g_tail;
+static _Alignas(64) _Atomic uint32_t g_head;
+static LoopbackSlot_t g_slots[LOOPBACK_QUEUE_CAPACITY];
+
+// 打开回环传输
+bool LoopbackTransport_Open(void)
+{
+    for (uint32_t i = 0; i < LOOPBACK_QUEUE_CAPACITY; i++)
+    {
+        atomic_store_explicit(&g_slots[i].sequence, i, memory_order_relaxed);
+    }
+    atomic_store_explicit(&g_head, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_tail, 0, memory_order_release);
+    return true;
+}
+
+// 发送一帧
+bool LoopbackTransport_Send(const uint8_t* frame, uint16_t length)
+{
+    if (frame == NULL || length > PACKET_WIRE_MAX_SIZE)
+    {
+        return false;
+    }
+
+    uint32_t position = atomic_load_explicit(&g_tail, memory_order_relaxed);
+    LoopbackSlot_t* slot;
+    for (;;)
+    {
+        slot = &g_slots[position & LOOPBACK_QUEUE_MASK];
+        uint32_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        int32_t diff = (int32_t)(sequence - position);
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&g_tail, &position, position + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // 队列满
+            return false;
+        }
+        else
+        {
+            position = atomic_load_explicit(&g_tail, memory_order_relaxed);
+        }
+    }
+
+    memcpy(slot->frame, frame, length);
+    slot->length = length;
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+    return true;
+}
+
+// 接收一帧
+bool LoopbackTransport_Receive(uint8_t* buffer, uint16_t buffer_size, uint16_t* length)
+{
+    if (buffer == NULL || length == NULL)
+    {
+        return false;
+    }
+
+    uint32_t position = atomic_load_explicit(&g_head, memory_order_relaxed);
+    LoopbackSlot_t* slot;
+    for (;;)
+    {
+        slot = &g_slots[position & LOOPBACK_QUEUE_MASK];
+        uint32_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        int32_t diff = (int32_t)(sequence - (position + 1));
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&g_head, &position, position + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // 队列为空
+            return false;
+        }
+        else
+        {
+            position = atomic_load_explicit(&g_head, memory_order_relaxed);
+        }
+    }
+
+    bool fits = (slot->length <= buffer_size);
+    if (fits)
+    {
+        memcpy(buffer, slot->frame, slot->length);
+        *length = slot->length;
+    }
+
+    // 槽位留给下一圈的发送端
+    atomic_store_explicit(&slot->sequence, position + LOOPBACK_QUEUE_CAPACITY, memory_order_release);
+    return fits;
+}
+
+// 关闭回环传输
+void LoopbackTransport_Close(void)
+{
+    LoopbackTransport_Open();
+}
@@ -0,0 +1,26 @@
+#ifndef LOOPBACK_TRANSPORT_H
+#define LOOPBACK_TRANSPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 进程内回环传输：发送的帧进入一个有界无锁队列，由接收端按顺序取出
+// 用于在没有硬件的环境中端到端测试和基准测试数据通路
+
+// 队列中最多缓存的帧数（2的幂）
+#define LOOPBACK_QUEUE_CAPACITY 64
+
+// 打开回环传输，清空队列；必须在没有其他线程收发时调用
+bool LoopbackTransport_Open(void);
+
+// 发送一帧，队列满时返回false；可在任意线程调用，无锁
+bool LoopbackTransport_Send(const uint8_t* frame, uint16_t length);
+
+// 接收一帧，length返回帧长度；队列为空时立即返回false
+// 帧长度超过buffer_size时丢弃该帧并返回false；可在任意线程调用，无锁
+bool LoopbackTransport_Receive(uint8_t* buffer, uint16_t buffer_size, uint16_t* length);
+
+// 关闭回环传输，丢弃未接收的帧
+void LoopbackTransport_Close(void);
+
+#endif // LOOPBACK_TRANSPORT_H
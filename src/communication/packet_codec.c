@@ -0,0 +1,163 @@
+#include "packet_codec.h"
+#include "crc32.h"
+#include <string.h>
+
+// 头部字段偏移
+#define WIRE_OFFSET_PROTOCOL_TYPE   0
+#define WIRE_OFFSET_DATA_TYPE       1
+#define WIRE_OFFSET_PRIORITY        2
+#define WIRE_OFFSET_PACKET_ID       3
+#define WIRE_OFFSET_TIMESTAMP       5
+#define WIRE_OFFSET_SOURCE_ID       9
+#define WIRE_OFFSET_DESTINATION_ID  11
+#define WIRE_OFFSET_PAYLOAD_LENGTH  13
+
+// 小端写入
+static void put_u16(uint8_t* buffer, uint16_t value)
+{
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(uint8_t* buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8);
+    buffer[2] = (uint8_t)(value >> 16);
+    buffer[3] = (uint8_t)(value >> 24);
+}
+
+// 小端读取
+static uint16_t get_u16(const uint8_t* buffer)
+{
+    return (uint16_t)(buffer[0] | (buffer[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* buffer)
+{
+    return (uint32_t)buffer[0] | ((uint32_t)buffer[1] << 8) |
+           ((uint32_t)buffer[2] << 16) | ((uint32_t)buffer[3] << 24);
+}
+
+// 数据包编码后的帧长度
+uint16_t PacketCodec_EncodedSize(const Packet_t* packet)
+{
+    if (packet == NULL || packet->payload_length > MAX_PAYLOAD_SIZE)
+    {
+        return 0;
+    }
+    return (uint16_t)(PACKET_WIRE_HEADER_SIZE + packet->payload_length + PACKET_WIRE_CRC_SIZE);
+}
+
+// 就地编码
+uint16_t PacketCodec_EncodeHeader(const PacketHeader_t* header, uint8_t* buffer, uint16_t buffer_size)
+{
+    if (header == NULL || buffer == NULL || header->payload_length > MAX_PAYLOAD_SIZE)
+    {
+        return 0;
+    }
+
+    uint16_t frame_length = (uint16_t)(PACKET_WIRE_HEADER_SIZE + header->payload_length + PACKET_WIRE_CRC_SIZE);
+    if (buffer_size < frame_length)
+    {
+        return 0;
+    }
+
+    // 写入头部
+    buffer[WIRE_OFFSET_PROTOCOL_TYPE] = header->protocol_type;
+    buffer[WIRE_OFFSET_DATA_TYPE] = header->data_type;
+    buffer[WIRE_OFFSET_PRIORITY] = header->priority;
+    put_u16(buffer + WIRE_OFFSET_PACKET_ID, header->packet_id);
+    put_u32(buffer + WIRE_OFFSET_TIMESTAMP, header->timestamp);
+    put_u16(buffer + WIRE_OFFSET_SOURCE_ID, header->source_id);
+    put_u16(buffer + WIRE_OFFSET_DESTINATION_ID, header->destination_id);
+    put_u16(buffer + WIRE_OFFSET_PAYLOAD_LENGTH, header->payload_length);
+
+    // CRC32只覆盖实际写入的字节
+    uint16_t crc_offset = (uint16_t)(PACKET_WIRE_HEADER_SIZE + header->payload_length);
+    put_u32(buffer + crc_offset, crc32_calculate(buffer, crc_offset));
+
+    return frame_length;
+}
+
+// 就地解码
+bool PacketCodec_DecodeHeader(const uint8_t* buffer, uint16_t length, PacketHeader_t* header)
+{
+    if (buffer == NULL || header == NULL || length < PACKET_WIRE_HEADER_SIZE + PACKET_WIRE_CRC_SIZE)
+    {
+        return false;
+    }
+
+    // 检查长度一致性
+    uint16_t payload_length = get_u16(buffer + WIRE_OFFSET_PAYLOAD_LENGTH);
+    if (payload_length > MAX_PAYLOAD_SIZE ||
+        length != PACKET_WIRE_HEADER_SIZE + payload_length + PACKET_WIRE_CRC_SIZE)
+    {
+        return false;
+    }
+
+    // 验证CRC32
+    uint16_t crc_offset = (uint16_t)(PACKET_WIRE_HEADER_SIZE + payload_length);
+    if (crc32_calculate(buffer, crc_offset) != get_u32(buffer + crc_offset))
+    {
+        return false;
+    }
+
+    // 读取头部
+    header->protocol_type = buffer[WIRE_OFFSET_PROTOCOL_TYPE];
+    header->data_type = buffer[WIRE_OFFSET_DATA_TYPE];
+    header->priority = buffer[WIRE_OFFSET_PRIORITY];
+    header->packet_id = get_u16(buffer + WIRE_OFFSET_PACKET_ID);
+    header->timestamp = get_u32(buffer + WIRE_OFFSET_TIMESTAMP);
+    header->source_id = get_u16(buffer + WIRE_OFFSET_SOURCE_ID);
+    header->destination_id = get_u16(buffer + WIRE_OFFSET_DESTINATION_ID);
+    header->payload_length = payload_length;
+
+    return true;
+}
+
+// 编码数据包
+uint16_t PacketCodec_Encode(const Packet_t* packet, uint8_t* buffer, uint16_t buffer_size)
+{
+    uint16_t frame_length = PacketCodec_EncodedSize(packet);
+    if (frame_length == 0 || buffer == NULL || buffer_size < frame_length)
+    {
+        return 0;
+    }
+
+    PacketHeader_t header;
+    header.protocol_type = packet->protocol_type;
+    header.data_type = packet->data_type;
+    header.priority = packet->priority;
+    header.packet_id = packet->packet_id;
+    header.timestamp = packet->timestamp;
+    header.source_id = packet->source_id;
+    header.destination_id = packet->destination_id;
+    header.payload_length = packet->payload_length;
+
+    memcpy(buffer + PACKET_WIRE_HEADER_SIZE, packet->payload, packet->payload_length);
+    return PacketCodec_EncodeHeader(&header, buffer, buffer_size);
+}
+
+// 解码帧
+bool PacketCodec_Decode(const uint8_t* buffer, uint16_t length, Packet_t* packet)
+{
+    PacketHeader_t header;
+    if (packet == NULL || !PacketCodec_DecodeHeader(buffer, length, &header))
+    {
+        return false;
+    }
+
+    packet->protocol_type = header.protocol_type;
+    packet->data_type = header.data_type;
+    packet->priority = header.priority;
+    packet->packet_id = header.packet_id;
+    packet->timestamp = header.timestamp;
+    packet->source_id = header.source_id;
+    packet->destination_id = header.destination_id;
+    packet->payload_length = header.payload_length;
+    memcpy(packet->payload, buffer + PACKET_WIRE_HEADER_SIZE, header.payload_length);
+    packet->crc32 = get_u32(buffer + PACKET_WIRE_HEADER_SIZE + header.payload_length);
+
+    return true;
+}
@@ -0,0 +1,43 @@
+#ifndef PACKET_CODEC_H
+#define PACKET_CODEC_H
+
+#include "protocol_stack.h"
+
+// 线上帧格式（小端，紧凑排列，无填充）：
+// [协议类型1][数据类型1][优先级1][数据包ID2][时间戳4][源ID2][目标ID2][有效载荷长度2][有效载荷N][CRC32 4]
+// CRC32覆盖头部和N字节有效载荷，一个关节数据包的帧长为15+18+4=37字节
+#define PACKET_WIRE_HEADER_SIZE 15
+#define PACKET_WIRE_CRC_SIZE 4
+#define PACKET_WIRE_MAX_SIZE (PACKET_WIRE_HEADER_SIZE + MAX_PAYLOAD_SIZE + PACKET_WIRE_CRC_SIZE)
+
+// 数据包头部字段（Packet_t中除有效载荷和CRC32外的部分）
+typedef struct {
+    uint8_t protocol_type;         // 协议类型
+    uint8_t data_type;             // 数据类型
+    uint8_t priority;              // 优先级
+    uint16_t packet_id;            // 数据包ID
+    uint32_t timestamp;            // 时间戳
+    uint16_t source_id;            // 源ID
+    uint16_t destination_id;       // 目标ID
+    uint16_t payload_length;       // 有效载荷长度
+} PacketHeader_t;
+
+// 就地编码：有效载荷已位于buffer + PACKET_WIRE_HEADER_SIZE，写入头部并追加CRC32
+// 返回帧长度，参数无效或缓冲区不足时返回0
+uint16_t PacketCodec_EncodeHeader(const PacketHeader_t* header, uint8_t* buffer, uint16_t buffer_size);
+
+// 就地解码：检查长度一致性和CRC32，只解析头部，有效载荷留在帧内
+bool PacketCodec_DecodeHeader(const uint8_t* buffer, uint16_t length, PacketHeader_t* header);
+
+// 数据包编码后的帧长度，有效载荷超长时返回0
+uint16_t PacketCodec_EncodedSize(const Packet_t* packet);
+
+// 编码数据包：只序列化头部和payload_length字节有效载荷并追加CRC32
+// 返回帧长度，参数无效或缓冲区不足时返回0
+uint16_t PacketCodec_Encode(const Packet_t* packet, uint8_t* buffer, uint16_t buffer_size);
+
+// 解码帧：检查长度一致性和CRC32，只写入头部字段和payload_length字节有效载荷
+// packet->crc32为帧中的CRC32
+bool PacketCodec_Decode(const uint8_t* buffer, uint16_t length, Packet_t* packet);
+
+#endif // PACKET_CODEC_H
@@ -0,0 +1,157 @@
+#include "packet_pool.h"
+#include <stdatomic.h>
+#include <stddef.h>
+
+// 空闲链表结束标记
+#define POOL_INDEX_NONE 0xFFFF
+
+// 栈顶字：低32位为缓冲区索引，高32位为版本号
+#define POOL_HEAD_INDEX(head) ((uint16_t)((head) & 0xFFFFFFFFu))
+#define POOL_HEAD_MAKE(head, index) (((((head) >> 32) + 1) << 32) | (uint64_t)(index))
+
+// 缓冲区存储
+static PacketBuffer_t g_buffers[PACKET_POOL_CAPACITY];
+
+// 空闲链表（Treiber栈）：栈顶为64位字，每次修改递增32位版本号，防止ABA问题
+// 16位版本号在高频申请/释放下几毫秒即回绕，32位版本号需要约40亿次修改才会回绕
+static _Atomic uint64_t g_free_head;
+static _Atomic uint16_t g_next_free[PACKET_POOL_CAPACITY];
+static atomic_bool g_buffer_in_use[PACKET_POOL_CAPACITY];
+
+// 初始化标志，初始化之前申请缓冲区返回NULL
+static atomic_bool g_initialized;
+
+// 统计信息
+static atomic_uint g_in_use;
+static atomic_uint g_high_water;
+static atomic_uint g_acquire_count;
+static atomic_uint g_acquire_failures;
+static atomic_uint g_release_errors;
+
+// 缓冲区指针转换为索引，无效指针返回POOL_INDEX_NONE
+static uint16_t buffer_index(const PacketBuffer_t* buffer)
+{
+    if (buffer < g_buffers || buffer >= g_buffers + PACKET_POOL_CAPACITY)
+    {
+        return POOL_INDEX_NONE;
+    }
+    return (uint16_t)(buffer - g_buffers);
+}
+
+// 初始化缓冲池
+void PacketPool_Init(void)
+{
+    for (uint16_t i = 0; i < PACKET_POOL_CAPACITY; i++)
+    {
+        uint16_t next = (i + 1 < PACKET_POOL_CAPACITY) ? (uint16_t)(i + 1) : POOL_INDEX_NONE;
+        atomic_store_explicit(&g_next_free[i], next, memory_order_relaxed);
+        atomic_store_explicit(&g_buffer_in_use[i], false, memory_order_relaxed);
+        g_buffers[i].frame_length = 0;
+    }
+    
+    atomic_store_explicit(&g_in_use, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_high_water, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_acquire_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_acquire_failures, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_release_errors, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_free_head, 0, memory_order_release);
+    atomic_store_explicit(&g_initialized, true, memory_order_release);
+}
+
+// 申请缓冲区
+PacketBuffer_t* PacketPool_Acquire(void)
+{
+    if (!atomic_load_explicit(&g_initialized, memory_order_acquire))
+    {
+        return NULL;
+    }
+    
+    uint64_t head = atomic_load_explicit(&g_free_head, memory_order_acquire);
+    for (;;)
+    {
+        uint16_t index = POOL_HEAD_INDEX(head);
+        if (index == POOL_INDEX_NONE)
+        {
+            atomic_fetch_add_explicit(&g_acquire_failures, 1, memory_order_relaxed);
+            return NULL;
+        }
+        
+        uint16_t next = atomic_load_explicit(&g_next_free[index], memory_order_relaxed);
+        uint64_t new_head = POOL_HEAD_MAKE(head, next);
+        if (atomic_compare_exchange_weak_explicit(&g_free_head, &head, new_head,
+                                                  memory_order_acquire, memory_order_acquire))
+        {
+            atomic_store_explicit(&g_buffer_in_use[index], true, memory_order_relaxed);
+            
+            // 更新占用数和高水位
+            unsigned int in_use = atomic_fetch_add_explicit(&g_in_use, 1, memory_order_relaxed) + 1;
+            unsigned int high_water = atomic_load_explicit(&g_high_water, memory_order_relaxed);
+            while (in_use > high_water &&
+                   !atomic_compare_exchange_weak_explicit(&g_high_water, &high_water, in_use,
+                                                          memory_order_relaxed, memory_order_relaxed))
+            {
+            }
+            atomic_fetch_add_explicit(&g_acquire_count, 1, memory_order_relaxed);
+            
+            PacketBuffer_t* buffer = &g_buffers[index];
+            buffer->frame_length = 0;
+            return buffer;
+        }
+    }
+}
+
+// 释放缓冲区
+void PacketPool_Release(const PacketBuffer_t* buffer)
+{
+    uint16_t index = buffer_index(buffer);
+    if (!atomic_load_explicit(&g_initialized, memory_order_acquire) || index == POOL_INDEX_NONE ||
+        !atomic_exchange_explicit(&g_buffer_in_use[index], false, memory_order_relaxed))
+    {
+        // 不属于缓冲池或已经释放
+        atomic_fetch_add_explicit(&g_release_errors, 1, memory_order_relaxed);
+        return;
+    }
+    
+    atomic_fetch_sub_explicit(&g_in_use, 1, memory_order_relaxed);
+    
+    uint64_t head = atomic_load_explicit(&g_free_head, memory_order_relaxed);
+    for (;;)
+    {
+        atomic_store_explicit(&g_next_free[index], POOL_HEAD_INDEX(head), memory_order_relaxed);
+        uint64_t new_head = POOL_HEAD_MAKE(head, index);
+        if (atomic_compare_exchange_weak_explicit(&g_free_head, &head, new_head,
+                                                  memory_order_release, memory_order_relaxed))
+        {
+            return;
+        }
+    }
+}
+
+// 可写的有效载荷区域
+uint8_t* PacketPool_Payload(PacketBuffer_t* buffer)
+{
+    return (buffer != NULL) ? buffer->frame + PACKET_WIRE_HEADER_SIZE : NULL;
+}
+
+// 只读的有效载荷视图
+const uint8_t* PacketPool_ConstPayload(const PacketBuffer_t* buffer)
+{
+    return (buffer != NULL) ? buffer->frame + PACKET_WIRE_HEADER_SIZE : NULL;
+}
+
+// 获取缓冲池统计信息
+bool PacketPool_GetStats(PacketPoolStats_t* stats)
+{
+    if (stats == NULL)
+    {
+        return false;
+    }
+    
+    stats->capacity = PACKET_POOL_CAPACITY;
+    stats->in_use = (uint16_t)atomic_load_explicit(&g_in_use, memory_order_relaxed);
+    stats->high_water = (uint16_t)atomic_load_explicit(&g_high_water, memory_order_relaxed);
+    stats->acquire_count = atomic_load_explicit(&g_acquire_count, memory_order_relaxed);
+    stats->acquire_failures = atomic_load_explicit(&g_acquire_failures, memory_order_relaxed);
+    stats->release_errors = atomic_load_explicit(&g_release_errors, memory_order_relaxed);
+    return true;
+}
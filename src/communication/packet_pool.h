@@ -0,0 +1,45 @@
+#ifndef PACKET_POOL_H
+#define PACKET_POOL_H
+
+#include "packet_codec.h"
+
+// 数据包缓冲池容量
+#define PACKET_POOL_CAPACITY 64
+
+// 数据包缓冲区：帧直接在frame中组装和解析，有效载荷位于头部之后
+typedef struct PacketBuffer {
+    PacketHeader_t header;                 // 头部字段，发送时编码进帧，接收时从帧解析
+    uint16_t frame_length;                 // 帧长度 (单位: 字节)，未编码时为0
+    uint8_t frame[PACKET_WIRE_MAX_SIZE];   // 线上帧
+} PacketBuffer_t;
+
+// 缓冲池统计信息
+typedef struct {
+    uint16_t capacity;            // 缓冲区总数
+    uint16_t in_use;              // 当前占用数
+    uint16_t high_water;          // 占用数历史最大值
+    uint32_t acquire_count;       // 成功申请次数
+    uint32_t acquire_failures;    // 缓冲池耗尽导致的申请失败次数
+    uint32_t release_errors;      // 无效或重复释放次数
+} PacketPoolStats_t;
+
+// 初始化缓冲池：所有缓冲区在静态存储中预先分配，运行期间不再分配内存
+// 必须在没有缓冲区被占用时调用
+void PacketPool_Init(void);
+
+// 申请一个缓冲区，缓冲池耗尽或尚未初始化时返回NULL；可在任意线程调用，无锁
+PacketBuffer_t* PacketPool_Acquire(void);
+
+// 释放缓冲区；可在任意线程调用，无锁
+void PacketPool_Release(const PacketBuffer_t* buffer);
+
+// 可写的有效载荷区域，最多MAX_PAYLOAD_SIZE字节
+uint8_t* PacketPool_Payload(PacketBuffer_t* buffer);
+
+// 只读的有效载荷视图
+const uint8_t* PacketPool_ConstPayload(const PacketBuffer_t* buffer);
+
+// 获取缓冲池统计信息
+bool PacketPool_GetStats(PacketPoolStats_t* stats);
+
+#endif // PACKET_POOL_H
@@ -0,0 +1,305 @@
+#include "process_image.h"
+#include "crc32.h"
+#include "packet_pool.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+// 过程数据数据包的目标ID：广播给总线上的所有节点
+#define PROCESS_IMAGE_BROADCAST_ID 0xFFFF
+
+// 一个过程映像：buffers[front]为已发布缓冲区，另一个为工作缓冲区
+typedef struct {
+    uint16_t node_id;
+    ProcessImageDirection direction;
+    uint16_t image_size;
+    uint16_t packed_size;          // 各条目字节数之和
+    uint8_t entry_count;
+    uint32_t mapping_id;
+    uint32_t last_update;          // 最近一次更新时的周期计数
+    bool updated;                  // 是否收到过数据包
+    _Atomic uint8_t front;
+    PdoEntry_t entries[PROCESS_IMAGE_MAX_ENTRIES];
+    _Alignas(16) uint8_t buffers[2][PROCESS_IMAGE_MAX_SIZE];
+} ProcessImage_t;
+
+// 全局变量定义
+static ProcessImage_t g_images[PROCESS_IMAGE_MAX_IMAGES];
+static int g_image_count = 0;
+static uint32_t g_cycle = 0;
+static ProcessImageStats_t g_stats;
+
+// 映射ID：映像大小和各条目的CRC32
+static uint32_t mapping_id(const PdoMapping_t* mapping)
+{
+    uint8_t description[sizeof(uint16_t) + PROCESS_IMAGE_MAX_ENTRIES * sizeof(PdoEntry_t)];
+    memcpy(description, &mapping->image_size, sizeof(uint16_t));
+    memcpy(description + sizeof(uint16_t), mapping->entries, mapping->entry_count * sizeof(PdoEntry_t));
+    return crc32_calculate(description, sizeof(uint16_t) + mapping->entry_count * sizeof(PdoEntry_t));
+}
+
+static ProcessImage_t* get_image(int handle)
+{
+    return (handle >= 0 && handle < g_image_count) ? &g_images[handle] : NULL;
+}
+
+static ProcessImage_t* find_input(uint16_t node_id)
+{
+    for (int i = 0; i < g_image_count; i++)
+    {
+        if (g_images[i].direction == PROCESS_IMAGE_INPUT && g_images[i].node_id == node_id)
+        {
+            return &g_images[i];
+        }
+    }
+    return NULL;
+}
+
+// 过程数据是否独占其链路：Exchange会取走链路上的所有帧，与其他数据类型共用时会丢弃它们
+static bool link_is_dedicated(ProtocolType link)
+{
+    for (int data_type = 0; data_type < DATA_TYPE_MAX; data_type++)
+    {
+        if (data_type != DATA_TYPE_PROCESS_DATA && ProtocolStack_GetRoute((DataType)data_type) == link)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 发布输出映像的工作缓冲区并打包发送，新的工作缓冲区从发布的值开始
+static bool send_output(ProcessImage_t* image, uint32_t cycle_timestamp)
+{
+    uint8_t published = 1 - atomic_load_explicit(&image->front, memory_order_relaxed);
+    atomic_store_explicit(&image->front, published, memory_order_release);
+    const uint8_t* source = image->buffers[published];
+    memcpy(image->buffers[1 - published], source, image->image_size);
+
+    PacketBuffer_t* buffer = PacketPool_Acquire();
+    if (buffer == NULL)
+    {
+        return false;
+    }
+
+    PacketHeader_t* header = &buffer->header;
+    header->protocol_type = ProtocolStack_GetRoute(DATA_TYPE_PROCESS_DATA);
+    header->data_type = DATA_TYPE_PROCESS_DATA;
+    header->priority = PRIORITY_HIGH;
+    header->packet_id = (uint16_t)g_cycle;
+    header->timestamp = cycle_timestamp;
+    header->source_id = image->node_id;
+    header->destination_id = PROCESS_IMAGE_BROADCAST_ID;
+    header->payload_length = PROCESS_IMAGE_HEADER_SIZE + image->packed_size;
+
+    // 按映射顺序收集各条目
+    uint8_t* payload_ptr = PacketPool_Payload(buffer);
+    memcpy(payload_ptr, &image->mapping_id, sizeof(uint32_t));
+    memcpy(payload_ptr + sizeof(uint32_t), &g_cycle, sizeof(uint32_t));
+    payload_ptr += PROCESS_IMAGE_HEADER_SIZE;
+    for (int e = 0; e < image->entry_count; e++)
+    {
+        memcpy(payload_ptr, source + image->entries[e].offset, image->entries[e].size);
+        payload_ptr += image->entries[e].size;
+    }
+
+    return ProtocolStack_SendBuffer(buffer);
+}
+
+// 解包一个过程数据数据包到对应输入映像的工作缓冲区，然后发布
+static bool receive_input(const PacketBuffer_t* buffer)
+{
+    ProcessImage_t* image = find_input(buffer->header.source_id);
+    const uint8_t* payload_ptr = PacketPool_ConstPayload(buffer);
+    uint32_t received_mapping_id;
+    memcpy(&received_mapping_id, payload_ptr, sizeof(uint32_t));
+    if (image == NULL || received_mapping_id != image->mapping_id ||
+        buffer->header.payload_length != PROCESS_IMAGE_HEADER_SIZE + image->packed_size)
+    {
+        return false;
+    }
+
+    // 按映射顺序分发各条目
+    uint8_t working = 1 - atomic_load_explicit(&image->front, memory_order_relaxed);
+    uint8_t* destination = image->buffers[working];
+    payload_ptr += PROCESS_IMAGE_HEADER_SIZE;
+    for (int e = 0; e < image->entry_count; e++)
+    {
+        memcpy(destination + image->entries[e].offset, payload_ptr, image->entries[e].size);
+        payload_ptr += image->entries[e].size;
+    }
+
+    atomic_store_explicit(&image->front, working, memory_order_release);
+    image->last_update = g_cycle;
+    image->updated = true;
+    return true;
+}
+
+// 初始化
+void ProcessImage_Init(void)
+{
+    memset(g_images, 0, sizeof(g_images));
+    g_image_count = 0;
+    g_cycle = 0;
+    memset(&g_stats, 0, sizeof(g_stats));
+    Crc32_Init();
+}
+
+// 注册映像
+int ProcessImage_Register(const PdoMapping_t* mapping)
+{
+    if (mapping == NULL || (unsigned)mapping->direction >= PROCESS_IMAGE_DIRECTION_MAX ||
+        mapping->image_size == 0 || mapping->image_size > PROCESS_IMAGE_MAX_SIZE ||
+        mapping->entry_count == 0 || mapping->entry_count > PROCESS_IMAGE_MAX_ENTRIES || mapping->entries == NULL)
+    {
+        printf("Cannot register process image: Invalid mapping\n");
+        return -1;
+    }
+
+    uint32_t packed_size = 0;
+    for (int e = 0; e < mapping->entry_count; e++)
+    {
+        const PdoEntry_t* entry = &mapping->entries[e];
+        if (entry->size == 0 || (uint32_t)entry->offset + entry->size > mapping->image_size)
+        {
+            printf("Cannot register process image: Entry %d outside the image\n", e);
+            return -1;
+        }
+        packed_size += entry->size;
+    }
+    if (PROCESS_IMAGE_HEADER_SIZE + packed_size > MAX_PAYLOAD_SIZE)
+    {
+        printf("Cannot register process image: Mapped data too large (%u bytes)\n", (unsigned)packed_size);
+        return -1;
+    }
+
+    for (int i = 0; i < g_image_count; i++)
+    {
+        if (g_images[i].node_id == mapping->node_id && g_images[i].direction == mapping->direction)
+        {
+            printf("Cannot register process image: Node %u already registered\n", mapping->node_id);
+            return -1;
+        }
+    }
+
+    if (g_image_count >= PROCESS_IMAGE_MAX_IMAGES)
+    {
+        printf("Cannot register process image: Too many images\n");
+        return -1;
+    }
+
+    ProcessImage_t* image = &g_images[g_image_count];
+    memset(image, 0, sizeof(*image));
+    image->node_id = mapping->node_id;
+    image->direction = mapping->direction;
+    image->image_size = mapping->image_size;
+    image->packed_size = (uint16_t)packed_size;
+    image->entry_count = mapping->entry_count;
+    image->mapping_id = mapping_id(mapping);
+    memcpy(image->entries, mapping->entries, mapping->entry_count * sizeof(PdoEntry_t));
+    return g_image_count++;
+}
+
+// 输出映像的工作缓冲区
+void* ProcessImage_Write(int handle)
+{
+    ProcessImage_t* image = get_image(handle);
+    if (image == NULL || image->direction != PROCESS_IMAGE_OUTPUT)
+    {
+        return NULL;
+    }
+    return image->buffers[1 - atomic_load_explicit(&image->front, memory_order_relaxed)];
+}
+
+// 映像的已发布缓冲区
+const void* ProcessImage_Read(int handle)
+{
+    ProcessImage_t* image = get_image(handle);
+    if (image == NULL)
+    {
+        return NULL;
+    }
+    return image->buffers[atomic_load_explicit(&image->front, memory_order_acquire)];
+}
+
+// 输入映像距离上次更新经过的周期数
+uint32_t ProcessImage_GetAge(int handle)
+{
+    ProcessImage_t* image = get_image(handle);
+    if (image == NULL || image->direction != PROCESS_IMAGE_INPUT || !image->updated)
+    {
+        return UINT32_MAX;
+    }
+    return g_cycle - image->last_update;
+}
+
+// 执行一个交换周期
+bool ProcessImage_Exchange(uint32_t cycle_timestamp)
+{
+    ProtocolType link = ProtocolStack_GetRoute(DATA_TYPE_PROCESS_DATA);
+    if (!link_is_dedicated(link))
+    {
+        printf("Cannot exchange process images: Link %d is shared with other data types\n", link);
+        return false;
+    }
+
+    g_cycle++;
+    g_stats.cycles++;
+
+    // 每个输出映像一个数据包
+    bool result = true;
+    for (int i = 0; i < g_image_count; i++)
+    {
+        if (g_images[i].direction != PROCESS_IMAGE_OUTPUT)
+        {
+            continue;
+        }
+
+        if (send_output(&g_images[i], cycle_timestamp))
+        {
+            g_stats.sent++;
+        }
+        else
+        {
+            g_stats.send_errors++;
+            result = false;
+        }
+    }
+
+    // 取走过程数据链路上收到的所有帧，同一节点收到多帧时保留最新的
+    const PacketBuffer_t* buffer;
+    while ((buffer = ProtocolStack_ReceiveLinkBuffer(link)) != NULL)
+    {
+        if (buffer->header.data_type == DATA_TYPE_PROCESS_DATA && receive_input(buffer))
+        {
+            g_stats.received++;
+        }
+        else
+        {
+            g_stats.rejected++;
+        }
+        PacketPool_Release(buffer);
+    }
+
+    for (int i = 0; i < g_image_count; i++)
+    {
+        if (g_images[i].direction == PROCESS_IMAGE_INPUT && g_images[i].last_update != g_cycle)
+        {
+            g_stats.missed++;
+        }
+    }
+
+    return result;
+}
+
+// 获取交换统计
+bool ProcessImage_GetStats(ProcessImageStats_t* stats)
+{
+    if (stats == NULL)
+    {
+        return false;
+    }
+
+    *stats = g_stats;
+    return true;
+}
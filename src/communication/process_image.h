@@ -0,0 +1,84 @@
+#ifndef PROCESS_IMAGE_H
+#define PROCESS_IMAGE_H
+
+#include <stddef.h>
+#include "protocol_stack.h"
+
+// 过程映像（EtherCAT PDO方式的周期交换）：每个节点的输出和输入各是一块固定的双缓冲内存，
+// 控制代码直接读写普通结构体，不需要逐个信号调用API；
+// 每个周期调用一次ProcessImage_Exchange，每个输出映像按PDO映射打包为一个数据包发送，
+// 收到的数据包按映射解包到对应输入映像的后台缓冲区后原子切换
+// 过程数据使用DATA_TYPE_PROCESS_DATA，必须通过ProtocolStack_SetRoute路由到专用链路：
+// Exchange会取走该链路上的所有帧，其他数据类型也路由到该链路时拒绝交换
+
+// 最多注册的映像数、每个映像最多的PDO条目数和映像结构体的最大字节数
+#define PROCESS_IMAGE_MAX_IMAGES 16
+#define PROCESS_IMAGE_MAX_ENTRIES 64
+#define PROCESS_IMAGE_MAX_SIZE 512
+
+// 有效载荷格式：[映射ID4][周期计数4][按映射顺序排列的各条目数据]
+// 映射ID是映像大小和各条目的CRC32，收发双方的映射不一致时数据包被拒绝
+#define PROCESS_IMAGE_HEADER_SIZE 8
+
+// 声明映射条目：PDO_ENTRY(结构体类型, 成员)
+#define PDO_ENTRY(type, member) { (uint16_t)offsetof(type, member), (uint16_t)sizeof(((type*)0)->member) }
+
+// 映像方向
+typedef enum {
+    PROCESS_IMAGE_OUTPUT = 0,      // 本节点写入并发送
+    PROCESS_IMAGE_INPUT = 1,       // 从其他节点接收
+    PROCESS_IMAGE_DIRECTION_MAX
+} ProcessImageDirection;
+
+// PDO映射条目：信号在映像结构体中的位置
+typedef struct {
+    uint16_t offset;               // 字节偏移
+    uint16_t size;                 // 字节数
+} PdoEntry_t;
+
+// PDO映射
+typedef struct {
+    uint16_t node_id;              // 输出映像为本节点ID，输入映像为发送节点ID
+    ProcessImageDirection direction;
+    uint16_t image_size;           // 映像结构体大小，不超过PROCESS_IMAGE_MAX_SIZE
+    uint8_t entry_count;           // 条目数，不超过PROCESS_IMAGE_MAX_ENTRIES
+    const PdoEntry_t* entries;     // 按线上顺序排列的条目，注册时复制
+} PdoMapping_t;
+
+// 交换统计
+typedef struct {
+    uint32_t cycles;               // Exchange调用次数
+    uint32_t sent;                 // 发送的输出映像数据包数
+    uint32_t send_errors;          // 发送失败数
+    uint32_t received;             // 解包到输入映像的数据包数
+    uint32_t rejected;             // 未注册节点、映射ID或长度不一致而丢弃的数据包数
+    uint32_t missed;               // 输入映像在一个周期内没有收到数据包的次数
+} ProcessImageStats_t;
+
+// 初始化：注销所有映像并清零统计，不能与Exchange同时调用
+void ProcessImage_Init(void);
+
+// 注册映像，返回映像句柄，映射无效、节点和方向重复或映像数已满时返回-1
+// 两个缓冲区都清零
+int ProcessImage_Register(const PdoMapping_t* mapping);
+
+// 输出映像的工作缓冲区，控制代码在两次Exchange之间写入；输入映像或句柄无效时返回NULL
+// 只能在调用Exchange的线程中使用，保存上一周期的值
+void* ProcessImage_Write(int handle);
+
+// 映像的已发布缓冲区：输入映像为最近一次收到的数据，输出映像为最近一次发送的数据
+// 可在任意线程调用，指针在下一次Exchange之前保持一致；句柄无效时返回NULL
+const void* ProcessImage_Read(int handle);
+
+// 输入映像距离上次更新经过的周期数，0表示本周期已更新；从未收到或句柄无效时返回UINT32_MAX
+uint32_t ProcessImage_GetAge(int handle);
+
+// 执行一个交换周期：发布并发送所有输出映像，然后解包链路上收到的所有过程数据
+// cycle_timestamp写入数据包头部，通常为分布式时钟时间；所有输出映像都发送成功时返回true
+// 过程数据没有专用链路时不交换，返回false
+bool ProcessImage_Exchange(uint32_t cycle_timestamp);
+
+// 获取交换统计
+bool ProcessImage_GetStats(ProcessImageStats_t* stats);
+
+#endif // PROCESS_IMAGE_H
@@ -1,73 +1,125 @@
 #include "protocol_stack.h"
+#include "crc32.h"
+#include "loopback_transport.h"
+#include "packet_codec.h"
+#include "packet_pool.h"
+#include "trace.h"
+#include "tx_queue.h"
+#include "udp_transport.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+// 硬件协议的占位传输：打开和发送总是成功，不会收到帧
+// TODO: 实现EtherCAT、CANopen、WiFi、Bluetooth和USB驱动，通过ProtocolStack_RegisterTransport接入
+static bool placeholder_open(void)
+{
+    return true;
+}
+
+static bool placeholder_send(const uint8_t* frame, uint16_t length)
+{
+    (void)frame;
+    (void)length;
+    return true;
+}
+
+static bool placeholder_receive(uint8_t* buffer, uint16_t buffer_size, uint16_t* length)
+{
+    (void)buffer;
+    (void)buffer_size;
+    (void)length;
+    return false;
+}
+
+static void placeholder_close(void)
+{
+}
+
+// 内置传输，按ProtocolType排列
+static const Transport_t g_builtin_transports[PROTOCOL_MAX] = {
+    { "EtherCAT", placeholder_open, placeholder_send, placeholder_receive, placeholder_close },
+    { "CANopen", placeholder_open, placeholder_send, placeholder_receive, placeholder_close },
+    { "WiFi", placeholder_open, placeholder_send, placeholder_receive, placeholder_close },
+    { "Bluetooth", placeholder_open, placeholder_send, placeholder_receive, placeholder_close },
+    { "USB", placeholder_open, placeholder_send, placeholder_receive, placeholder_close },
+    { "loopback", LoopbackTransport_Open, LoopbackTransport_Send, LoopbackTransport_Receive, LoopbackTransport_Close },
+    { "UDP multicast", UdpTransport_Open, UdpTransport_Send, UdpTransport_Receive, UdpTransport_Close },
+};
+
 // 全局变量定义
-static ProtocolType g_protocol_type;
+static const Transport_t* g_transports[PROTOCOL_MAX];   // 注册的传输，NULL时使用内置传输
+static bool g_link_open[PROTOCOL_MAX];
+static ProtocolType g_default_link;
+static ProtocolType g_routes[DATA_TYPE_MAX];
 static CommunicationState g_comm_state = COMM_STATE_DISCONNECTED;
 
-// CRC32计算函数
-static uint32_t crc32_calculate(const uint8_t* data, uint32_t length)
+// 链路当前使用的传输
+static const Transport_t* get_transport(ProtocolType link)
 {
-    uint32_t crc = 0xFFFFFFFF;
-    for (uint32_t i = 0; i < length; i++)
+    return (g_transports[link] != NULL) ? g_transports[link] : &g_builtin_transports[link];
+}
+
+// 链路是否可以收发
+static bool link_ready(ProtocolType link)
+{
+    return g_comm_state == COMM_STATE_CONNECTED && (unsigned)link < PROTOCOL_MAX && g_link_open[link];
+}
+
+// 关闭链路，先在调用线程中发送该链路发送队列中剩余的数据包
+static void close_link(ProtocolType link)
+{
+    if (TxQueue_IsEnabled())
     {
-        crc ^= data[i];
-        for (uint32_t j = 0; j < 8; j++)
-        {
-            if (crc & 1)
-                crc = (crc >> 1) ^ 0xEDB88320;
-            else
-                crc = crc >> 1;
-        }
+        TxQueue_StopWorker(link);
+        TxQueue_Process(link, -1);
     }
-    return ~crc;
+    
+    printf("Closing %s protocol...\n", get_transport(link)->name);
+    get_transport(link)->close();
+    g_link_open[link] = false;
 }
 
 // 初始化协议栈
 bool ProtocolStack_Init(ProtocolType protocol_type)
 {
-    g_protocol_type = protocol_type;
+    // 关闭上一次初始化时打开且未关闭的链路
+    for (int link = 0; link < PROTOCOL_MAX; link++)
+    {
+        if (g_link_open[link])
+        {
+            get_transport((ProtocolType)link)->close();
+            g_link_open[link] = false;
+        }
+    }
+    
+    if ((unsigned)protocol_type >= PROTOCOL_MAX)
+    {
+        printf("Invalid protocol type: %d\n", protocol_type);
+        g_comm_state = COMM_STATE_ERROR;
+        return false;
+    }
     g_comm_state = COMM_STATE_CONNECTING;
     
-    // 根据协议类型进行不同的初始化
-    switch (protocol_type)
-    {
-        case PROTOCOL_ETHERCAT:
-            // EtherCAT初始化代码
-            printf("Initializing EtherCAT protocol...\n");
-            // TODO: 实现EtherCAT初始化
-            break;
-            
-        case PROTOCOL_CANOPEN:
-            // CANopen初始化代码
-            printf("Initializing CANopen protocol...\n");
-            // TODO: 实现CANopen初始化
-            break;
-            
-        case PROTOCOL_WIFI:
-            // WiFi初始化代码
-            printf("Initializing WiFi protocol...\n");
-            // TODO: 实现WiFi初始化
-            break;
-            
-        case PROTOCOL_BLUETOOTH:
-            // Bluetooth初始化代码
-            printf("Initializing Bluetooth protocol...\n");
-            // TODO: 实现Bluetooth初始化
-            break;
-            
-        case PROTOCOL_USB:
-            // USB初始化代码
-            printf("Initializing USB protocol...\n");
-            // TODO: 实现USB初始化
-            break;
-            
-        default:
-            printf("Invalid protocol type: %d\n", protocol_type);
-            g_comm_state = COMM_STATE_ERROR;
-            return false;
+    // 生成CRC查找表并选择硬件加速实现
+    Crc32_Init();
+    
+    // 预先分配数据包缓冲区
+    PacketPool_Init();
+    
+    // 记录跟踪时钟起点
+    Trace_Init();
+    
+    // 打开默认链路，所有数据类型都路由到默认链路
+    if (!ProtocolStack_OpenLink(protocol_type))
+    {
+        g_comm_state = COMM_STATE_ERROR;
+        return false;
+    }
+    g_default_link = protocol_type;
+    for (int data_type = 0; data_type < DATA_TYPE_MAX; data_type++)
+    {
+        g_routes[data_type] = protocol_type;
     }
     
     g_comm_state = COMM_STATE_CONNECTED;
@@ -75,15 +127,102 @@ bool ProtocolStack_Init(ProtocolType protocol_type)
     return true;
 }
 
-// 发送数据包
-bool ProtocolStack_SendPacket(const Packet_t* packet)
+// 注册传输
+bool ProtocolStack_RegisterTransport(ProtocolType protocol_type, const Transport_t* transport)
+{
+    if ((unsigned)protocol_type >= PROTOCOL_MAX || transport == NULL || transport->open == NULL ||
+        transport->send == NULL || transport->receive == NULL || transport->close == NULL)
+    {
+        printf("Cannot register transport: Invalid protocol type or transport\n");
+        return false;
+    }
+    
+    if (g_link_open[protocol_type])
+    {
+        printf("Cannot register transport: Link %d is open\n", protocol_type);
+        return false;
+    }
+    
+    g_transports[protocol_type] = transport;
+    return true;
+}
+
+// 打开链路
+bool ProtocolStack_OpenLink(ProtocolType link)
 {
-    if (g_comm_state != COMM_STATE_CONNECTED)
+    if ((unsigned)link >= PROTOCOL_MAX)
+    {
+        printf("Invalid protocol type: %d\n", link);
+        return false;
+    }
+    
+    if (g_link_open[link])
+    {
+        return true;
+    }
+    
+    const Transport_t* transport = get_transport(link);
+    printf("Initializing %s protocol...\n", transport->name);
+    if (!transport->open())
     {
-        printf("Cannot send packet: Communication not connected\n");
+        printf("Cannot open %s link\n", transport->name);
         return false;
     }
     
+    g_link_open[link] = true;
+    return true;
+}
+
+// 关闭链路
+bool ProtocolStack_CloseLink(ProtocolType link)
+{
+    if (!ProtocolStack_IsLinkOpen(link) || link == g_default_link)
+    {
+        printf("Cannot close link %d: Link not open or default link\n", link);
+        return false;
+    }
+    
+    // 路由到该链路的数据类型改回默认链路
+    for (int data_type = 0; data_type < DATA_TYPE_MAX; data_type++)
+    {
+        if (g_routes[data_type] == link)
+        {
+            g_routes[data_type] = g_default_link;
+        }
+    }
+    
+    close_link(link);
+    return true;
+}
+
+// 链路是否已打开
+bool ProtocolStack_IsLinkOpen(ProtocolType link)
+{
+    return (unsigned)link < PROTOCOL_MAX && g_link_open[link];
+}
+
+// 设置数据类型的路由
+bool ProtocolStack_SetRoute(DataType data_type, ProtocolType link)
+{
+    if ((unsigned)data_type >= DATA_TYPE_MAX || !ProtocolStack_IsLinkOpen(link))
+    {
+        printf("Cannot route data type %d to link %d: Invalid data type or link not open\n", data_type, link);
+        return false;
+    }
+    
+    g_routes[data_type] = link;
+    return true;
+}
+
+// 获取数据类型的路由
+ProtocolType ProtocolStack_GetRoute(DataType data_type)
+{
+    return ((unsigned)data_type < DATA_TYPE_MAX) ? g_routes[data_type] : g_default_link;
+}
+
+// 发送数据包
+bool ProtocolStack_SendPacket(const Packet_t* packet)
+{
     if (packet == NULL)
     {
         printf("Cannot send packet: Packet is NULL\n");
@@ -96,122 +235,194 @@ bool ProtocolStack_SendPacket(const Packet_t* packet)
         return false;
     }
     
-    // 计算CRC32校验
-    uint32_t calculated_crc = crc32_calculate((const uint8_t*)packet, sizeof(Packet_t) - sizeof(packet->crc32));
-    if (calculated_crc != packet->crc32)
+    PacketBuffer_t* buffer = PacketPool_Acquire();
+    if (buffer == NULL)
+    {
+        TRACE_WARN(TRACE_SEND_POOL_EXHAUSTED, 0, 0, 0);
+        return false;
+    }
+    
+    // 复制头部和有效载荷，CRC32在编码时计算
+    buffer->header.protocol_type = packet->protocol_type;
+    buffer->header.data_type = packet->data_type;
+    buffer->header.priority = packet->priority;
+    buffer->header.packet_id = packet->packet_id;
+    buffer->header.timestamp = packet->timestamp;
+    buffer->header.source_id = packet->source_id;
+    buffer->header.destination_id = packet->destination_id;
+    buffer->header.payload_length = packet->payload_length;
+    memcpy(PacketPool_Payload(buffer), packet->payload, packet->payload_length);
+    
+    return ProtocolStack_SendBuffer(buffer);
+}
+
+// 发送缓冲池中的数据包
+bool ProtocolStack_SendBuffer(PacketBuffer_t* buffer)
+{
+    if (buffer == NULL)
+    {
+        printf("Cannot send packet: Buffer is NULL\n");
+        return false;
+    }
+    
+    // 在缓冲区内就地写入头部和CRC32
+    buffer->frame_length = PacketCodec_EncodeHeader(&buffer->header, buffer->frame, sizeof(buffer->frame));
+    if (buffer->frame_length == 0)
+    {
+        TRACE_ERROR(TRACE_SEND_ENCODE_FAILED, buffer->header.payload_length, 0, 0);
+        PacketPool_Release(buffer);
+        return false;
+    }
+    
+    // 按数据类型选择链路；启用发送队列时按优先级排队，由该链路的发送队列发送和释放
+    ProtocolType link = ProtocolStack_GetRoute((DataType)buffer->header.data_type);
+    if (TxQueue_IsEnabled())
+    {
+        return TxQueue_Enqueue(link, buffer);
+    }
+    
+    bool result = ProtocolStack_SendLinkFrame(link, buffer->frame, buffer->frame_length);
+    PacketPool_Release(buffer);
+    return result;
+}
+
+// 在默认链路上发送已编码的帧
+bool ProtocolStack_SendFrame(const uint8_t* frame, uint16_t length)
+{
+    return ProtocolStack_SendLinkFrame(g_default_link, frame, length);
+}
+
+// 在指定链路上发送已编码的帧
+bool ProtocolStack_SendLinkFrame(ProtocolType link, const uint8_t* frame, uint16_t length)
+{
+    if (!link_ready(link))
+    {
+        TRACE_ERROR(TRACE_SEND_NOT_CONNECTED, link, g_comm_state, 0);
+        return false;
+    }
+    
+    if (frame == NULL)
+    {
+        printf("Cannot send packet: Frame is NULL\n");
+        return false;
+    }
+    
+    if (length < PACKET_WIRE_HEADER_SIZE + PACKET_WIRE_CRC_SIZE || length > PACKET_WIRE_MAX_SIZE)
+    {
+        TRACE_ERROR(TRACE_SEND_INVALID_LENGTH, length, 0, 0);
+        return false;
+    }
+    
+    // 通过链路的传输发送帧
+    TRACE_DEBUG(TRACE_FRAME_SENDING, link, length, 0);
+    if (!get_transport(link)->send(frame, length))
     {
-        printf("Cannot send packet: CRC mismatch\n");
+        TRACE_ERROR(TRACE_SEND_FAILED, link, length, 0);
         return false;
     }
     
-    // 根据协议类型发送数据包
-    switch (g_protocol_type)
-    {
-        case PROTOCOL_ETHERCAT:
-            // EtherCAT发送代码
-            printf("Sending packet via EtherCAT...\n");
-            // TODO: 实现EtherCAT发送
-            break;
-            
-        case PROTOCOL_CANOPEN:
-            // CANopen发送代码
-            printf("Sending packet via CANopen...\n");
-            // TODO: 实现CANopen发送
-            break;
-            
-        case PROTOCOL_WIFI:
-            // WiFi发送代码
-            printf("Sending packet via WiFi...\n");
-            // TODO: 实现WiFi发送
-            break;
-            
-        case PROTOCOL_BLUETOOTH:
-            // Bluetooth发送代码
-            printf("Sending packet via Bluetooth...\n");
-            // TODO: 实现Bluetooth发送
-            break;
-            
-        case PROTOCOL_USB:
-            // USB发送代码
-            printf("Sending packet via USB...\n");
-            // TODO: 实现USB发送
-            break;
-            
-        default:
-            printf("Invalid protocol type: %d\n", g_protocol_type);
-            return false;
-    }
-    
-    printf("Packet sent successfully. Packet ID: %d\n", packet->packet_id);
+    TRACE_INFO(TRACE_FRAME_SENT, link, length, 0);
     return true;
 }
 
 // 接收数据包
 bool ProtocolStack_ReceivePacket(Packet_t* packet)
 {
-    if (g_comm_state != COMM_STATE_CONNECTED)
+    if (packet == NULL)
     {
-        printf("Cannot receive packet: Communication not connected\n");
+        printf("Cannot receive packet: Packet buffer is NULL\n");
         return false;
     }
     
-    if (packet == NULL)
+    const PacketBuffer_t* buffer = ProtocolStack_ReceiveBuffer();
+    if (buffer == NULL)
+    {
+        return false;
+    }
+    
+    // 复制头部和有效载荷
+    packet->protocol_type = buffer->header.protocol_type;
+    packet->data_type = buffer->header.data_type;
+    packet->priority = buffer->header.priority;
+    packet->packet_id = buffer->header.packet_id;
+    packet->timestamp = buffer->header.timestamp;
+    packet->source_id = buffer->header.source_id;
+    packet->destination_id = buffer->header.destination_id;
+    packet->payload_length = buffer->header.payload_length;
+    memcpy(packet->payload, PacketPool_ConstPayload(buffer), buffer->header.payload_length);
+    memcpy(&packet->crc32, buffer->frame + PACKET_WIRE_HEADER_SIZE + buffer->header.payload_length, sizeof(packet->crc32));
+    PacketPool_Release(buffer);
+    
+    return true;
+}
+
+// 从默认链路接收数据包到缓冲池
+const PacketBuffer_t* ProtocolStack_ReceiveBuffer(void)
+{
+    return ProtocolStack_ReceiveLinkBuffer(g_default_link);
+}
+
+// 从指定链路接收数据包到缓冲池
+const PacketBuffer_t* ProtocolStack_ReceiveLinkBuffer(ProtocolType link)
+{
+    PacketBuffer_t* buffer = PacketPool_Acquire();
+    if (buffer == NULL)
+    {
+        TRACE_WARN(TRACE_RECEIVE_POOL_EXHAUSTED, 0, 0, 0);
+        return NULL;
+    }
+    
+    uint16_t frame_length = 0;
+    if (!ProtocolStack_ReceiveLinkFrame(link, buffer->frame, sizeof(buffer->frame), &frame_length))
+    {
+        PacketPool_Release(buffer);
+        return NULL;
+    }
+    
+    // 就地解析头部并验证CRC32
+    if (!PacketCodec_DecodeHeader(buffer->frame, frame_length, &buffer->header))
+    {
+        TRACE_ERROR(TRACE_RECEIVE_CRC_MISMATCH, frame_length, 0, 0);
+        PacketPool_Release(buffer);
+        return NULL;
+    }
+    buffer->frame_length = frame_length;
+    
+    TRACE_INFO(TRACE_PACKET_RECEIVED, buffer->header.packet_id, buffer->header.source_id, buffer->header.destination_id);
+    return buffer;
+}
+
+// 从默认链路接收已编码的帧
+bool ProtocolStack_ReceiveFrame(uint8_t* buffer, uint16_t buffer_size, uint16_t* length)
+{
+    return ProtocolStack_ReceiveLinkFrame(g_default_link, buffer, buffer_size, length);
+}
+
+// 从指定链路接收已编码的帧
+bool ProtocolStack_ReceiveLinkFrame(ProtocolType link, uint8_t* buffer, uint16_t buffer_size, uint16_t* length)
+{
+    if (!link_ready(link))
+    {
+        TRACE_ERROR(TRACE_RECEIVE_NOT_CONNECTED, link, g_comm_state, 0);
+        return false;
+    }
+    
+    if (buffer == NULL || length == NULL)
     {
         printf("Cannot receive packet: Packet buffer is NULL\n");
         return false;
     }
     
-    // 清空接收缓冲区
-    memset(packet, 0, sizeof(Packet_t));
-    
-    // 根据协议类型接收数据包
-    switch (g_protocol_type)
-    {
-        case PROTOCOL_ETHERCAT:
-            // EtherCAT接收代码
-            printf("Receiving packet via EtherCAT...\n");
-            // TODO: 实现EtherCAT接收
-            break;
-            
-        case PROTOCOL_CANOPEN:
-            // CANopen接收代码
-            printf("Receiving packet via CANopen...\n");
-            // TODO: 实现CANopen接收
-            break;
-            
-        case PROTOCOL_WIFI:
-            // WiFi接收代码
-            printf("Receiving packet via WiFi...\n");
-            // TODO: 实现WiFi接收
-            break;
-            
-        case PROTOCOL_BLUETOOTH:
-            // Bluetooth接收代码
-            printf("Receiving packet via Bluetooth...\n");
-            // TODO: 实现Bluetooth接收
-            break;
-            
-        case PROTOCOL_USB:
-            // USB接收代码
-            printf("Receiving packet via USB...\n");
-            // TODO: 实现USB接收
-            break;
-            
-        default:
-            printf("Invalid protocol type: %d\n", g_protocol_type);
-            return false;
-    }
-    
-    // 验证CRC32校验
-    uint32_t calculated_crc = crc32_calculate((const uint8_t*)packet, sizeof(Packet_t) - sizeof(packet->crc32));
-    if (calculated_crc != packet->crc32)
-    {
-        printf("Received packet with CRC mismatch\n");
+    *length = 0;
+    
+    // 通过链路的传输接收帧
+    TRACE_DEBUG(TRACE_FRAME_RECEIVING, link, 0, 0);
+    if (!get_transport(link)->receive(buffer, buffer_size, length) || *length == 0)
+    {
+        // 没有收到帧
         return false;
     }
     
-    printf("Packet received successfully. Packet ID: %d, Source: %d, Destination: %d\n", 
-           packet->packet_id, packet->source_id, packet->destination_id);
     return true;
 }
 
@@ -220,41 +431,20 @@ void ProtocolStack_Close(void)
 {
     printf("Closing protocol stack...\n");
     
-    // 根据协议类型进行不同的关闭操作
-    switch (g_protocol_type)
-    {
-        case PROTOCOL_ETHERCAT:
-            // EtherCAT关闭代码
-            printf("Closing EtherCAT protocol...\n");
-            // TODO: 实现EtherCAT关闭
-            break;
-            
-        case PROTOCOL_CANOPEN:
-            // CANopen关闭代码
-            printf("Closing CANopen protocol...\n");
-            // TODO: 实现CANopen关闭
-            break;
-            
-        case PROTOCOL_WIFI:
-            // WiFi关闭代码
-            printf("Closing WiFi protocol...\n");
-            // TODO: 实现WiFi关闭
-            break;
-            
-        case PROTOCOL_BLUETOOTH:
-            // Bluetooth关闭代码
-            printf("Closing Bluetooth protocol...\n");
-            // TODO: 实现Bluetooth关闭
-            break;
-            
-        case PROTOCOL_USB:
-            // USB关闭代码
-            printf("Closing USB protocol...\n");
-            // TODO: 实现USB关闭
-            break;
-            
-        default:
-            break;
+    // 先停止所有链路的工作线程并发送发送队列中剩余的数据包
+    TxQueue_Shutdown();
+    
+    // 关闭所有打开的链路，默认链路最后关闭
+    for (int link = 0; link < PROTOCOL_MAX; link++)
+    {
+        if (g_link_open[link] && link != (int)g_default_link)
+        {
+            close_link((ProtocolType)link);
+        }
+    }
+    if (g_link_open[g_default_link])
+    {
+        close_link(g_default_link);
     }
     
     g_comm_state = COMM_STATE_DISCONNECTED;
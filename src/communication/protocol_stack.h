@@ -20,6 +20,8 @@ typedef enum {
     PROTOCOL_WIFI = 2,
     PROTOCOL_BLUETOOTH = 3,
     PROTOCOL_USB = 4,
+    PROTOCOL_LOOPBACK = 5,         // 进程内回环，见loopback_transport.h
+    PROTOCOL_UDP = 6,              // 本机UDP组播模拟的多节点总线，见udp_transport.h
     PROTOCOL_MAX
 } ProtocolType;
 
@@ -28,6 +30,8 @@ typedef enum {
     DATA_TYPE_REAL_TIME = 0,       // 实时数据：关节位置、速度、力/力矩等
     DATA_TYPE_NON_REAL_TIME = 1,   // 非实时数据：系统状态、参数配置等
     DATA_TYPE_EVENT = 2,           // 事件数据：故障信息、紧急停止等
+    DATA_TYPE_PROCESS_DATA = 3,    // 过程数据：周期交换的过程映像，见process_image.h
+    DATA_TYPE_JOINT_FRAME = 4,     // 关节帧：一个控制周期内多个关节的实时数据，见DataTransfer_SendJointFrame
     DATA_TYPE_MAX
 } DataType;
 
@@ -59,19 +63,74 @@ typedef struct {
     uint16_t destination_id;       // 目标ID
     uint16_t payload_length;       // 有效载荷长度
     uint8_t payload[MAX_PAYLOAD_SIZE]; // 有效载荷数据
-    uint32_t crc32;                // CRC32校验
+    uint32_t crc32;                // CRC32校验（线上帧头部和有效载荷的校验，由编解码器计算）
 } Packet_t;
 
-// 初始化协议栈
+// 传输接口：每种协议一个函数表，硬件驱动通过ProtocolStack_RegisterTransport接入
+// 每种协议同时最多打开一条链路，链路以协议类型标识
+typedef struct {
+    const char* name;                                                       // 协议名称
+    bool (*open)(void);                                                     // 打开链路
+    bool (*send)(const uint8_t* frame, uint16_t length);                    // 发送一帧
+    bool (*receive)(uint8_t* buffer, uint16_t buffer_size, uint16_t* length); // 接收一帧，没有帧时返回false
+    void (*close)(void);                                                    // 关闭链路
+} Transport_t;
+
+// 初始化协议栈：打开protocol_type链路作为默认链路，所有数据类型都路由到默认链路
 bool ProtocolStack_Init(ProtocolType protocol_type);
 
+// 注册或替换某个协议的传输实现，该协议的链路必须未打开
+bool ProtocolStack_RegisterTransport(ProtocolType protocol_type, const Transport_t* transport);
+
+// 在默认链路之外再打开一条链路；已打开时直接返回true
+bool ProtocolStack_OpenLink(ProtocolType link);
+
+// 关闭一条非默认链路，先发送其发送队列中剩余的数据包，路由到它的数据类型改回默认链路
+bool ProtocolStack_CloseLink(ProtocolType link);
+
+// 链路是否已打开
+bool ProtocolStack_IsLinkOpen(ProtocolType link);
+
+// 把一种数据类型路由到一条已打开的链路
+// 链路和路由应在开始收发前配置，收发期间修改不保证立即对其他线程可见
+bool ProtocolStack_SetRoute(DataType data_type, ProtocolType link);
+
+// 数据类型当前路由到的链路，未知数据类型返回默认链路
+ProtocolType ProtocolStack_GetRoute(DataType data_type);
+
 // 发送数据包
 bool ProtocolStack_SendPacket(const Packet_t* packet);
 
 // 接收数据包
 bool ProtocolStack_ReceivePacket(Packet_t* packet);
 
-// 关闭协议栈
+// 缓冲池中的数据包缓冲区，见packet_pool.h
+struct PacketBuffer;
+
+// 发送缓冲池中的数据包：按头部的数据类型选择链路，头部和CRC32在缓冲区内就地编码，有效载荷不复制
+// 无论成功与否，缓冲区所有权都交给协议栈，发送后自动释放
+// 启用发送队列（见tx_queue.h）时只编码并按优先级入队到链路的发送队列，返回值表示是否入队成功
+bool ProtocolStack_SendBuffer(struct PacketBuffer* buffer);
+
+// 从默认链路接收数据包到缓冲池，返回只读视图，用完后调用PacketPool_Release释放；没有数据包时返回NULL
+const struct PacketBuffer* ProtocolStack_ReceiveBuffer(void);
+
+// 从指定链路接收数据包到缓冲池
+const struct PacketBuffer* ProtocolStack_ReceiveLinkBuffer(ProtocolType link);
+
+// 在默认链路上发送已编码的帧（格式见packet_codec.h）
+bool ProtocolStack_SendFrame(const uint8_t* frame, uint16_t length);
+
+// 在指定链路上发送已编码的帧
+bool ProtocolStack_SendLinkFrame(ProtocolType link, const uint8_t* frame, uint16_t length);
+
+// 从默认链路接收已编码的帧，length返回帧长度；没有帧时返回false
+bool ProtocolStack_ReceiveFrame(uint8_t* buffer, uint16_t buffer_size, uint16_t* length);
+
+// 从指定链路接收已编码的帧
+bool ProtocolStack_ReceiveLinkFrame(ProtocolType link, uint8_t* buffer, uint16_t buffer_size, uint16_t* length);
+
+// 关闭协议栈：发送剩余数据包后关闭所有链路
 void ProtocolStack_Close(void);
 
 // 获取通信状态
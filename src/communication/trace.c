@@ -0,0 +1,296 @@
+#define _POSIX_C_SOURCE 200809L
+#include "trace.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define TRACE_HAVE_TSC
+#endif
+
+#if (TRACE_RING_CAPACITY & (TRACE_RING_CAPACITY - 1)) != 0
+#error "TRACE_RING_CAPACITY must be a power of two"
+#endif
+
+#define TRACE_RING_MASK (TRACE_RING_CAPACITY - 1)
+
+// 单个线程的环形缓冲区：只有所属线程写入，导出时其他线程只读
+// 线程退出后缓冲区连同记录保留，直到被新线程复用
+typedef struct {
+    _Alignas(64) _Atomic uint32_t write_index;   // 已写入的记录总数
+    _Atomic uint32_t start_index;                // 当前所属线程的第一条记录位置，之前的属于已退出的线程
+    char name[20];
+    TraceRecord_t records[TRACE_RING_CAPACITY];
+} TraceRing_t;
+
+// 全局变量定义
+static TraceRing_t g_rings[TRACE_MAX_THREADS];
+static atomic_uint g_ring_count;
+static atomic_uint g_lost_records;
+static _Thread_local TraceRing_t* t_ring = NULL;
+static pthread_once_t g_init_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_ring_key;                 // 线程退出时归还缓冲区
+static pthread_mutex_t g_free_lock = PTHREAD_MUTEX_INITIALIZER;
+static unsigned int g_free_rings[TRACE_MAX_THREADS];   // 已退出线程归还的缓冲区编号
+static unsigned int g_free_count = 0;
+static uint64_t g_start_ticks;
+static uint64_t g_start_ns;
+
+// 事件格式串
+#define TRACE_EVENT_FORMAT(id, format) format,
+static const char* const g_event_formats[TRACE_EVENT_MAX] = {
+    TRACE_EVENT_LIST(TRACE_EVENT_FORMAT)
+};
+#undef TRACE_EVENT_FORMAT
+
+// 获取单调时钟时间 (单位: ns)
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// 读取时钟计数：x86为TSC，aarch64为通用定时器，其他平台为单调时钟ns
+static inline uint64_t read_ticks(void)
+{
+#if defined(TRACE_HAVE_TSC)
+    return __rdtsc();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    uint64_t ticks;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return monotonic_ns();
+#endif
+}
+
+// 线程退出时归还环形缓冲区
+static void release_ring(void* arg)
+{
+    TraceRing_t* ring = (TraceRing_t*)arg;
+    t_ring = NULL;
+
+    pthread_mutex_lock(&g_free_lock);
+    g_free_rings[g_free_count++] = (unsigned int)(ring - g_rings);
+    pthread_mutex_unlock(&g_free_lock);
+}
+
+static void init_trace(void)
+{
+    g_start_ns = monotonic_ns();
+    g_start_ticks = read_ticks();
+    pthread_key_create(&g_ring_key, release_ring);
+}
+
+// 初始化
+void Trace_Init(void)
+{
+    pthread_once(&g_init_once, init_trace);
+}
+
+// 为当前线程分配环形缓冲区：先用从未使用过的，已退出线程的记录尽量保留到导出；
+// 都已占用时复用已退出线程归还的缓冲区
+static TraceRing_t* claim_ring(void)
+{
+    Trace_Init();
+
+    TraceRing_t* ring = NULL;
+    pthread_mutex_lock(&g_free_lock);
+    unsigned int count = atomic_load_explicit(&g_ring_count, memory_order_relaxed);
+    if (count < TRACE_MAX_THREADS)
+    {
+        ring = &g_rings[count];
+        atomic_store_explicit(&g_ring_count, count + 1, memory_order_release);
+    }
+    else if (g_free_count > 0)
+    {
+        ring = &g_rings[g_free_rings[--g_free_count]];
+        ring->name[0] = '\0';
+        atomic_store_explicit(&ring->start_index,
+                              atomic_load_explicit(&ring->write_index, memory_order_relaxed),
+                              memory_order_release);
+    }
+    pthread_mutex_unlock(&g_free_lock);
+
+    if (ring != NULL)
+    {
+        pthread_setspecific(g_ring_key, ring);
+    }
+    t_ring = ring;
+    return ring;
+}
+
+// 记录事件
+void Trace_Record(uint8_t level, uint16_t event, uint32_t arg0, uint32_t arg1, uint32_t arg2)
+{
+    TraceRing_t* ring = t_ring;
+    if (ring == NULL)
+    {
+        ring = claim_ring();
+        if (ring == NULL)
+        {
+            atomic_fetch_add_explicit(&g_lost_records, 1, memory_order_relaxed);
+            return;
+        }
+    }
+
+    uint32_t index = atomic_load_explicit(&ring->write_index, memory_order_relaxed);
+    TraceRecord_t* record = &ring->records[index & TRACE_RING_MASK];
+    record->timestamp = read_ticks();
+    record->event = event;
+    record->level = level;
+    record->reserved = 0;
+    record->args[0] = arg0;
+    record->args[1] = arg1;
+    record->args[2] = arg2;
+
+    // 发布记录，导出线程据此判断哪些记录已完整
+    atomic_store_explicit(&ring->write_index, index + 1, memory_order_release);
+}
+
+// 设置线程名称
+void Trace_SetThreadName(const char* name)
+{
+    TraceRing_t* ring = t_ring;
+    if (ring == NULL)
+    {
+        ring = claim_ring();
+    }
+    if (ring != NULL && name != NULL)
+    {
+        strncpy(ring->name, name, sizeof(ring->name) - 1);
+        ring->name[sizeof(ring->name) - 1] = '\0';
+    }
+}
+
+// 已记录的事件总数
+uint32_t Trace_GetRecordCount(void)
+{
+    unsigned int ring_count = atomic_load_explicit(&g_ring_count, memory_order_acquire);
+    uint32_t total = 0;
+    for (unsigned int i = 0; i < ring_count && i < TRACE_MAX_THREADS; i++)
+    {
+        total += atomic_load_explicit(&g_rings[i].write_index, memory_order_relaxed);
+    }
+    return total;
+}
+
+// 导出一个线程的记录：先复制，再根据复制后的写位置丢弃可能被覆盖的记录
+static bool dump_ring(FILE* file, unsigned int index, TraceRecord_t* scratch)
+{
+    TraceRing_t* ring = &g_rings[index];
+    uint32_t start = atomic_load_explicit(&ring->start_index, memory_order_acquire);
+    uint32_t end = atomic_load_explicit(&ring->write_index, memory_order_acquire);
+
+    // 写位置所在的槽可能正在被覆盖，最多复制容量-1条；只导出当前所属线程的记录
+    uint32_t begin = (end - start > TRACE_RING_CAPACITY - 1) ? end - (TRACE_RING_CAPACITY - 1) : start;
+    for (uint32_t i = begin; i != end; i++)
+    {
+        scratch[i - begin] = ring->records[i & TRACE_RING_MASK];
+    }
+
+    atomic_thread_fence(memory_order_acquire);
+    uint32_t end_after = atomic_load_explicit(&ring->write_index, memory_order_relaxed);
+    uint32_t valid_begin = begin;
+    if (end_after - begin > TRACE_RING_CAPACITY - 1)
+    {
+        valid_begin = end_after - (TRACE_RING_CAPACITY - 1);
+        if ((int32_t)(valid_begin - end) > 0)
+        {
+            valid_begin = end;
+        }
+    }
+
+    TraceThreadHeader_t header;
+    memset(&header, 0, sizeof(header));
+    header.thread_index = index;
+    header.record_count = end - valid_begin;
+    header.overwritten = valid_begin - start;
+    memcpy(header.name, ring->name, sizeof(header.name));
+
+    return fwrite(&header, sizeof(header), 1, file) == 1 &&
+           (header.record_count == 0 ||
+            fwrite(scratch + (valid_begin - begin), sizeof(TraceRecord_t), header.record_count, file) == header.record_count);
+}
+
+// 导出到文件
+bool Trace_Dump(const char* path)
+{
+    if (path == NULL)
+    {
+        return false;
+    }
+
+    Trace_Init();
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        printf("Cannot dump trace: Failed to open %s\n", path);
+        return false;
+    }
+
+    // 时钟计数与ns的比例从初始化到现在的时间段测得
+    uint64_t now_ticks = read_ticks();
+    uint64_t now_ns = monotonic_ns();
+
+    TraceFileHeader_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = TRACE_FILE_MAGIC;
+    header.version = TRACE_FILE_VERSION;
+    header.record_size = sizeof(TraceRecord_t);
+    header.thread_count = atomic_load_explicit(&g_ring_count, memory_order_acquire);
+    if (header.thread_count > TRACE_MAX_THREADS)
+    {
+        header.thread_count = TRACE_MAX_THREADS;
+    }
+    header.lost_records = atomic_load_explicit(&g_lost_records, memory_order_relaxed);
+    header.start_ticks = g_start_ticks;
+    header.ns_per_tick = (now_ticks > g_start_ticks)
+        ? (double)(now_ns - g_start_ns) / (double)(now_ticks - g_start_ticks)
+        : 1.0;
+
+    static TraceRecord_t scratch[TRACE_RING_CAPACITY];
+    bool result = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (uint32_t i = 0; result && i < header.thread_count; i++)
+    {
+        result = dump_ring(file, i, scratch);
+    }
+
+    if (fclose(file) != 0)
+    {
+        result = false;
+    }
+    if (!result)
+    {
+        printf("Cannot dump trace: Failed to write %s\n", path);
+    }
+    return result;
+}
+
+// 事件格式串
+const char* Trace_GetEventFormat(uint16_t event)
+{
+    return (event < TRACE_EVENT_MAX) ? g_event_formats[event] : NULL;
+}
+
+// 跟踪级别名称
+const char* Trace_GetLevelName(uint8_t level)
+{
+    switch (level)
+    {
+        case TRACE_LEVEL_ERROR:
+            return "ERROR";
+        case TRACE_LEVEL_WARN:
+            return "WARN";
+        case TRACE_LEVEL_INFO:
+            return "INFO";
+        case TRACE_LEVEL_DEBUG:
+            return "DEBUG";
+        default:
+            return "?";
+    }
+}
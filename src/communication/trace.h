@@ -0,0 +1,135 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 二进制跟踪：实时路径上只记录事件ID、3个参数和时间戳到本线程的环形缓冲区，
+// 不格式化、不加锁；Trace_Dump导出后由trace_decode离线格式化
+// 每个线程首次记录时占用一个环形缓冲区，写满后覆盖最旧的记录；
+// 线程退出时归还缓冲区，其记录保留到缓冲区被新线程复用
+
+// 跟踪级别
+#define TRACE_LEVEL_NONE  -1
+#define TRACE_LEVEL_ERROR  0
+#define TRACE_LEVEL_WARN   1
+#define TRACE_LEVEL_INFO   2
+#define TRACE_LEVEL_DEBUG  3
+
+// 编译期级别：高于该级别的TRACE_*宏展开为空，不产生任何代码
+#ifndef TRACE_COMPILE_LEVEL
+#define TRACE_COMPILE_LEVEL TRACE_LEVEL_INFO
+#endif
+
+// 每个线程的记录数（2的幂）和最多同时跟踪的线程数
+// 线程数按每条链路一个发送工作线程（PROTOCOL_MAX = 7）加主线程和最多8个应用线程估算，
+// 超出时多出线程的记录被丢弃并计入lost_records
+#ifndef TRACE_RING_CAPACITY
+#define TRACE_RING_CAPACITY 1024
+#endif
+#ifndef TRACE_MAX_THREADS
+#define TRACE_MAX_THREADS 16
+#endif
+
+// 事件表：事件ID和离线解码用的格式串，格式串最多使用3个%u/%d参数
+#define TRACE_EVENT_LIST(X) \
+    X(TRACE_FRAME_SENDING,          "Sending frame via protocol %u, frame length %u") \
+    X(TRACE_FRAME_SENT,             "Packet sent successfully. Protocol %u, frame length %u") \
+    X(TRACE_FRAME_RECEIVING,        "Receiving frame via protocol %u") \
+    X(TRACE_PACKET_RECEIVED,        "Packet received successfully. Packet ID: %u, Source: %u, Destination: %u") \
+    X(TRACE_SEND_NOT_CONNECTED,     "Cannot send packet: Link %u not connected (state %u)") \
+    X(TRACE_RECEIVE_NOT_CONNECTED,  "Cannot receive packet: Link %u not connected (state %u)") \
+    X(TRACE_SEND_INVALID_LENGTH,    "Cannot send packet: Invalid frame length %u") \
+    X(TRACE_SEND_POOL_EXHAUSTED,    "Cannot send packet: Packet pool exhausted") \
+    X(TRACE_RECEIVE_POOL_EXHAUSTED, "Cannot receive packet: Packet pool exhausted") \
+    X(TRACE_SEND_ENCODE_FAILED,     "Cannot send packet: Encoding failed, payload length %u") \
+    X(TRACE_RECEIVE_CRC_MISMATCH,   "Received packet with CRC mismatch, frame length %u") \
+    X(TRACE_TX_QUEUE_REJECTED,      "Cannot queue packet: Priority %u, queue enabled %u, link %u") \
+    X(TRACE_TX_QUEUE_FULL,          "TX queue full: Priority %u, depth %u, link %u") \
+    X(TRACE_SEND_FAILED,            "Cannot send packet: Transport error, protocol %u, frame length %u")
+
+#define TRACE_EVENT_ID(id, format) id,
+typedef enum {
+    TRACE_EVENT_LIST(TRACE_EVENT_ID)
+    TRACE_EVENT_MAX
+} TraceEvent;
+#undef TRACE_EVENT_ID
+
+// 一条跟踪记录，24字节
+typedef struct {
+    uint64_t timestamp;            // 时钟计数，导出时给出换算为ns的比例
+    uint16_t event;                // TraceEvent
+    uint8_t level;                 // 跟踪级别
+    uint8_t reserved;
+    uint32_t args[3];
+} TraceRecord_t;
+
+// 导出文件格式（本机字节序）：文件头，然后每个线程一个线程头加record_count条按时间排列的记录
+#define TRACE_FILE_MAGIC 0x43525458u   // "XTRC"
+#define TRACE_FILE_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;          // sizeof(TraceRecord_t)
+    uint32_t thread_count;
+    uint32_t lost_records;         // 同时记录的线程数超过TRACE_MAX_THREADS时丢弃的记录数
+    uint64_t start_ticks;          // Trace_Init时的时钟计数
+    double ns_per_tick;            // 时钟计数换算为ns的比例
+} TraceFileHeader_t;
+
+typedef struct {
+    uint32_t thread_index;         // 环形缓冲区编号，线程退出后可被新线程复用
+    uint32_t record_count;
+    uint32_t overwritten;          // 该线程被覆盖的旧记录数
+    char name[20];                 // Trace_SetThreadName设置的名称
+} TraceThreadHeader_t;
+
+// 初始化：记录时钟起点，首次记录时也会自动调用
+void Trace_Init(void);
+
+// 记录一个事件：只写本线程的环形缓冲区，无锁，不阻塞
+// 一般通过TRACE_*宏调用，以便按编译期级别去掉
+void Trace_Record(uint8_t level, uint16_t event, uint32_t arg0, uint32_t arg1, uint32_t arg2);
+
+// 设置当前线程在导出文件中的名称
+void Trace_SetThreadName(const char* name);
+
+// 所有线程已记录的事件总数（包括已被覆盖的）
+uint32_t Trace_GetRecordCount(void);
+
+// 导出所有线程的环形缓冲区到文件；可在记录线程运行时调用，正在被覆盖的记录会被跳过
+// 不能在多个线程中同时导出
+bool Trace_Dump(const char* path);
+
+// 事件的格式串，未知事件返回NULL
+const char* Trace_GetEventFormat(uint16_t event);
+
+// 跟踪级别名称
+const char* Trace_GetLevelName(uint8_t level);
+
+#if TRACE_COMPILE_LEVEL >= TRACE_LEVEL_ERROR
+#define TRACE_ERROR(event, arg0, arg1, arg2) Trace_Record(TRACE_LEVEL_ERROR, (event), (arg0), (arg1), (arg2))
+#else
+#define TRACE_ERROR(event, arg0, arg1, arg2) ((void)0)
+#endif
+
+#if TRACE_COMPILE_LEVEL >= TRACE_LEVEL_WARN
+#define TRACE_WARN(event, arg0, arg1, arg2) Trace_Record(TRACE_LEVEL_WARN, (event), (arg0), (arg1), (arg2))
+#else
+#define TRACE_WARN(event, arg0, arg1, arg2) ((void)0)
+#endif
+
+#if TRACE_COMPILE_LEVEL >= TRACE_LEVEL_INFO
+#define TRACE_INFO(event, arg0, arg1, arg2) Trace_Record(TRACE_LEVEL_INFO, (event), (arg0), (arg1), (arg2))
+#else
+#define TRACE_INFO(event, arg0, arg1, arg2) ((void)0)
+#endif
+
+#if TRACE_COMPILE_LEVEL >= TRACE_LEVEL_DEBUG
+#define TRACE_DEBUG(event, arg0, arg1, arg2) Trace_Record(TRACE_LEVEL_DEBUG, (event), (arg0), (arg1), (arg2))
+#else
+#define TRACE_DEBUG(event, arg0, arg1, arg2) ((void)0)
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+
+// 离线解码Trace_Dump导出的跟踪文件：合并所有线程的记录，按时间顺序格式化输出
+// 用法：trace_decode <跟踪文件>
+
+// 带线程信息的记录
+typedef struct {
+    TraceRecord_t record;
+    uint32_t thread;
+} DecodedRecord_t;
+
+static int compare_timestamp(const void* a, const void* b)
+{
+    uint64_t ta = ((const DecodedRecord_t*)a)->record.timestamp;
+    uint64_t tb = ((const DecodedRecord_t*)b)->record.timestamp;
+    return (ta > tb) - (ta < tb);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        printf("Usage: %s <trace file>\n", argv[0]);
+        return 1;
+    }
+
+    FILE* file = fopen(argv[1], "rb");
+    if (file == NULL)
+    {
+        printf("Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    TraceFileHeader_t header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != TRACE_FILE_MAGIC ||
+        header.version != TRACE_FILE_VERSION || header.record_size != sizeof(TraceRecord_t) ||
+        header.thread_count > TRACE_MAX_THREADS)
+    {
+        printf("%s is not a trace file of this version\n", argv[1]);
+        fclose(file);
+        return 1;
+    }
+
+    TraceThreadHeader_t threads[TRACE_MAX_THREADS];
+    DecodedRecord_t* records = NULL;
+    size_t count = 0;
+    for (uint32_t t = 0; t < header.thread_count; t++)
+    {
+        if (fread(&threads[t], sizeof(threads[t]), 1, file) != 1)
+        {
+            printf("Truncated trace file\n");
+            free(records);
+            fclose(file);
+            return 1;
+        }
+        threads[t].name[sizeof(threads[t].name) - 1] = '\0';
+
+        DecodedRecord_t* grown = (DecodedRecord_t*)realloc(records, (count + threads[t].record_count) * sizeof(DecodedRecord_t) + 1);
+        if (grown == NULL)
+        {
+            printf("Out of memory\n");
+            free(records);
+            fclose(file);
+            return 1;
+        }
+        records = grown;
+        for (uint32_t i = 0; i < threads[t].record_count; i++)
+        {
+            if (fread(&records[count].record, sizeof(TraceRecord_t), 1, file) != 1)
+            {
+                printf("Truncated trace file\n");
+                free(records);
+                fclose(file);
+                return 1;
+            }
+            records[count].thread = t;
+            count++;
+        }
+    }
+    fclose(file);
+
+    printf("# %zu records from %u threads, %.4f ns per tick\n", count, header.thread_count, header.ns_per_tick);
+    for (uint32_t t = 0; t < header.thread_count; t++)
+    {
+        printf("# thread %u %s: %u records, %u overwritten\n", threads[t].thread_index,
+               threads[t].name[0] ? threads[t].name : "-", threads[t].record_count, threads[t].overwritten);
+    }
+    if (header.lost_records > 0)
+    {
+        printf("# %u records lost: more than %d threads at once\n", header.lost_records, TRACE_MAX_THREADS);
+    }
+
+    qsort(records, count, sizeof(DecodedRecord_t), compare_timestamp);
+    for (size_t i = 0; i < count; i++)
+    {
+        const TraceRecord_t* record = &records[i].record;
+        const TraceThreadHeader_t* thread = &threads[records[i].thread];
+        double time_us = (double)(int64_t)(record->timestamp - header.start_ticks) * header.ns_per_tick * 1e-3;
+        printf("%14.3f us [%s] %-5s ", time_us,
+               thread->name[0] ? thread->name : "-", Trace_GetLevelName(record->level));
+
+        const char* format = Trace_GetEventFormat(record->event);
+        if (format != NULL)
+        {
+            printf(format, record->args[0], record->args[1], record->args[2]);
+        }
+        else
+        {
+            printf("Unknown event %u: %u %u %u", record->event, record->args[0], record->args[1], record->args[2]);
+        }
+        printf("\n");
+    }
+
+    free(records);
+    return 0;
+}
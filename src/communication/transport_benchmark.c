@@ -0,0 +1,198 @@
+#define _POSIX_C_SOURCE 200809L
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "data_transfer.h"
+#include "protocol_stack.h"
+#include "udp_transport.h"
+
+// 数据通路基准测试：关节数据经DataTransfer、编解码器、缓冲池和传输层的吞吐量和延迟
+// loopback：同一线程发送后立即接收，测量不含网络的协议栈开销
+// udp：另一个进程作为回显节点加入同一组播总线，测量往返延迟
+// 用法：transport_benchmark [loopback|udp] [次数]
+
+// 获取单调时钟时间 (单位: ns)
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int compare_u64(const void* a, const void* b)
+{
+    uint64_t va = *(const uint64_t*)a;
+    uint64_t vb = *(const uint64_t*)b;
+    return (va > vb) - (va < vb);
+}
+
+// 打印延迟分布 (单位: us)
+static void print_latency(const char* name, uint64_t* samples, int count)
+{
+    if (count == 0)
+    {
+        printf("%-22s no samples\n", name);
+        return;
+    }
+
+    qsort(samples, count, sizeof(uint64_t), compare_u64);
+    uint64_t sum = 0;
+    for (int i = 0; i < count; i++)
+    {
+        sum += samples[i];
+    }
+    printf("%-22s %8d %9.2f %9.2f %9.2f %9.2f %9.2f\n", name, count,
+           sum * 1e-3 / count, samples[count / 2] * 1e-3, samples[(int)(count * 0.99)] * 1e-3,
+           samples[(int)(count * 0.999)] * 1e-3, samples[count - 1] * 1e-3);
+}
+
+// 回环：每次发送一个关节数据包并立即接收
+static int run_loopback(int iterations, uint64_t* samples)
+{
+    if (!ProtocolStack_Init(PROTOCOL_LOOPBACK) || !DataTransfer_Init())
+    {
+        return 1;
+    }
+
+    JointData_t joint = {0.5f, 0.1f, 2.0f, 0.0f};
+    JointData_t received;
+    uint16_t joint_id;
+    int ok = 0;
+    uint64_t start = monotonic_ns();
+    for (int i = 0; i < iterations; i++)
+    {
+        uint64_t t0 = monotonic_ns();
+        joint.position = (float)i;
+        if (DataTransfer_SendJointData((uint16_t)(i & 0xFF), &joint, PRIORITY_HIGH) &&
+            DataTransfer_ReceiveJointData(&joint_id, &received))
+        {
+            samples[ok++] = monotonic_ns() - t0;
+        }
+    }
+    double elapsed = (monotonic_ns() - start) * 1e-9;
+
+    printf("loopback: %d/%d joint frames, %.0f frames/s\n", ok, iterations, ok / elapsed);
+    printf("%-22s %8s %9s %9s %9s %9s %9s\n", "[us]", "count", "mean", "p50", "p99", "p99.9", "max");
+    print_latency("send+receive", samples, ok);
+    ProtocolStack_Close();
+    return (ok == iterations) ? 0 : 1;
+}
+
+// 回显节点：把收到的每一帧原样发回总线，空闲1秒后退出
+static void run_echo_node(void)
+{
+    UdpTransportConfig_t config;
+    UdpTransport_GetDefaultConfig(&config);
+    config.receive_timeout_ms = 1000;
+    UdpTransport_Configure(&config);
+    if (!ProtocolStack_Init(PROTOCOL_UDP))
+    {
+        _exit(1);
+    }
+
+    uint8_t frame[MAX_PACKET_SIZE];
+    uint16_t length;
+    while (ProtocolStack_ReceiveFrame(frame, sizeof(frame), &length))
+    {
+        ProtocolStack_SendFrame(frame, length);
+    }
+    ProtocolStack_Close();
+    _exit(0);
+}
+
+// UDP组播：测量经回显节点的往返延迟
+static int run_udp(int iterations, uint64_t* samples)
+{
+    fflush(stdout);
+    pid_t echo = fork();
+    if (echo < 0)
+    {
+        printf("Failed to start the echo node\n");
+        return 1;
+    }
+    if (echo == 0)
+    {
+        freopen("/dev/null", "w", stdout);
+        run_echo_node();
+    }
+
+    UdpTransportConfig_t config;
+    UdpTransport_GetDefaultConfig(&config);
+    config.receive_timeout_ms = 100;
+    UdpTransport_Configure(&config);
+    if (!ProtocolStack_Init(PROTOCOL_UDP) || !DataTransfer_Init())
+    {
+        kill(echo, SIGTERM);
+        waitpid(echo, NULL, 0);
+        return 1;
+    }
+
+    // 等待回显节点加入组播组
+    JointData_t joint = {0.5f, 0.1f, 2.0f, 0.0f};
+    JointData_t received;
+    uint16_t joint_id;
+    bool ready = false;
+    for (int attempt = 0; attempt < 50 && !ready; attempt++)
+    {
+        ready = DataTransfer_SendJointData(0, &joint, PRIORITY_HIGH) &&
+                DataTransfer_ReceiveJointData(&joint_id, &received);
+    }
+
+    int ok = 0;
+    uint64_t start = monotonic_ns();
+    for (int i = 0; ready && i < iterations; i++)
+    {
+        uint64_t t0 = monotonic_ns();
+        joint.position = (float)i;
+        if (DataTransfer_SendJointData((uint16_t)(i & 0xFF), &joint, PRIORITY_HIGH) &&
+            DataTransfer_ReceiveJointData(&joint_id, &received) && received.position == joint.position)
+        {
+            samples[ok++] = monotonic_ns() - t0;
+        }
+    }
+    double elapsed = (monotonic_ns() - start) * 1e-9;
+    ProtocolStack_Close();
+    waitpid(echo, NULL, 0);
+
+    if (!ready)
+    {
+        printf("udp: echo node did not answer\n");
+        return 1;
+    }
+    printf("udp: %d/%d joint frames echoed, %.0f round trips/s\n", ok, iterations, ok / elapsed);
+    printf("%-22s %8s %9s %9s %9s %9s %9s\n", "[us]", "count", "mean", "p50", "p99", "p99.9", "max");
+    print_latency("round trip", samples, ok);
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    const char* mode = (argc > 1) ? argv[1] : "loopback";
+    int iterations = (argc > 2) ? atoi(argv[2]) : 0;
+    bool loopback = (strcmp(mode, "loopback") == 0);
+    if ((!loopback && strcmp(mode, "udp") != 0) || iterations < 0)
+    {
+        printf("Usage: %s [loopback|udp] [iterations]\n", argv[0]);
+        return 1;
+    }
+    if (iterations == 0)
+    {
+        iterations = loopback ? 200000 : 20000;
+    }
+
+    uint64_t* samples = (uint64_t*)malloc(sizeof(uint64_t) * iterations);
+    if (samples == NULL)
+    {
+        printf("Failed to allocate samples\n");
+        return 1;
+    }
+
+    int result = loopback ? run_loopback(iterations, samples) : run_udp(iterations, samples);
+    free(samples);
+    return result;
+}
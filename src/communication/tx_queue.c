@@ -0,0 +1,650 @@
+#define _POSIX_C_SOURCE 200809L
+#include "tx_queue.h"
+#include "trace.h"
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if (TX_QUEUE_CAPACITY & (TX_QUEUE_CAPACITY - 1)) != 0 || TX_QUEUE_CAPACITY < PACKET_POOL_CAPACITY
+#error "TX_QUEUE_CAPACITY must be a power of two not smaller than PACKET_POOL_CAPACITY"
+#endif
+
+#define TX_QUEUE_MASK (TX_QUEUE_CAPACITY - 1)
+
+// 默认的中/低优先级排队上限
+#define TX_QUEUE_DEFAULT_LOW_LIMIT 16
+
+// 队列槽：sequence等于位置时可写，等于位置+1时可读
+typedef struct {
+    _Atomic uint32_t sequence;
+    PacketBuffer_t* buffer;
+    uint64_t enqueue_time;         // 入队时刻 (单位: ns)
+} TxSlot_t;
+
+// 单个优先级的多生产者单消费者环形队列和统计
+typedef struct {
+    _Alignas(64) _Atomic uint32_t tail;   // 生产者竞争的写位置
+    _Alignas(64) _Atomic uint32_t head;   // 只由消费者修改的读位置
+    uint32_t limit;
+    TxSlot_t slots[TX_QUEUE_CAPACITY];
+
+    atomic_uint enqueued;
+    atomic_uint sent;
+    atomic_uint send_errors;
+    atomic_uint dropped;
+    atomic_uint max_depth;
+    atomic_uint delay_count;
+    atomic_uint delay_min;
+    atomic_uint delay_max;
+    _Atomic uint64_t delay_sum;
+    _Atomic uint32_t delay_bins[TX_QUEUE_DELAY_BINS + 1];
+} TxRing_t;
+
+// 单条链路的发送队列和工作线程
+typedef struct {
+    TxRing_t rings[PRIORITY_MAX];
+    uint8_t credits[PRIORITY_MAX];        // 加权轮转的剩余份额，只由消费者使用
+    sem_t pending;                        // 待发送数据包数，工作线程据此阻塞等待
+    atomic_bool stop_worker;
+    bool worker_running;
+    pthread_t worker;
+    ProtocolType link;
+} TxLink_t;
+
+// 全局变量定义
+static TxLink_t g_links[PROTOCOL_MAX];
+static TxQueueConfig_t g_config;
+static bool g_weighted = false;
+static atomic_bool g_enabled;
+static atomic_uint g_active_producers;  // 已通过启用检查、尚未完成入队的生产者数，关闭时等待其归零
+
+// 获取单调时钟时间 (单位: ns)
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// 原子地更新最大值/最小值
+static void atomic_store_max(atomic_uint* target, unsigned int value)
+{
+    unsigned int current = atomic_load_explicit(target, memory_order_relaxed);
+    while (value > current &&
+           !atomic_compare_exchange_weak_explicit(target, &current, value,
+                                                  memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+}
+
+static void atomic_store_min(atomic_uint* target, unsigned int value)
+{
+    unsigned int current = atomic_load_explicit(target, memory_order_relaxed);
+    while (value < current &&
+           !atomic_compare_exchange_weak_explicit(target, &current, value,
+                                                  memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+}
+
+// 清零一个优先级的统计
+static void reset_ring_stats(TxRing_t* ring)
+{
+    atomic_store_explicit(&ring->enqueued, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->sent, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->send_errors, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->dropped, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->max_depth, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->delay_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->delay_min, UINT32_MAX, memory_order_relaxed);
+    atomic_store_explicit(&ring->delay_max, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->delay_sum, 0, memory_order_relaxed);
+    for (int i = 0; i <= TX_QUEUE_DELAY_BINS; i++)
+    {
+        atomic_store_explicit(&ring->delay_bins[i], 0, memory_order_relaxed);
+    }
+}
+
+// 消费者查看队列是否为空
+static bool ring_empty(TxRing_t* ring)
+{
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t sequence = atomic_load_explicit(&ring->slots[head & TX_QUEUE_MASK].sequence, memory_order_acquire);
+    return sequence != head + 1;
+}
+
+// 消费者取出队首数据包，调用前已确认队列非空
+static PacketBuffer_t* ring_pop(TxRing_t* ring, uint64_t* enqueue_time)
+{
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    TxSlot_t* slot = &ring->slots[head & TX_QUEUE_MASK];
+    PacketBuffer_t* buffer = slot->buffer;
+    *enqueue_time = slot->enqueue_time;
+    
+    // 槽位留给下一圈的生产者
+    atomic_store_explicit(&slot->sequence, head + TX_QUEUE_CAPACITY, memory_order_release);
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return buffer;
+}
+
+// 队列中是否有已占位但生产者尚未写完的槽
+static bool ring_claimed(TxRing_t* ring)
+{
+    return atomic_load_explicit(&ring->tail, memory_order_acquire) !=
+           atomic_load_explicit(&ring->head, memory_order_relaxed);
+}
+
+// 链路上是否还有已占位的槽，包括已发布和尚未发布的
+static bool link_claimed(TxLink_t* link)
+{
+    for (int p = 0; p < PRIORITY_MAX; p++)
+    {
+        if (ring_claimed(&link->rings[p]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 选择链路上下一个发送的优先级，所有队列为空时返回-1
+static int select_priority(TxLink_t* link)
+{
+    if (!ring_empty(&link->rings[PRIORITY_HIGH]))
+    {
+        return PRIORITY_HIGH;
+    }
+    
+    if (!g_weighted)
+    {
+        for (int p = PRIORITY_MEDIUM; p < PRIORITY_MAX; p++)
+        {
+            if (!ring_empty(&link->rings[p]))
+            {
+                return p;
+            }
+        }
+        return -1;
+    }
+    
+    // 加权轮转：按优先级顺序消耗份额，非空队列的份额都用完后重新分配
+    for (int round = 0; round < 2; round++)
+    {
+        bool any_pending = false;
+        for (int p = PRIORITY_MEDIUM; p < PRIORITY_MAX; p++)
+        {
+            if (ring_empty(&link->rings[p]))
+            {
+                continue;
+            }
+            any_pending = true;
+            if (link->credits[p] > 0)
+            {
+                link->credits[p]--;
+                return p;
+            }
+        }
+        
+        if (!any_pending)
+        {
+            return -1;
+        }
+        memcpy(link->credits, g_config.weights, sizeof(link->credits));
+    }
+    return -1;
+}
+
+// 记录排队延迟
+static void record_delay(TxRing_t* ring, uint64_t delay_ns)
+{
+    uint32_t delay = (delay_ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)delay_ns;
+    uint32_t bin = delay / TX_QUEUE_DELAY_BIN_NS;
+    if (bin > TX_QUEUE_DELAY_BINS)
+    {
+        bin = TX_QUEUE_DELAY_BINS;
+    }
+    
+    atomic_fetch_add_explicit(&ring->delay_bins[bin], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&ring->delay_sum, delay, memory_order_relaxed);
+    atomic_fetch_add_explicit(&ring->delay_count, 1, memory_order_relaxed);
+    atomic_store_min(&ring->delay_min, delay);
+    atomic_store_max(&ring->delay_max, delay);
+}
+
+// 在链路上发送一个数据包，所有队列为空时返回false
+static bool process_one(TxLink_t* link)
+{
+    int priority = select_priority(link);
+    if (priority < 0)
+    {
+        return false;
+    }
+    
+    TxRing_t* ring = &link->rings[priority];
+    uint64_t enqueue_time;
+    PacketBuffer_t* buffer = ring_pop(ring, &enqueue_time);
+    record_delay(ring, monotonic_ns() - enqueue_time);
+    
+    if (g_config.transmit(link->link, buffer->frame, buffer->frame_length))
+    {
+        atomic_fetch_add_explicit(&ring->sent, 1, memory_order_relaxed);
+    }
+    else
+    {
+        atomic_fetch_add_explicit(&ring->send_errors, 1, memory_order_relaxed);
+    }
+    
+    PacketPool_Release(buffer);
+    return true;
+}
+
+// 发送链路上所有已发布的数据包。wait_claimed为true时，队首槽已占位但生产者尚未写完的
+// 也让出CPU等待其发布；只在关闭路径上使用，工作线程靠生产者发布后的sem_post再次唤醒，
+// 不在这里自旋：SCHED_FIFO的工作线程sched_yield时不会让同一CPU上被抢占的普通生产者运行
+static int drain_link(TxLink_t* link, bool wait_claimed)
+{
+    int count = 0;
+    for (;;)
+    {
+        while (process_one(link))
+        {
+            count++;
+        }
+        if (!wait_claimed || !link_claimed(link))
+        {
+            return count;
+        }
+        sched_yield();
+    }
+}
+
+// 工作线程：每次唤醒后发送所有已发布的数据包，多余的信号量计数只造成一次空唤醒
+static void* worker_main(void* arg)
+{
+    TxLink_t* link = (TxLink_t*)arg;
+    char name[20];
+    snprintf(name, sizeof(name), "tx_worker_%d", link->link);
+    Trace_SetThreadName(name);
+    
+    if (g_config.worker_priority > 0)
+    {
+        struct sched_param param;
+        param.sched_priority = g_config.worker_priority;
+        int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (err != 0)
+        {
+            printf("TX worker: SCHED_FIFO priority %d failed: %s\n", g_config.worker_priority, strerror(err));
+        }
+    }
+    
+    for (;;)
+    {
+        while (sem_wait(&link->pending) != 0)
+        {
+            // 被信号中断，继续等待
+        }
+        
+        if (atomic_load_explicit(&link->stop_worker, memory_order_acquire))
+        {
+            break;
+        }
+        drain_link(link, false);
+    }
+    
+    return NULL;
+}
+
+// 获取默认配置
+void TxQueue_GetDefaultConfig(TxQueueConfig_t* config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+    
+    memset(config, 0, sizeof(*config));
+    config->queue_limits[PRIORITY_HIGH] = TX_QUEUE_CAPACITY;
+    config->queue_limits[PRIORITY_MEDIUM] = TX_QUEUE_DEFAULT_LOW_LIMIT;
+    config->queue_limits[PRIORITY_LOW] = TX_QUEUE_DEFAULT_LOW_LIMIT;
+    config->worker_priority = 0;
+    config->transmit = ProtocolStack_SendLinkFrame;
+}
+
+// 初始化发送队列
+bool TxQueue_Init(const TxQueueConfig_t* config)
+{
+    if (atomic_load_explicit(&g_enabled, memory_order_acquire))
+    {
+        printf("Cannot initialize TX queue: Already enabled\n");
+        return false;
+    }
+    
+    if (config != NULL)
+    {
+        g_config = *config;
+    }
+    else
+    {
+        TxQueue_GetDefaultConfig(&g_config);
+    }
+    
+    if (g_config.transmit == NULL)
+    {
+        g_config.transmit = ProtocolStack_SendLinkFrame;
+    }
+    
+    // 中/低优先级权重都为0时按严格优先级发送，否则权重0按1处理
+    g_weighted = (g_config.weights[PRIORITY_MEDIUM] != 0) || (g_config.weights[PRIORITY_LOW] != 0);
+    for (int p = PRIORITY_MEDIUM; p < PRIORITY_MAX; p++)
+    {
+        if (g_weighted && g_config.weights[p] == 0)
+        {
+            g_config.weights[p] = 1;
+        }
+    }
+    
+    for (int l = 0; l < PROTOCOL_MAX; l++)
+    {
+        TxLink_t* link = &g_links[l];
+        link->link = (ProtocolType)l;
+        link->worker_running = false;
+        memcpy(link->credits, g_config.weights, sizeof(link->credits));
+        for (int p = 0; p < PRIORITY_MAX; p++)
+        {
+            TxRing_t* ring = &link->rings[p];
+            uint16_t limit = g_config.queue_limits[p];
+            ring->limit = (limit == 0 || limit > TX_QUEUE_CAPACITY) ? TX_QUEUE_CAPACITY : limit;
+            for (uint32_t i = 0; i < TX_QUEUE_CAPACITY; i++)
+            {
+                atomic_store_explicit(&ring->slots[i].sequence, i, memory_order_relaxed);
+                ring->slots[i].buffer = NULL;
+            }
+            atomic_store_explicit(&ring->head, 0, memory_order_relaxed);
+            atomic_store_explicit(&ring->tail, 0, memory_order_relaxed);
+            reset_ring_stats(ring);
+        }
+        
+        if (sem_init(&link->pending, 0, 0) != 0)
+        {
+            printf("Cannot initialize TX queue: Semaphore creation failed\n");
+            while (--l >= 0)
+            {
+                sem_destroy(&g_links[l].pending);
+            }
+            return false;
+        }
+    }
+    
+    atomic_store_explicit(&g_enabled, true, memory_order_release);
+    return true;
+}
+
+// 发送队列是否已启用
+bool TxQueue_IsEnabled(void)
+{
+    return atomic_load_explicit(&g_enabled, memory_order_acquire);
+}
+
+// 入队
+bool TxQueue_Enqueue(ProtocolType link, PacketBuffer_t* buffer)
+{
+    if (buffer == NULL)
+    {
+        return false;
+    }
+    
+    // 先登记再检查启用标志，与TxQueue_Shutdown中先停用再等待登记归零配对（均为顺序一致），
+    // 保证关闭时不会有生产者在检查之后仍向已销毁的队列写入
+    atomic_fetch_add(&g_active_producers, 1);
+    if (!atomic_load(&g_enabled) || link >= PROTOCOL_MAX || buffer->header.priority >= PRIORITY_MAX)
+    {
+        atomic_fetch_sub_explicit(&g_active_producers, 1, memory_order_release);
+        TRACE_WARN(TRACE_TX_QUEUE_REJECTED, buffer->header.priority, atomic_load_explicit(&g_enabled, memory_order_relaxed), link);
+        PacketPool_Release(buffer);
+        return false;
+    }
+    
+    TxLink_t* tx_link = &g_links[link];
+    TxRing_t* ring = &tx_link->rings[buffer->header.priority];
+    uint64_t now = monotonic_ns();
+    uint32_t position = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    TxSlot_t* slot;
+    bool full = false;
+    for (;;)
+    {
+        slot = &ring->slots[position & TX_QUEUE_MASK];
+        uint32_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        int32_t diff = (int32_t)(sequence - position);
+        if (diff == 0)
+        {
+            // 排队上限检查是近似的，并发入队时最多超出生产者数量。
+            // position过期时head可能已越过它，按有符号深度比较，由CAS失败重新读取
+            uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+            if ((int32_t)(position - head) >= (int32_t)ring->limit)
+            {
+                full = true;
+                break;
+            }
+            if (atomic_compare_exchange_weak_explicit(&ring->tail, &position, position + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // 槽位中还是上一圈未发送的数据包
+            full = true;
+            break;
+        }
+        else
+        {
+            // 其他生产者已占用该位置
+            position = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        }
+    }
+    
+    if (full)
+    {
+        atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+        atomic_fetch_sub_explicit(&g_active_producers, 1, memory_order_release);
+        TRACE_WARN(TRACE_TX_QUEUE_FULL, buffer->header.priority,
+                   position - atomic_load_explicit(&ring->head, memory_order_relaxed), link);
+        PacketPool_Release(buffer);
+        return false;
+    }
+    
+    slot->buffer = buffer;
+    slot->enqueue_time = now;
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+    
+    // 消费者可能已取走该数据包，此时深度为负，不计入
+    atomic_fetch_add_explicit(&ring->enqueued, 1, memory_order_relaxed);
+    int32_t depth = (int32_t)(position + 1 - atomic_load_explicit(&ring->head, memory_order_relaxed));
+    if (depth > 0)
+    {
+        atomic_store_max(&ring->max_depth, (unsigned int)depth);
+    }
+    sem_post(&tx_link->pending);
+    atomic_fetch_sub_explicit(&g_active_producers, 1, memory_order_release);
+    return true;
+}
+
+// 在调用线程中发送
+int TxQueue_Process(ProtocolType link, int max_packets)
+{
+    if (link >= PROTOCOL_MAX)
+    {
+        return 0;
+    }
+    
+    TxLink_t* tx_link = &g_links[link];
+    if (tx_link->worker_running)
+    {
+        printf("Cannot process TX queue: Worker is running on link %d\n", link);
+        return 0;
+    }
+    
+    int count = 0;
+    if (max_packets < 0)
+    {
+        count = drain_link(tx_link, true);
+    }
+    else
+    {
+        while (count < max_packets && process_one(tx_link))
+        {
+            count++;
+        }
+    }
+    
+    // 消耗对应的信号量计数；计数暂时落后或多余时工作线程只会多唤醒一次
+    for (int i = 0; i < count; i++)
+    {
+        sem_trywait(&tx_link->pending);
+    }
+    return count;
+}
+
+// 启动工作线程
+bool TxQueue_StartWorker(ProtocolType link)
+{
+    if (!atomic_load_explicit(&g_enabled, memory_order_acquire) || link >= PROTOCOL_MAX)
+    {
+        printf("Cannot start TX worker: Queue not initialized or invalid link %d\n", link);
+        return false;
+    }
+    
+    TxLink_t* tx_link = &g_links[link];
+    if (tx_link->worker_running)
+    {
+        return true;
+    }
+    
+    atomic_store_explicit(&tx_link->stop_worker, false, memory_order_release);
+    int err = pthread_create(&tx_link->worker, NULL, worker_main, tx_link);
+    if (err != 0)
+    {
+        printf("Cannot start TX worker: %s\n", strerror(err));
+        return false;
+    }
+    
+    tx_link->worker_running = true;
+    return true;
+}
+
+// 停止工作线程
+void TxQueue_StopWorker(ProtocolType link)
+{
+    if (link >= PROTOCOL_MAX || !g_links[link].worker_running)
+    {
+        return;
+    }
+    
+    TxLink_t* tx_link = &g_links[link];
+    atomic_store_explicit(&tx_link->stop_worker, true, memory_order_release);
+    sem_post(&tx_link->pending);
+    pthread_join(tx_link->worker, NULL);
+    tx_link->worker_running = false;
+}
+
+// 关闭发送队列
+void TxQueue_Shutdown(void)
+{
+    if (!atomic_load_explicit(&g_enabled, memory_order_acquire))
+    {
+        return;
+    }
+    
+    // 先停用，之后的发送直接走同步路径；再等待已通过启用检查的生产者完成入队
+    atomic_store(&g_enabled, false);
+    while (atomic_load(&g_active_producers) != 0)
+    {
+        sched_yield();
+    }
+    
+    // 此时所有入队都已发布，停止工作线程后剩余数据包在这里发完
+    for (int l = 0; l < PROTOCOL_MAX; l++)
+    {
+        TxQueue_StopWorker((ProtocolType)l);
+    }
+    for (int l = 0; l < PROTOCOL_MAX; l++)
+    {
+        TxQueue_Process((ProtocolType)l, -1);
+        sem_destroy(&g_links[l].pending);
+    }
+}
+
+// 获取发送统计
+bool TxQueue_GetStats(ProtocolType link, PriorityLevel priority, TxQueueStats_t* stats)
+{
+    if (stats == NULL || link >= PROTOCOL_MAX || priority >= PRIORITY_MAX)
+    {
+        return false;
+    }
+    
+    TxRing_t* ring = &g_links[link].rings[priority];
+    stats->enqueued = atomic_load_explicit(&ring->enqueued, memory_order_relaxed);
+    stats->sent = atomic_load_explicit(&ring->sent, memory_order_relaxed);
+    stats->send_errors = atomic_load_explicit(&ring->send_errors, memory_order_relaxed);
+    stats->dropped = atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+    stats->depth = (uint16_t)(atomic_load_explicit(&ring->tail, memory_order_relaxed) -
+                              atomic_load_explicit(&ring->head, memory_order_relaxed));
+    stats->max_depth = (uint16_t)atomic_load_explicit(&ring->max_depth, memory_order_relaxed);
+    
+    uint32_t count = atomic_load_explicit(&ring->delay_count, memory_order_relaxed);
+    stats->delay_count = count;
+    if (count == 0)
+    {
+        stats->delay_min = stats->delay_mean = stats->delay_max = 0;
+        stats->delay_p99 = stats->delay_p999 = 0;
+        return true;
+    }
+    
+    stats->delay_min = atomic_load_explicit(&ring->delay_min, memory_order_relaxed);
+    stats->delay_max = atomic_load_explicit(&ring->delay_max, memory_order_relaxed);
+    stats->delay_mean = (uint32_t)(atomic_load_explicit(&ring->delay_sum, memory_order_relaxed) / count);
+    
+    // 分位数取所在直方图格的上沿
+    uint64_t p99_rank = ((uint64_t)count * 99 + 99) / 100;
+    uint64_t p999_rank = ((uint64_t)count * 999 + 999) / 1000;
+    uint64_t seen = 0;
+    stats->delay_p99 = stats->delay_p999 = stats->delay_max;
+    bool p99_found = false;
+    for (int i = 0; i < TX_QUEUE_DELAY_BINS; i++)
+    {
+        seen += atomic_load_explicit(&ring->delay_bins[i], memory_order_relaxed);
+        uint32_t upper = (uint32_t)(i + 1) * TX_QUEUE_DELAY_BIN_NS;
+        if (upper > stats->delay_max)
+        {
+            upper = stats->delay_max;
+        }
+        if (!p99_found && seen >= p99_rank)
+        {
+            stats->delay_p99 = upper;
+            p99_found = true;
+        }
+        if (seen >= p999_rank)
+        {
+            stats->delay_p999 = upper;
+            break;
+        }
+    }
+    return true;
+}
+
+// 清零发送统计
+void TxQueue_ResetStats(void)
+{
+    for (int l = 0; l < PROTOCOL_MAX; l++)
+    {
+        for (int p = 0; p < PRIORITY_MAX; p++)
+        {
+            reset_ring_stats(&g_links[l].rings[p]);
+        }
+    }
+}
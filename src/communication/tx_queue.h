@@ -0,0 +1,84 @@
+#ifndef TX_QUEUE_H
+#define TX_QUEUE_H
+
+#include "packet_pool.h"
+
+// 每个优先级发送队列的容量（2的幂），不小于缓冲池容量，队列本身不会先于缓冲池耗尽
+#define TX_QUEUE_CAPACITY 64
+
+// 排队延迟直方图：1us一格，最高2ms，超出部分计入最后一格
+#define TX_QUEUE_DELAY_BINS 2000
+#define TX_QUEUE_DELAY_BIN_NS 1000
+
+// 每条链路（见ProtocolStack_OpenLink）有独立的各优先级队列和工作线程，
+// 一条链路上的大数据包不会阻塞另一条链路上的实时数据
+
+// 帧发送函数，发送队列在各链路的工作线程中调用
+typedef bool (*TxQueueTransmitFunc)(ProtocolType link, const uint8_t* frame, uint16_t length);
+
+// 发送队列配置
+typedef struct {
+    // 低优先级调度权重：PRIORITY_HIGH总是严格优先；
+    // PRIORITY_MEDIUM和PRIORITY_LOW的权重都为0时也按严格优先级发送，
+    // 否则两者按权重轮转，低优先级在中优先级持续繁忙时不会饿死
+    uint8_t weights[PRIORITY_MAX];
+    // 各优先级最多排队的数据包数，0表示TX_QUEUE_CAPACITY
+    // 限制低优先级的排队深度，避免低优先级突发占满缓冲池导致高优先级申请不到缓冲区
+    uint16_t queue_limits[PRIORITY_MAX];
+    int worker_priority;               // 工作线程SCHED_FIFO优先级1-99，0保持默认调度策略
+    TxQueueTransmitFunc transmit;      // 帧发送函数，NULL时使用ProtocolStack_SendLinkFrame
+} TxQueueConfig_t;
+
+// 一条链路上单个优先级的发送统计，延迟单位为纳秒
+typedef struct {
+    uint32_t enqueued;            // 入队数据包数
+    uint32_t sent;                // 发送成功数
+    uint32_t send_errors;         // 发送失败数
+    uint32_t dropped;             // 队列满被丢弃的数据包数
+    uint16_t depth;               // 当前排队数
+    uint16_t max_depth;           // 排队数历史最大值
+    uint32_t delay_count;         // 延迟样本数
+    uint32_t delay_min;           // 从入队到开始发送的最小延迟
+    uint32_t delay_mean;
+    uint32_t delay_max;
+    uint32_t delay_p99;           // 99%分位，直方图格的上沿，不超过delay_max
+    uint32_t delay_p999;          // 99.9%分位
+} TxQueueStats_t;
+
+// 获取默认配置：严格优先级，中/低优先级各最多排队16个，使用ProtocolStack_SendLinkFrame
+void TxQueue_GetDefaultConfig(TxQueueConfig_t* config);
+
+// 初始化所有链路的发送队列并启用：之后ProtocolStack_SendBuffer只编码并入队，由TxQueue_Process或工作线程发送
+// config为NULL时使用默认配置
+bool TxQueue_Init(const TxQueueConfig_t* config);
+
+// 发送队列是否已启用
+bool TxQueue_IsEnabled(void);
+
+// 按缓冲区头部的优先级入队到链路，帧必须已编码；可在任意线程调用，无锁
+// 无论成功与否缓冲区所有权都交给发送队列，发送后或入队失败时释放
+bool TxQueue_Enqueue(ProtocolType link, PacketBuffer_t* buffer);
+
+// 在调用线程中按调度顺序发送链路上最多max_packets个数据包，返回发送的数据包数
+// 负数表示发送全部，并让出CPU等待已占位、生产者尚未写完的数据包，只应在非实时线程中使用（如关闭链路时）
+// 单消费者：该链路的工作线程运行时不能调用
+int TxQueue_Process(ProtocolType link, int max_packets);
+
+// 启动链路的工作线程：队列为空时阻塞等待，每次唤醒后按调度顺序发送所有已发布的数据包；
+// 生产者写完数据包后唤醒工作线程，工作线程不等待写到一半的槽
+bool TxQueue_StartWorker(ProtocolType link);
+
+// 停止链路的工作线程，未发送的数据包留在队列中
+void TxQueue_StopWorker(ProtocolType link);
+
+// 停用发送队列，等待正在进行的入队完成，再停止所有工作线程并发送剩余数据包；
+// 可与其他线程中的TxQueue_Enqueue并发调用，停用后的入队被拒绝并释放缓冲区
+void TxQueue_Shutdown(void);
+
+// 获取链路上某个优先级的发送统计
+bool TxQueue_GetStats(ProtocolType link, PriorityLevel priority, TxQueueStats_t* stats);
+
+// 清零发送统计
+void TxQueue_ResetStats(void);
+
+#endif // TX_QUEUE_H
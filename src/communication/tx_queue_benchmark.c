@@ -0,0 +1,243 @@
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "packet_pool.h"
+#include "tx_queue.h"
+
+// 发送队列基准测试：100Mbit/s链路上，1kHz高优先级关节数据与中优先级系统状态、
+// 持续满载的低优先级自定义数据同时发送时，各类数据从生成到开始发送的延迟
+// 对比单一FIFO队列、严格优先级、加权轮转三种调度，以及低优先级数据走另一条链路（各链路一个工作线程）
+// 用法：tx_queue_benchmark [每种调度的测试时间(秒)]
+// 优先级调度下高优先级p99.9超出目标（communication_protocol.md §8.1）时返回1
+
+#define LINK_NS_PER_BYTE 80              // 100Mbit/s
+#define HISTOGRAM_BINS 20000             // 1us一格，最高20ms
+#define CLASS_COUNT PRIORITY_MAX
+#define CONTROL_LINK PROTOCOL_ETHERCAT   // 关节数据和系统状态
+#define BULK_LINK PROTOCOL_USB           // per-link场景中的低优先级数据
+#define HIGH_P999_TARGET_US 1000.0       // 高优先级排队延迟目标
+
+// 每类数据的延迟统计，只由发送函数（工作线程）写入
+typedef struct {
+    uint32_t bins[HISTOGRAM_BINS + 1];
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+} LatencyStats_t;
+
+static LatencyStats_t g_latency[CLASS_COUNT];
+static atomic_uint g_dropped[CLASS_COUNT];
+static atomic_bool g_running;
+static bool g_fifo = false;              // 所有数据都按低优先级排队
+static bool g_split_links = false;       // 低优先级数据走BULK_LINK
+
+// 获取单调时钟时间 (单位: ns)
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void sleep_ns(uint64_t ns)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ns / 1000000000ull);
+    ts.tv_nsec = (long)(ns % 1000000000ull);
+    nanosleep(&ts, NULL);
+}
+
+// 模拟链路：记录延迟后按帧长占用链路，每条链路由各自的工作线程调用
+static bool link_transmit(ProtocolType link, const uint8_t* frame, uint16_t length)
+{
+    (void)link;
+    const uint8_t* payload = frame + PACKET_WIRE_HEADER_SIZE;
+    uint64_t created;
+    memcpy(&created, payload, sizeof(created));
+    LatencyStats_t* stats = &g_latency[payload[sizeof(created)]];
+
+    uint64_t latency = monotonic_ns() - created;
+    uint64_t bin = latency / 1000;
+    stats->bins[bin < HISTOGRAM_BINS ? bin : HISTOGRAM_BINS]++;
+    stats->count++;
+    stats->sum += latency;
+    if (latency > stats->max)
+    {
+        stats->max = latency;
+    }
+
+    sleep_ns((uint64_t)length * LINK_NS_PER_BYTE);
+    return true;
+}
+
+// 生成并入队一个数据包，有效载荷开头为生成时刻和数据类别
+static bool send_packet(PriorityLevel data_class, uint16_t payload_length)
+{
+    PacketBuffer_t* buffer = PacketPool_Acquire();
+    if (buffer == NULL)
+    {
+        atomic_fetch_add_explicit(&g_dropped[data_class], 1, memory_order_relaxed);
+        return false;
+    }
+
+    uint8_t* payload = PacketPool_Payload(buffer);
+    uint64_t created = monotonic_ns();
+    memcpy(payload, &created, sizeof(created));
+    payload[sizeof(created)] = (uint8_t)data_class;
+
+    PriorityLevel priority = g_fifo ? PRIORITY_LOW : data_class;
+    ProtocolType link = (g_split_links && data_class == PRIORITY_LOW) ? BULK_LINK : CONTROL_LINK;
+    buffer->header = (PacketHeader_t){ link, DATA_TYPE_REAL_TIME, priority, 0, 0, 1, 2, payload_length };
+    buffer->frame_length = PacketCodec_EncodeHeader(&buffer->header, buffer->frame, sizeof(buffer->frame));
+    if (!TxQueue_Enqueue(link, buffer))
+    {
+        atomic_fetch_add_explicit(&g_dropped[data_class], 1, memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+// 周期生产者：高优先级1kHz关节数据，中优先级100Hz系统状态
+static void* periodic_producer(void* arg)
+{
+    PriorityLevel data_class = (PriorityLevel)(long)arg;
+    uint64_t period = (data_class == PRIORITY_HIGH) ? 1000000 : 10000000;
+    uint16_t payload_length = (data_class == PRIORITY_HIGH) ? 18 : 200;
+
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while (atomic_load_explicit(&g_running, memory_order_relaxed))
+    {
+        send_packet(data_class, payload_length);
+
+        next.tv_nsec += (long)period;
+        while (next.tv_nsec >= 1000000000L)
+        {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+    }
+    return NULL;
+}
+
+// 满载生产者：持续发送最大长度的低优先级数据，队列满时稍后重试
+static void* bulk_producer(void* arg)
+{
+    (void)arg;
+    while (atomic_load_explicit(&g_running, memory_order_relaxed))
+    {
+        if (!send_packet(PRIORITY_LOW, MAX_PAYLOAD_SIZE))
+        {
+            sleep_ns(100000);
+        }
+    }
+    return NULL;
+}
+
+// 第rank个样本所在直方图格的上沿 (单位: us)
+static double percentile_us(const LatencyStats_t* stats, double p)
+{
+    uint64_t rank = (uint64_t)(stats->count * p + 0.5);
+    uint64_t seen = 0;
+    for (int i = 0; i <= HISTOGRAM_BINS; i++)
+    {
+        seen += stats->bins[i];
+        if (seen >= rank && seen > 0)
+        {
+            double upper = (i + 1) * 1.0;
+            return (i < HISTOGRAM_BINS && upper < stats->max * 1e-3) ? upper : stats->max * 1e-3;
+        }
+    }
+    return 0.0;
+}
+
+// 运行一种调度，返回高优先级p99.9 (单位: us)，启动失败时返回负数
+static double run_scenario(const char* name, bool fifo, bool split_links, uint8_t medium_weight, uint8_t low_weight,
+                         double seconds)
+{
+    memset(g_latency, 0, sizeof(g_latency));
+    for (int c = 0; c < CLASS_COUNT; c++)
+    {
+        atomic_store(&g_dropped[c], 0);
+    }
+    g_fifo = fifo;
+    g_split_links = split_links;
+
+    TxQueueConfig_t config;
+    TxQueue_GetDefaultConfig(&config);
+    config.weights[PRIORITY_MEDIUM] = medium_weight;
+    config.weights[PRIORITY_LOW] = low_weight;
+    config.worker_priority = 80;
+    config.transmit = link_transmit;
+    if (fifo)
+    {
+        config.queue_limits[PRIORITY_LOW] = TX_QUEUE_CAPACITY;
+    }
+    PacketPool_Init();
+    if (!TxQueue_Init(&config) || !TxQueue_StartWorker(CONTROL_LINK) ||
+        (split_links && !TxQueue_StartWorker(BULK_LINK)))
+    {
+        printf("%-10s failed to start\n", name);
+        return -1.0;
+    }
+
+    pthread_t producers[3];
+    atomic_store(&g_running, true);
+    pthread_create(&producers[0], NULL, periodic_producer, (void*)(long)PRIORITY_HIGH);
+    pthread_create(&producers[1], NULL, periodic_producer, (void*)(long)PRIORITY_MEDIUM);
+    pthread_create(&producers[2], NULL, bulk_producer, NULL);
+    sleep_ns((uint64_t)(seconds * 1e9));
+    atomic_store(&g_running, false);
+    for (int i = 0; i < 3; i++)
+    {
+        pthread_join(producers[i], NULL);
+    }
+    TxQueue_Shutdown();
+
+    const char* class_names[CLASS_COUNT] = {"high", "medium", "low"};
+    for (int c = 0; c < CLASS_COUNT; c++)
+    {
+        const LatencyStats_t* stats = &g_latency[c];
+        printf("%-10s %-7s %8llu %8u %10.1f %10.1f %10.1f %10.1f\n", name, class_names[c],
+               (unsigned long long)stats->count, atomic_load(&g_dropped[c]),
+               stats->count ? stats->sum * 1e-3 / stats->count : 0.0,
+               percentile_us(stats, 0.99), percentile_us(stats, 0.999), stats->max * 1e-3);
+    }
+    return percentile_us(&g_latency[PRIORITY_HIGH], 0.999);
+}
+
+int main(int argc, char* argv[])
+{
+    double seconds = (argc > 1) ? atof(argv[1]) : 2.0;
+    if (seconds <= 0.0)
+    {
+        printf("Usage: %s [seconds per scheduler]\n", argv[0]);
+        return 1;
+    }
+
+    printf("Queueing delay [us] on a simulated 100 Mbit/s link, high-priority target: p99.9 < 1000 us\n");
+    printf("%-10s %-7s %8s %8s %10s %10s %10s %10s\n", "scheduler", "class", "sent", "dropped",
+           "mean", "p99", "p99.9", "max");
+    // FIFO只作对比，不要求达到目标
+    run_scenario("fifo", true, false, 0, 0, seconds);
+    double high_p999[3];
+    high_p999[0] = run_scenario("strict", false, false, 0, 0, seconds);
+    high_p999[1] = run_scenario("weighted", false, false, 3, 1, seconds);
+    high_p999[2] = run_scenario("per-link", false, true, 0, 0, seconds);
+
+    int result = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        if (high_p999[i] < 0.0 || high_p999[i] >= HIGH_P999_TARGET_US)
+        {
+            result = 1;
+        }
+    }
+    printf("High-priority p99.9 target %s\n", (result == 0) ? "met" : "MISSED");
+    return result;
+}
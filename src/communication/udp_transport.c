@@ -0,0 +1,190 @@
+#define _DEFAULT_SOURCE
+#include "udp_transport.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// 接收缓冲区大小，容纳突发的数据报
+#define UDP_RECEIVE_BUFFER_SIZE (1 << 20)
+
+// 全局变量定义
+static UdpTransportConfig_t g_config;
+static bool g_configured = false;
+static int g_receive_socket = -1;
+static int g_send_socket = -1;
+static struct sockaddr_in g_group_address;
+static struct sockaddr_in g_local_address;   // 发送套接字的本地地址，用于识别本节点发送的帧
+
+// 获取默认配置
+void UdpTransport_GetDefaultConfig(UdpTransportConfig_t* config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    memset(config, 0, sizeof(*config));
+    strcpy(config->group, "239.255.42.1");
+    config->port = 30490;
+    strcpy(config->interface_address, "127.0.0.1");
+    config->ttl = 0;
+    config->receive_timeout_ms = 0;
+    config->receive_own = false;
+}
+
+// 设置配置
+bool UdpTransport_Configure(const UdpTransportConfig_t* config)
+{
+    if (config == NULL)
+    {
+        return false;
+    }
+
+    struct in_addr address;
+    if (inet_pton(AF_INET, config->group, &address) != 1 || !IN_MULTICAST(ntohl(address.s_addr)) ||
+        inet_pton(AF_INET, config->interface_address, &address) != 1)
+    {
+        printf("Invalid UDP transport address: group %.16s, interface %.16s\n",
+               config->group, config->interface_address);
+        return false;
+    }
+
+    g_config = *config;
+    g_configured = true;
+    return true;
+}
+
+// 打开套接字
+bool UdpTransport_Open(void)
+{
+    if (!g_configured)
+    {
+        UdpTransport_GetDefaultConfig(&g_config);
+        g_configured = true;
+    }
+    UdpTransport_Close();
+
+    struct in_addr interface_address;
+    memset(&g_group_address, 0, sizeof(g_group_address));
+    g_group_address.sin_family = AF_INET;
+    g_group_address.sin_port = htons(g_config.port);
+    inet_pton(AF_INET, g_config.group, &g_group_address.sin_addr);
+    inet_pton(AF_INET, g_config.interface_address, &interface_address);
+
+    // 接收套接字：多个节点绑定同一个组播端口
+    g_receive_socket = socket(AF_INET, SOCK_DGRAM, 0);
+    int enable = 1;
+    int receive_buffer = UDP_RECEIVE_BUFFER_SIZE;
+    struct ip_mreq membership;
+    membership.imr_multiaddr = g_group_address.sin_addr;
+    membership.imr_interface = interface_address;
+    if (g_receive_socket < 0 ||
+        setsockopt(g_receive_socket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) != 0 ||
+        bind(g_receive_socket, (const struct sockaddr*)&g_group_address, sizeof(g_group_address)) != 0 ||
+        setsockopt(g_receive_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0)
+    {
+        printf("Cannot open UDP transport: Receive socket setup failed: %s\n", strerror(errno));
+        UdpTransport_Close();
+        return false;
+    }
+    setsockopt(g_receive_socket, SOL_SOCKET, SO_RCVBUF, &receive_buffer, sizeof(receive_buffer));
+
+    // 发送套接字：绑定到接口的临时端口，接收时据此过滤本节点发送的帧
+    g_send_socket = socket(AF_INET, SOCK_DGRAM, 0);
+    unsigned char ttl = g_config.ttl;
+    unsigned char loop = 1;
+    memset(&g_local_address, 0, sizeof(g_local_address));
+    g_local_address.sin_family = AF_INET;
+    g_local_address.sin_addr = interface_address;
+    socklen_t address_length = sizeof(g_local_address);
+    if (g_send_socket < 0 ||
+        bind(g_send_socket, (const struct sockaddr*)&g_local_address, sizeof(g_local_address)) != 0 ||
+        getsockname(g_send_socket, (struct sockaddr*)&g_local_address, &address_length) != 0 ||
+        setsockopt(g_send_socket, IPPROTO_IP, IP_MULTICAST_IF, &interface_address, sizeof(interface_address)) != 0 ||
+        setsockopt(g_send_socket, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) != 0 ||
+        setsockopt(g_send_socket, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) != 0)
+    {
+        printf("Cannot open UDP transport: Send socket setup failed: %s\n", strerror(errno));
+        UdpTransport_Close();
+        return false;
+    }
+
+    return true;
+}
+
+// 发送一帧
+bool UdpTransport_Send(const uint8_t* frame, uint16_t length)
+{
+    if (g_send_socket < 0 || frame == NULL)
+    {
+        return false;
+    }
+
+    ssize_t sent = sendto(g_send_socket, frame, length, 0,
+                          (const struct sockaddr*)&g_group_address, sizeof(g_group_address));
+    return sent == (ssize_t)length;
+}
+
+// 接收一帧
+bool UdpTransport_Receive(uint8_t* buffer, uint16_t buffer_size, uint16_t* length)
+{
+    if (g_receive_socket < 0 || buffer == NULL || length == NULL)
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        struct pollfd descriptor;
+        descriptor.fd = g_receive_socket;
+        descriptor.events = POLLIN;
+        descriptor.revents = 0;
+        int ready = poll(&descriptor, 1, g_config.receive_timeout_ms);
+        if (ready <= 0)
+        {
+            // 超时，或被信号中断按超时处理
+            return false;
+        }
+
+        struct sockaddr_in sender;
+        socklen_t sender_length = sizeof(sender);
+        ssize_t received = recvfrom(g_receive_socket, buffer, buffer_size, MSG_DONTWAIT | MSG_TRUNC,
+                                    (struct sockaddr*)&sender, &sender_length);
+        if (received < 0)
+        {
+            return false;
+        }
+
+        // 过滤本节点发送的帧和超长的数据报，继续等待下一个
+        bool own = (sender.sin_port == g_local_address.sin_port) &&
+                   (sender.sin_addr.s_addr == g_local_address.sin_addr.s_addr);
+        if ((own && !g_config.receive_own) || received > buffer_size)
+        {
+            continue;
+        }
+
+        *length = (uint16_t)received;
+        return true;
+    }
+}
+
+// 关闭套接字
+void UdpTransport_Close(void)
+{
+    if (g_receive_socket >= 0)
+    {
+        close(g_receive_socket);
+        g_receive_socket = -1;
+    }
+
+    if (g_send_socket >= 0)
+    {
+        close(g_send_socket);
+        g_send_socket = -1;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef UDP_TRANSPORT_H
+#define UDP_TRANSPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// UDP组播传输：每帧一个数据报发往组播组，组内所有节点都能收到，模拟多节点总线
+// 默认只在本机（127.0.0.1，TTL 0）通信，多个进程各自初始化协议栈即可组成一条总线
+
+// UDP传输配置
+typedef struct {
+    char group[16];                // 组播地址
+    uint16_t port;                 // 组播端口
+    char interface_address[16];    // 发送和加入组播使用的本机接口地址
+    uint8_t ttl;                   // 组播TTL，0表示不离开本机
+    int receive_timeout_ms;        // 接收等待时间 (单位: ms)，0表示不等待，负数表示一直等待
+    bool receive_own;              // 是否接收本节点发送的帧，单节点测试时使用
+} UdpTransportConfig_t;
+
+// 获取默认配置：239.255.42.1:30490，127.0.0.1，TTL 0，不等待，不接收本节点发送的帧
+void UdpTransport_GetDefaultConfig(UdpTransportConfig_t* config);
+
+// 设置配置，在ProtocolStack_Init之前调用；未设置时使用默认配置
+bool UdpTransport_Configure(const UdpTransportConfig_t* config);
+
+// 打开套接字并加入组播组
+bool UdpTransport_Open(void);
+
+// 发送一帧
+bool UdpTransport_Send(const uint8_t* frame, uint16_t length);
+
+// 接收一帧，length返回帧长度；超时或没有帧时返回false
+// 超过buffer_size的数据报被丢弃
+bool UdpTransport_Receive(uint8_t* buffer, uint16_t buffer_size, uint16_t* length);
+
+// 关闭套接字
+void UdpTransport_Close(void);
+
+#endif // UDP_TRANSPORT_H
@@ -0,0 +1,215 @@
+// Controller microbenchmark - per-call compute() latency distribution
+//
+// Every compute() call is timed individually with the time stamp counter
+// (steady_clock on non-x86 targets) and reported as min/p50/p99/max in
+// cycles and nanoseconds. The warm variant calls back to back; the cold
+// variant evicts the caches by streaming a buffer larger than the last level
+// cache before each timed call. Results are CSV on stdout and, when a path is
+// given as the first argument, also written to that file.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "pid_controller.hpp"
+#include "system_models.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define BENCH_HAVE_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+#else
+#define BENCH_HAVE_TSC 0
+#endif
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Keep the optimizer from discarding benchmark results
+volatile double g_sink = 0.0;
+
+// Read the cycle counter. lfence keeps the timed code from being reordered
+// around the read.
+inline std::uint64_t read_cycles()
+{
+#if BENCH_HAVE_TSC
+    _mm_lfence();
+    std::uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+#else
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Counter ticks per nanosecond, measured against steady_clock
+double calibrate_ticks_per_ns()
+{
+#if BENCH_HAVE_TSC
+    Clock::time_point start = Clock::now();
+    std::uint64_t c0 = read_cycles();
+    while (Clock::now() - start < std::chrono::milliseconds(100)) {
+    }
+    std::uint64_t c1 = read_cycles();
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return static_cast<double>(c1 - c0) / ns;
+#else
+    return 1.0;
+#endif
+}
+
+// Cost of an empty timed region, subtracted from every sample
+std::uint64_t measure_overhead()
+{
+    std::uint64_t best = UINT64_MAX;
+    for (int i = 0; i < 10000; ++i) {
+        std::uint64_t t0 = read_cycles();
+        std::uint64_t t1 = read_cycles();
+        best = std::min(best, t1 - t0);
+    }
+    return best;
+}
+
+// Stream through a buffer larger than the last level cache
+void evict_caches(std::vector<char>& buffer)
+{
+    char acc = 0;
+    for (std::size_t i = 0; i < buffer.size(); i += 64) {
+        buffer[i] = static_cast<char>(buffer[i] + 1);
+        acc = static_cast<char>(acc ^ buffer[i]);
+    }
+    g_sink = g_sink + acc;
+}
+
+struct Stats {
+    std::uint64_t min;
+    std::uint64_t p50;
+    std::uint64_t p99;
+    std::uint64_t max;
+};
+
+Stats summarize(std::vector<std::uint64_t>& samples)
+{
+    std::sort(samples.begin(), samples.end());
+    Stats stats;
+    stats.min = samples.front();
+    stats.p50 = samples[samples.size() / 2];
+    stats.p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    stats.max = samples.back();
+    return stats;
+}
+
+// Process value trajectory of a first-order plant under PID control, so
+// inputs exercise realistic error and error-rate ranges
+std::vector<double> make_trajectory(int steps, double dt)
+{
+    FirstOrderSystem plant(0.5, 1.0, dt);
+    PIDController pid(2.0, 1.0, 0.05, dt);
+    std::vector<double> trajectory(steps);
+    double process_val = 0.0;
+    for (int i = 0; i < steps; ++i) {
+        double setpoint = (i / 500) % 2 == 0 ? 1.0 : -1.0;
+        process_val = plant.compute(pid.compute(setpoint, process_val));
+        trajectory[i] = process_val;
+    }
+    return trajectory;
+}
+
+struct Case {
+    std::string name;
+    std::unique_ptr<Controller> controller;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const double dt = 0.01;
+    const int warm_samples = 200000;
+    const int cold_samples = 500;
+    const std::size_t eviction_bytes = 64u << 20;
+
+    std::vector<Case> cases;
+    cases.resize(5);
+    cases[0].name = "pid";
+    cases[0].controller.reset(new PIDController(2.0, 1.0, 0.05, dt));
+    cases[1].name = "incremental_pid";
+    cases[1].controller.reset(new IncrementalPIDController(2.0, 1.0, 0.05, dt));
+    cases[2].name = "fuzzy_pid";
+    cases[2].controller.reset(new FuzzyPIDController(2.0, 1.0, 0.05, dt));
+    cases[3].name = "fuzzy_pid_smooth";
+    cases[3].controller.reset(new FuzzyPIDController(2.0, 1.0, 0.05, dt, FuzzyPIDController::SMOOTH));
+    cases[4].name = "adaptive_pid";
+    cases[4].controller.reset(new AdaptivePIDController(2.0, 1.0, 0.05, dt, 0.01));
+
+    const double ticks_per_ns = calibrate_ticks_per_ns();
+    const std::uint64_t overhead = measure_overhead();
+    const std::vector<double> trajectory = make_trajectory(warm_samples, dt);
+    std::vector<char> eviction_buffer(eviction_bytes, 1);
+
+    FILE* out = nullptr;
+    if (argc > 1) {
+        out = fopen(argv[1], "w");
+        if (out == nullptr) {
+            fprintf(stderr, "Failed to open file: %s\n", argv[1]);
+            return 1;
+        }
+    }
+
+    char line[256];
+    snprintf(line, sizeof(line), "controller,cache,samples,timer,ticks_per_ns,"
+             "min_cycles,p50_cycles,p99_cycles,max_cycles,min_ns,p50_ns,p99_ns,max_ns\n");
+    fputs(line, stdout);
+    if (out) fputs(line, out);
+
+    std::vector<std::uint64_t> samples;
+    for (std::size_t c = 0; c < cases.size(); ++c) {
+        Controller& controller = *cases[c].controller;
+
+        for (int cold = 0; cold < 2; ++cold) {
+            int count = cold ? cold_samples : warm_samples;
+            samples.assign(count, 0);
+            controller.reset();
+
+            // Warm-up pass so the warm variant starts with hot code and data
+            for (int i = 0; i < 1000 && !cold; ++i) {
+                g_sink = g_sink + controller.compute(1.0, trajectory[i]);
+            }
+
+            for (int i = 0; i < count; ++i) {
+                double setpoint = (i / 500) % 2 == 0 ? 1.0 : -1.0;
+                double process_val = trajectory[i % trajectory.size()];
+                if (cold) {
+                    evict_caches(eviction_buffer);
+                }
+                std::uint64_t t0 = read_cycles();
+                double u = controller.compute(setpoint, process_val);
+                std::uint64_t t1 = read_cycles();
+                g_sink = g_sink + u;
+                std::uint64_t elapsed = t1 - t0;
+                samples[i] = elapsed > overhead ? elapsed - overhead : 0;
+            }
+
+            Stats stats = summarize(samples);
+            snprintf(line, sizeof(line), "%s,%s,%d,%s,%.4f,%llu,%llu,%llu,%llu,%.1f,%.1f,%.1f,%.1f\n",
+                     cases[c].name.c_str(), cold ? "cold" : "warm", count,
+                     BENCH_HAVE_TSC ? "tsc" : "steady_clock", ticks_per_ns,
+                     static_cast<unsigned long long>(stats.min), static_cast<unsigned long long>(stats.p50),
+                     static_cast<unsigned long long>(stats.p99), static_cast<unsigned long long>(stats.max),
+                     stats.min / ticks_per_ns, stats.p50 / ticks_per_ns,
+                     stats.p99 / ticks_per_ns, stats.max / ticks_per_ns);
+            fputs(line, stdout);
+            if (out) fputs(line, out);
+        }
+    }
+
+    if (out) {
+        fclose(out);
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Fuzzy PID benchmark - crisp rule lookup versus precomputed Gaussian surface
+#include <chrono>
+#include <cstdio>
+#include "pid_controller.hpp"
+#include "fuzzy_surface.hpp"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Keep the optimizer from discarding benchmark results
+volatile double g_sink = 0.0;
+
+// Closed loop on a first-order plant with uniform measurement noise, so e and
+// ec sweep realistic values and the crisp interval branches see real data
+double ns_per_compute(FuzzyPIDController& controller, int steps, double dt, double noise_amplitude)
+{
+    double process_val = 0.0;
+    double output = 0.0;
+    unsigned int lcg = 12345u;
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < steps; ++i) {
+        lcg = lcg * 1664525u + 1013904223u;
+        double noise = noise_amplitude * (static_cast<double>(lcg >> 8) / 8388608.0 - 1.0);
+        double setpoint = (i / 2000) % 2 == 0 ? 1.0 : -1.0;
+        output = controller.compute(setpoint, process_val + noise);
+        process_val += dt * (output - process_val);
+    }
+    Clock::time_point stop = Clock::now();
+
+    g_sink = g_sink + output;
+    return std::chrono::duration<double, std::nano>(stop - start).count() / steps;
+}
+
+// Direct Gaussian Mamdani inference per call - the naive port of fuzzy_inference.m
+double ns_per_direct_inference(int steps)
+{
+    static const int rules[7][7] = {
+        {3, 3, 2, 2, 2, 1, 0}, {3, 3, 2, 2, 1, 1, -1}, {2, 2, 2, 1, 0, -1, -2},
+        {2, 1, 0, -1, -1, -2, -2}, {1, 1, 0, -1, -2, -2, -2}, {1, 0, -1, -2, -2, -3, -3},
+        {0, 0, -1, -2, -3, -3, -3}
+    };
+    double acc = 0.0;
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < steps; ++i) {
+        double e = ((i % 601) - 300) * 0.01;
+        double ec = ((i % 397) - 198) * 0.015;
+        double dkp, dki, dkd;
+        FuzzySurface::infer(rules, rules, rules, e, ec, 1.0, dkp, dki, dkd);
+        acc += dkp + dki + dkd;
+    }
+    Clock::time_point stop = Clock::now();
+
+    g_sink = g_sink + acc;
+    return std::chrono::duration<double, std::nano>(stop - start).count() / steps;
+}
+
+} // namespace
+
+int main() {
+    const double dt = 0.01;
+    const int steps = 2000000;
+
+    Clock::time_point build_start = Clock::now();
+    FuzzyPIDController smooth(2.0, 1.0, 0.1, dt, FuzzyPIDController::SMOOTH);
+    Clock::time_point build_stop = Clock::now();
+    FuzzyPIDController crisp(2.0, 1.0, 0.1, dt, FuzzyPIDController::CRISP);
+
+    double build_us = std::chrono::duration<double, std::micro>(build_stop - build_start).count();
+    double direct_ns = ns_per_direct_inference(steps / 20);
+
+    printf("mode,noise,ns_per_compute\n");
+    const double noise_levels[] = {0.0, 0.001, 0.01};
+    for (int n = 0; n < 3; ++n) {
+        crisp.reset();
+        smooth.reset();
+        printf("crisp,%g,%.3f\n", noise_levels[n], ns_per_compute(crisp, steps, dt, noise_levels[n]));
+        printf("smooth_surface,%g,%.3f\n", noise_levels[n], ns_per_compute(smooth, steps, dt, noise_levels[n]));
+    }
+    printf("gaussian_direct_inference_only,-,%.3f\n", direct_ns);
+    printf("surface_build_us,-,%.1f\n", build_us);
+    return 0;
+}
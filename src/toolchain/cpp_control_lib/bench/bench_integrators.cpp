@@ -0,0 +1,121 @@
+// Plant integrator benchmark - accuracy against cost of Euler, RK4 and RKF45
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include "system_models.hpp"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Keep the optimizer from discarding benchmark results
+volatile double g_sink = 0.0;
+
+const double kSimulationTime = 20.0;
+
+// Underdamped second-order plant and its exact unit step response
+const double kGain = 1.0;
+const double kZeta = 0.3;
+const double kOmega = 2.0;
+
+double exact_second_order(double t)
+{
+    double root = std::sqrt(1.0 - kZeta * kZeta);
+    double wd = kOmega * root;
+    return kGain * (1.0 - std::exp(-kZeta * kOmega * t) * (std::cos(wd * t) + kZeta / root * std::sin(wd * t)));
+}
+
+// First-order plant and its exact unit step response
+const double kTimeConstant = 0.5;
+
+double exact_first_order(double t)
+{
+    return kGain * (1.0 - std::exp(-t / kTimeConstant));
+}
+
+struct Result {
+    double max_error;
+    std::size_t evaluations;
+    double us;
+};
+
+// Unit step response over kSimulationTime, compared with the exact solution at every sample
+Result run(SystemModel& plant, double (*exact)(double), double dt)
+{
+    int steps = static_cast<int>(std::lround(kSimulationTime / dt));
+    Result result;
+    result.max_error = 0.0;
+    std::size_t evaluations_before = plant.integration_stats().evaluations;
+
+    Clock::time_point start = Clock::now();
+    double y = 0.0;
+    for (int i = 1; i <= steps; ++i) {
+        y = plant.compute(1.0);
+        result.max_error = std::fmax(result.max_error, std::fabs(y - exact(i * dt)));
+    }
+    result.us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    result.evaluations = plant.integration_stats().evaluations - evaluations_before;
+    if (plant.get_integration() == INTEGRATION_EULER) {
+        result.evaluations = steps;     // One derivative per Euler step, computed inline
+    }
+    g_sink = g_sink + y;
+    return result;
+}
+
+std::unique_ptr<SystemModel> make_plant(bool second_order, double dt)
+{
+    if (second_order) {
+        return std::unique_ptr<SystemModel>(new SecondOrderSystem(kGain, kZeta, kOmega, dt));
+    }
+    return std::unique_ptr<SystemModel>(new FirstOrderSystem(kTimeConstant, kGain, dt));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    FILE* out = nullptr;
+    if (argc > 1) {
+        out = fopen(argv[1], "w");
+        if (out == nullptr) {
+            fprintf(stderr, "Failed to open file: %s\n", argv[1]);
+            return 1;
+        }
+    }
+
+    char line[256];
+    snprintf(line, sizeof(line), "plant,method,dt,tolerance,max_error,evaluations,us\n");
+    fputs(line, stdout);
+    if (out) fputs(line, out);
+
+    const double steps[] = {0.2, 0.1, 0.05, 0.02, 0.01, 0.005, 0.002, 0.001};
+    const double tolerances[] = {1e-3, 1e-4, 1e-5, 1e-6, 1e-7, 1e-8, 1e-9, 1e-10};
+    const char* methods[] = {"euler", "rk4", "rkf45"};
+
+    for (int p = 0; p < 2; ++p) {
+        bool second_order = p == 0;
+        const char* plant_name = second_order ? "second_order" : "first_order";
+        double (*exact)(double) = second_order ? exact_second_order : exact_first_order;
+
+        for (int m = 0; m < 3; ++m) {
+            for (int k = 0; k < 8; ++k) {
+                // Fixed-step methods sweep dt; RKF45 keeps a 0.1 s sample period and sweeps its tolerance
+                double dt = m == 2 ? 0.1 : steps[k];
+                double tolerance = m == 2 ? tolerances[k] : 0.0;
+                std::unique_ptr<SystemModel> plant = make_plant(second_order, dt);
+                if (m == 1) plant->set_integration(INTEGRATION_RK4);
+                if (m == 2) plant->set_integration(INTEGRATION_RKF45, tolerance);
+
+                Result r = run(*plant, exact, dt);
+                snprintf(line, sizeof(line), "%s,%s,%g,%g,%.3e,%zu,%.1f\n", plant_name, methods[m], dt,
+                         tolerance, r.max_error, r.evaluations, r.us);
+                fputs(line, stdout);
+                if (out) fputs(line, out);
+            }
+        }
+    }
+
+    if (out) fclose(out);
+    return 0;
+}
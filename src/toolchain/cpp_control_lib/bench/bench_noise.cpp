@@ -0,0 +1,90 @@
+// Noise benchmark - rand() Box-Muller versus std::mt19937 versus NoiseStream
+#define _USE_MATH_DEFINES  // Enable math constants like M_PI
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "noise_generator.hpp"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Keep the optimizer from discarding benchmark results
+volatile double g_sink = 0.0;
+
+template <typename Fn>
+double ns_per_sample(std::vector<double>& out, Fn fill)
+{
+    Clock::time_point start = Clock::now();
+    fill(out.data(), out.size());
+    Clock::time_point stop = Clock::now();
+    g_sink = g_sink + out[out.size() / 2];
+    return std::chrono::duration<double, std::nano>(stop - start).count() / out.size();
+}
+
+// The previous NoiseGenerator: Box-Muller on the global rand() state
+double rand_gaussian()
+{
+    static bool has_spare = false;
+    static double z1;
+    if (has_spare) {
+        has_spare = false;
+        return 0.05 * z1;
+    }
+    has_spare = true;
+    double u1 = static_cast<double>(rand()) / RAND_MAX;
+    double u2 = static_cast<double>(rand()) / RAND_MAX;
+    double z0 = sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+    z1 = sqrt(-2.0 * log(u1)) * sin(2.0 * M_PI * u2);
+    return 0.05 * z0;
+}
+
+double rand_impulse()
+{
+    if (static_cast<double>(rand()) / RAND_MAX < 0.02) {
+        return (static_cast<double>(rand()) / RAND_MAX - 0.5) * 2.0 * 0.2;
+    }
+    return 0.0;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t samples = 4000000;
+    std::vector<double> out(samples);
+
+    srand(1);
+    double legacy_gaussian = ns_per_sample(out, [](double* p, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) p[i] = rand_gaussian();
+    });
+    double legacy_combined = ns_per_sample(out, [](double* p, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) p[i] = rand_gaussian() + rand_impulse();
+    });
+
+    std::mt19937_64 mt(1);
+    std::normal_distribution<double> normal(0.0, 0.05);
+    double std_gaussian = ns_per_sample(out, [&](double* p, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) p[i] = normal(mt);
+    });
+
+    NoiseStream stream(NoiseConfig(0.0, 0.05, 0.2, 0.02), 1);
+    double scalar_gaussian = ns_per_sample(out, [&](double* p, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) p[i] = stream.gaussian();
+    });
+    double batch_gaussian = ns_per_sample(out, [&](double* p, std::size_t n) { stream.fillGaussian(p, n); });
+    double batch_impulse = ns_per_sample(out, [&](double* p, std::size_t n) { stream.fillImpulse(p, n); });
+    double batch_combined = ns_per_sample(out, [&](double* p, std::size_t n) { stream.fillCombined(p, n); });
+
+    printf("generator,noise,ns_per_sample\n");
+    printf("rand_box_muller,gaussian,%.2f\n", legacy_gaussian);
+    printf("rand_box_muller,combined,%.2f\n", legacy_combined);
+    printf("mt19937_64_normal_distribution,gaussian,%.2f\n", std_gaussian);
+    printf("xoshiro_ziggurat_scalar,gaussian,%.2f\n", scalar_gaussian);
+    printf("xoshiro_ziggurat_batch,gaussian,%.2f\n", batch_gaussian);
+    printf("xoshiro_batch,impulse,%.2f\n", batch_impulse);
+    printf("xoshiro_ziggurat_batch,combined,%.2f\n", batch_combined);
+    return 0;
+}
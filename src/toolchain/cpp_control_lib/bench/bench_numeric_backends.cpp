@@ -0,0 +1,182 @@
+// Numeric backend benchmark - accuracy and cost of float, Q16.16 and Q1.31
+// controllers against the double reference over the test_all_controllers scenarios
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "pid_controller.hpp"
+#include "system_models.hpp"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Keep the optimizer from discarding benchmark results
+volatile double g_sink = 0.0;
+
+// Scenario parameters from test_all_controllers
+const double kDt = 0.1;
+const double kSimulationTime = 20.0;
+const double kSetpoint = 1.0;
+const double kKp = 0.5;
+const double kKi = 0.1;
+const double kKd = 0.05;
+const double kGamma = 0.01;
+
+enum ControllerKind { KIND_PID, KIND_INCREMENTAL, KIND_FUZZY, KIND_ADAPTIVE, KIND_MAX };
+const char* const kKindNames[KIND_MAX] = {"pid", "incremental_pid", "fuzzy_pid", "adaptive_pid"};
+
+template <typename Real>
+std::unique_ptr<ControllerT<Real> > make_controller(ControllerKind kind)
+{
+    switch (kind) {
+    case KIND_PID:
+        return std::unique_ptr<ControllerT<Real> >(new PIDControllerT<Real>(kKp, kKi, kKd, kDt));
+    case KIND_INCREMENTAL:
+        return std::unique_ptr<ControllerT<Real> >(new IncrementalPIDControllerT<Real>(kKp, kKi, kKd, kDt));
+    case KIND_FUZZY:
+        return std::unique_ptr<ControllerT<Real> >(new FuzzyPIDControllerT<Real>(kKp, kKi, kKd, kDt));
+    default:
+        return std::unique_ptr<ControllerT<Real> >(new AdaptivePIDControllerT<Real>(kKp, kKi, kKd, kDt, kGamma));
+    }
+}
+
+// Q1.31 has position and incremental PID controllers only
+template <>
+std::unique_ptr<ControllerT<Q1_31> > make_controller<Q1_31>(ControllerKind kind)
+{
+    if (kind == KIND_INCREMENTAL) {
+        return std::unique_ptr<ControllerT<Q1_31> >(new IncrementalPIDControllerT<Q1_31>(kKp, kKi, kKd, kDt));
+    }
+    return std::unique_ptr<ControllerT<Q1_31> >(new PIDControllerT<Q1_31>(kKp, kKi, kKd, kDt));
+}
+
+// Gaussian plus impulse measurement noise with the NoiseGenerator settings
+// of test_all_controllers, pregenerated so every backend sees the same sequence
+std::vector<double> make_noise(int steps, bool enabled)
+{
+    std::vector<double> noise(steps, 0.0);
+    if (!enabled) return noise;
+
+    std::mt19937 rng(2024);
+    std::normal_distribution<double> gaussian(0.0, 0.05);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (int i = 0; i < steps; ++i) {
+        noise[i] = gaussian(rng);
+        if (uniform(rng) < 0.02) {
+            noise[i] += (uniform(rng) - 0.5) * 2.0 * 0.2;
+        }
+    }
+    return noise;
+}
+
+// Closed loop with the controller in Real and the plant in double.
+// Signals are multiplied by scale before entering the controller so that
+// Q1.31 can run in its [-1, 1) range.
+template <typename Real>
+void run_closed_loop(ControllerT<Real>& controller, SystemModel& plant, const std::vector<double>& noise,
+                     double scale, std::vector<double>& process_vals, std::vector<double>& outputs)
+{
+    const int steps = static_cast<int>(noise.size());
+    process_vals.assign(steps, 0.0);
+    outputs.assign(steps, 0.0);
+
+    controller.reset();
+    plant.reset();
+    double process_val = 0.0;
+    for (int i = 0; i < steps; ++i) {
+        Real u = controller.compute(Real(kSetpoint * scale), Real(process_val * scale));
+        double u_val = static_cast<double>(u) / scale;
+        process_val = plant.compute(u_val) + noise[i];
+        process_vals[i] = process_val;
+        outputs[i] = u_val;
+    }
+}
+
+// Cost of compute() replaying a recorded process value trajectory
+template <typename Real>
+double ns_per_compute(ControllerT<Real>& controller, const std::vector<double>& process_vals, double scale)
+{
+    std::vector<Real> inputs(process_vals.size());
+    for (std::size_t i = 0; i < process_vals.size(); ++i) {
+        inputs[i] = Real(process_vals[i] * scale);
+    }
+    const Real setpoint(kSetpoint * scale);
+    const int repeats = 2000;
+    Real acc(0.0);
+
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        controller.reset();
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            acc = controller.compute(setpoint, inputs[i]);
+        }
+    }
+    Clock::time_point stop = Clock::now();
+
+    g_sink = g_sink + static_cast<double>(acc);
+    return std::chrono::duration<double, std::nano>(stop - start).count() /
+           (static_cast<double>(repeats) * inputs.size());
+}
+
+template <typename Real>
+void report_backend(const char* backend, double scale, ControllerKind kind, SystemModel& plant,
+                    const std::vector<double>& noise, const std::string& scenario,
+                    const std::vector<double>& ref_pv, const std::vector<double>& ref_u)
+{
+    std::unique_ptr<ControllerT<Real> > controller = make_controller<Real>(kind);
+    std::vector<double> pv, u;
+    run_closed_loop(*controller, plant, noise, scale, pv, u);
+
+    double max_pv_err = 0.0;
+    double sum_sq_u_err = 0.0;
+    for (std::size_t i = 0; i < pv.size(); ++i) {
+        max_pv_err = std::fmax(max_pv_err, std::fabs(pv[i] - ref_pv[i]));
+        sum_sq_u_err += (u[i] - ref_u[i]) * (u[i] - ref_u[i]);
+    }
+    double rms_u_err = std::sqrt(sum_sq_u_err / pv.size());
+    double ns = ns_per_compute(*controller, ref_pv, scale);
+
+    printf("%s,%s,%s,%.3e,%.3e,%.2f\n", scenario.c_str(), kKindNames[kind], backend,
+           max_pv_err, rms_u_err, ns);
+}
+
+} // namespace
+
+int main() {
+    const int steps = static_cast<int>(kSimulationTime / kDt);
+
+    FirstOrderSystem first_order_sys(1.0, 1.0, kDt);
+    SecondOrderSystem second_order_sys(1.0, 0.7, 1.0, kDt);
+    NonlinearSystem nonlinear_sys(1.0, 1.0, 0.5, 0.1, kDt);
+    SystemModel* plants[] = {&first_order_sys, &second_order_sys, &nonlinear_sys};
+
+    printf("scenario,controller,backend,max_abs_pv_error,rms_output_error,ns_per_compute\n");
+    for (int noisy = 0; noisy < 2; ++noisy) {
+        std::vector<double> noise = make_noise(steps, noisy != 0);
+        for (int p = 0; p < 3; ++p) {
+            SystemModel& plant = *plants[p];
+            std::string scenario = plant.get_name() + (noisy ? "_with_noise" : "_no_noise");
+
+            for (int k = 0; k < KIND_MAX; ++k) {
+                ControllerKind kind = static_cast<ControllerKind>(k);
+                std::unique_ptr<Controller> reference = make_controller<double>(kind);
+                std::vector<double> ref_pv, ref_u;
+                run_closed_loop(*reference, plant, noise, 1.0, ref_pv, ref_u);
+
+                report_backend<double>("double", 1.0, kind, plant, noise, scenario, ref_pv, ref_u);
+                report_backend<float>("float", 1.0, kind, plant, noise, scenario, ref_pv, ref_u);
+                report_backend<Q16_16>("q16_16", 1.0, kind, plant, noise, scenario, ref_pv, ref_u);
+                // Q1.31 runs on signals normalized to a full scale of 2
+                if (kind == KIND_PID || kind == KIND_INCREMENTAL) {
+                    report_backend<Q1_31>("q1_31", 0.5, kind, plant, noise, scenario, ref_pv, ref_u);
+                }
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+// PIDBank benchmark - ns/joint of the batched bank versus per-object virtual calls
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "pid_controller.hpp"
+#include "pid_bank.hpp"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Keep the optimizer from discarding benchmark results
+volatile double g_sink = 0.0;
+
+// Enough cycles that every joint count runs for a few milliseconds
+int cycles_for(std::size_t num_joints)
+{
+    const std::size_t target_updates = 1 << 22;
+    std::size_t cycles = target_updates / num_joints;
+    return static_cast<int>(cycles < 64 ? 64 : cycles);
+}
+
+double bench_objects(std::size_t num_joints, int cycles, double dt)
+{
+    // One heap object per joint, driven through the Controller interface
+    std::vector<std::unique_ptr<Controller> > joints;
+    for (std::size_t j = 0; j < num_joints; ++j) {
+        joints.push_back(std::unique_ptr<Controller>(new PIDController(2.0, 1.0, 0.5, dt)));
+    }
+    std::vector<double> setpoints(num_joints, 1.0);
+    std::vector<double> process_vals(num_joints, 0.0);
+    std::vector<double> outputs(num_joints, 0.0);
+
+    Clock::time_point start = Clock::now();
+    for (int c = 0; c < cycles; ++c) {
+        for (std::size_t j = 0; j < num_joints; ++j) {
+            outputs[j] = joints[j]->compute(setpoints[j], process_vals[j]);
+        }
+        process_vals[c % num_joints] += 1e-6;
+    }
+    Clock::time_point stop = Clock::now();
+
+    g_sink = g_sink + outputs[num_joints / 2];
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    return ns / (static_cast<double>(cycles) * num_joints);
+}
+
+double bench_bank(std::size_t num_joints, int cycles, double dt)
+{
+    PIDBank bank(num_joints, 2.0, 1.0, 0.5, dt);
+    std::vector<double> setpoints(num_joints, 1.0);
+    std::vector<double> process_vals(num_joints, 0.0);
+    std::vector<double> outputs(num_joints, 0.0);
+
+    Clock::time_point start = Clock::now();
+    for (int c = 0; c < cycles; ++c) {
+        bank.compute(setpoints.data(), process_vals.data(), outputs.data());
+        process_vals[c % num_joints] += 1e-6;
+    }
+    Clock::time_point stop = Clock::now();
+
+    g_sink = g_sink + outputs[num_joints / 2];
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    return ns / (static_cast<double>(cycles) * num_joints);
+}
+
+} // namespace
+
+int main() {
+    const double dt = 0.001;
+
+    printf("joints,object_ns_per_joint,bank_ns_per_joint,speedup\n");
+    for (std::size_t n = 1; n <= 4096; n *= 2) {
+        int cycles = cycles_for(n);
+        double object_ns = bench_objects(n, cycles, dt);
+        double bank_ns = bench_bank(n, cycles, dt);
+        printf("%zu,%.3f,%.3f,%.2f\n", n, object_ns, bank_ns, object_ns / bank_ns);
+    }
+
+    return 0;
+}
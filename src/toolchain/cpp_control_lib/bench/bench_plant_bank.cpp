@@ -0,0 +1,101 @@
+// PlantBank benchmark - plant-steps per second of the batched engine versus scalar models
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "pid_bank.hpp"
+#include "plant_bank.hpp"
+#include "system_models.hpp"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Keep the optimizer from discarding benchmark results
+volatile double g_sink = 0.0;
+
+const double kDt = 0.001;
+
+std::unique_ptr<SystemModel> make_model(PlantType type)
+{
+    switch (type) {
+    case PLANT_FIRST_ORDER:
+        return std::unique_ptr<SystemModel>(new FirstOrderSystem(1.0, 1.0, kDt));
+    case PLANT_SECOND_ORDER:
+        return std::unique_ptr<SystemModel>(new SecondOrderSystem(1.0, 0.7, 1.0, kDt));
+    default:
+        return std::unique_ptr<SystemModel>(new NonlinearSystem(1.0, 1.0, 0.5, 0.1, kDt));
+    }
+}
+
+// One heap object per plant, stepped through the SystemModel interface
+double scalar_steps_per_second(PlantType type, std::size_t num_plants, int steps)
+{
+    std::vector<std::unique_ptr<SystemModel> > plants;
+    for (std::size_t i = 0; i < num_plants; ++i) plants.push_back(make_model(type));
+    std::vector<double> inputs(num_plants, 0.3), outputs(num_plants);
+
+    Clock::time_point start = Clock::now();
+    for (int k = 0; k < steps; ++k) {
+        for (std::size_t i = 0; i < num_plants; ++i) {
+            outputs[i] = plants[i]->compute(inputs[i]);
+        }
+        inputs[k % num_plants] += 1e-6;
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    g_sink = g_sink + outputs[num_plants / 2];
+    return num_plants * static_cast<double>(steps) / seconds;
+}
+
+double bank_steps_per_second(PlantType type, std::size_t num_plants, int steps)
+{
+    PlantBank plants(type, num_plants, kDt);
+    plants.perturb(0.1, 1);
+    std::vector<double> inputs(num_plants, 0.3), outputs(num_plants);
+
+    Clock::time_point start = Clock::now();
+    for (int k = 0; k < steps; ++k) {
+        plants.step(inputs.data(), outputs.data());
+        inputs[k % num_plants] += 1e-6;
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    g_sink = g_sink + outputs[num_plants / 2];
+    return num_plants * static_cast<double>(steps) / seconds;
+}
+
+// Closed loop: PIDBank and PlantBank in lockstep
+double closed_loop_steps_per_second(PlantType type, std::size_t num_plants, int steps)
+{
+    PlantBank plants(type, num_plants, kDt);
+    plants.perturb(0.1, 1);
+    PIDBank pids(num_plants, 2.0, 1.0, 0.05, kDt);
+    std::vector<double> setpoints(num_plants, 1.0), process_vals(num_plants, 0.0), u(num_plants);
+
+    Clock::time_point start = Clock::now();
+    for (int k = 0; k < steps; ++k) {
+        pids.compute(setpoints.data(), process_vals.data(), u.data());
+        plants.step(u.data(), process_vals.data());
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    g_sink = g_sink + process_vals[num_plants / 2];
+    return num_plants * static_cast<double>(steps) / seconds;
+}
+
+} // namespace
+
+int main() {
+    const char* names[] = {"first_order", "second_order", "nonlinear"};
+    const PlantType types[] = {PLANT_FIRST_ORDER, PLANT_SECOND_ORDER, PLANT_NONLINEAR};
+
+    printf("plant,plants,scalar_msteps_per_s,bank_msteps_per_s,closed_loop_msteps_per_s,speedup\n");
+    for (int t = 0; t < 3; ++t) {
+        for (std::size_t n = 256; n <= 65536; n *= 4) {
+            int steps = static_cast<int>((1 << 24) / n);
+            double scalar = scalar_steps_per_second(types[t], n, steps);
+            double bank = bank_steps_per_second(types[t], n, steps);
+            double loop = closed_loop_steps_per_second(types[t], n, steps);
+            printf("%s,%zu,%.1f,%.1f,%.1f,%.2f\n", names[t], n, scalar / 1e6, bank / 1e6, loop / 1e6, bank / scalar);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Result file benchmark - streamed CSV versus columnar binary output
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "columnar_file.hpp"
+#include "performance_metrics.hpp"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Keep the optimizer from discarding benchmark results
+volatile double g_sink = 0.0;
+
+double seconds_since(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+long file_size(const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr) return 0;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+// Synthetic closed-loop trace: time, setpoint, process value, controller output
+void make_row(int i, double* row)
+{
+    double t = i * 0.001;
+    row[0] = t;
+    row[1] = 1.0;
+    row[2] = 1.0 - 1.0 / (1.0 + t);
+    row[3] = 0.5 + 0.25 / (1.0 + t);
+}
+
+// Write through PerformanceMetrics, as the test programs do
+double write_metrics(int rows, bool columnar, const char* path)
+{
+    Clock::time_point start = Clock::now();
+    {
+        PerformanceMetrics metrics;
+        if (columnar) {
+            metrics.stream_to_columnar(path);
+        } else {
+            metrics.stream_to_file(path);
+        }
+        double row[4];
+        for (int i = 0; i < rows; ++i) {
+            make_row(i, row);
+            metrics.add_data_point(row[0], row[1], row[2], row[3]);
+        }
+    }
+    return seconds_since(start);
+}
+
+// Parse the CSV back into four columns
+double read_csv(const char* path, int rows)
+{
+    Clock::time_point start = Clock::now();
+    std::vector<double> columns[4];
+    for (int c = 0; c < 4; ++c) columns[c].reserve(rows);
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    while (std::getline(in, line)) {
+        const char* p = line.c_str();
+        char* end = nullptr;
+        for (int c = 0; c < 4; ++c) {
+            columns[c].push_back(strtod(p, &end));
+            p = end + 1;
+        }
+    }
+    double elapsed = seconds_since(start);
+    g_sink = g_sink + columns[2].back();
+    return elapsed;
+}
+
+// Map the columnar file and gather all four columns
+double read_columnar(const char* path)
+{
+    Clock::time_point start = Clock::now();
+    ColumnarReader reader;
+    reader.open(path);
+    std::vector<double> columns[4];
+    for (int c = 0; c < 4; ++c) reader.readColumn(c, columns[c]);
+    double elapsed = seconds_since(start);
+    g_sink = g_sink + columns[2].back();
+    return elapsed;
+}
+
+// Sum one column in place from the mapped chunks, without copying
+double scan_columnar(const char* path)
+{
+    Clock::time_point start = Clock::now();
+    ColumnarReader reader;
+    reader.open(path);
+    double sum = 0.0;
+    for (size_t k = 0; k < reader.numChunks(); ++k) {
+        const double* values = reader.chunkColumn<double>(k, 2);
+        for (size_t i = 0; i < reader.chunkRows(k); ++i) sum += values[i];
+    }
+    double elapsed = seconds_since(start);
+    g_sink = g_sink + sum;
+    return elapsed;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int rows = argc > 1 ? atoi(argv[1]) : 2000000;
+    const char* csv_path = "bench_result_formats.csv";
+    const char* ccol_path = "bench_result_formats.ccol";
+    const double payload_mb = rows * 4 * sizeof(double) / 1e6;
+
+    double csv_write = write_metrics(rows, false, csv_path);
+    double ccol_write = write_metrics(rows, true, ccol_path);
+    double csv_read = read_csv(csv_path, rows);
+    double ccol_read = read_columnar(ccol_path);
+    double ccol_scan = scan_columnar(ccol_path);
+
+    printf("rows,%d\n", rows);
+    printf("format,operation,seconds,ns_per_row,payload_mb_per_s,file_mb\n");
+    printf("csv,write,%.4f,%.1f,%.1f,%.1f\n", csv_write, csv_write * 1e9 / rows, payload_mb / csv_write,
+           file_size(csv_path) / 1e6);
+    printf("ccol,write,%.4f,%.1f,%.1f,%.1f\n", ccol_write, ccol_write * 1e9 / rows, payload_mb / ccol_write,
+           file_size(ccol_path) / 1e6);
+    printf("csv,read_all,%.4f,%.1f,%.1f,\n", csv_read, csv_read * 1e9 / rows, payload_mb / csv_read);
+    printf("ccol,read_all,%.4f,%.1f,%.1f,\n", ccol_read, ccol_read * 1e9 / rows, payload_mb / ccol_read);
+    printf("ccol,scan_column,%.4f,%.1f,%.1f,\n", ccol_scan, ccol_scan * 1e9 / rows, payload_mb / 4 / ccol_scan);
+
+    remove(csv_path);
+    remove(ccol_path);
+    return 0;
+}
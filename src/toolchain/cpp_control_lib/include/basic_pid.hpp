@@ -0,0 +1,206 @@
+// Compile-time policy-based PID controller definition (header-only)
+#ifndef _BASIC_PID_H_
+#define _BASIC_PID_H_
+
+#include "controller_base.hpp"
+
+// BasicPID composes derivative, anti-windup and output clamp behavior at
+// compile time. Every policy call is a non-virtual inline member, so a
+// fixed-configuration joint compiles down to a few multiply-adds with the
+// gains pre-scaled by dt at construction.
+//
+// Per cycle the controller evaluates:
+//   err        = setpoint - process_val
+//   integral   = AntiWindup.limit(integral + ki*dt*err)
+//   u          = kp*err + integral + Derivative.term(...)
+//   output     = Clamp.apply(u)
+//   integral   = AntiWindup.commit(...)
+
+// ---------------------------------------------------------------------------
+// Derivative policies
+// ---------------------------------------------------------------------------
+
+// Derivative on measurement - avoids derivative kick on setpoint steps.
+// Same behavior as PIDController.
+template <typename Real>
+struct DerivativeOnMeasurement {
+    Real prev_pv;
+
+    DerivativeOnMeasurement() : prev_pv(0) {}
+
+    Real term(Real /*err*/, Real process_val, Real kd_over_dt) {
+        Real d = kd_over_dt * (prev_pv - process_val);
+        prev_pv = process_val;
+        return d;
+    }
+
+    void reset() { prev_pv = Real(0); }
+};
+
+// Derivative on error - classic textbook form
+template <typename Real>
+struct DerivativeOnError {
+    Real prev_err;
+
+    DerivativeOnError() : prev_err(0) {}
+
+    Real term(Real err, Real /*process_val*/, Real kd_over_dt) {
+        Real d = kd_over_dt * (err - prev_err);
+        prev_err = err;
+        return d;
+    }
+
+    void reset() { prev_err = Real(0); }
+};
+
+// No derivative action (PI controller)
+template <typename Real>
+struct NoDerivative {
+    Real term(Real, Real, Real) { return Real(0); }
+    void reset() {}
+};
+
+// ---------------------------------------------------------------------------
+// Anti-windup policies
+// ---------------------------------------------------------------------------
+
+// Unbounded integral. Same behavior as PIDController.
+template <typename Real>
+struct NoAntiWindup {
+    Real limit(Real integral) const { return integral; }
+    Real commit(Real /*previous*/, Real integral, Real /*u*/, Real /*output*/) const { return integral; }
+};
+
+// Clamp the integral term to [min_val, max_val]
+template <typename Real>
+struct IntegralClamp {
+    Real min_val;
+    Real max_val;
+
+    IntegralClamp(Real min_v = Real(-1), Real max_v = Real(1)) : min_val(min_v), max_val(max_v) {}
+
+    Real limit(Real integral) const {
+        if (integral < min_val) return min_val;
+        if (integral > max_val) return max_val;
+        return integral;
+    }
+    Real commit(Real /*previous*/, Real integral, Real /*u*/, Real /*output*/) const { return integral; }
+};
+
+// Conditional integration - freeze the integral while the output saturates
+template <typename Real>
+struct ConditionalIntegration {
+    Real limit(Real integral) const { return integral; }
+    Real commit(Real previous, Real integral, Real u, Real output) const {
+        return (u != output) ? previous : integral;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Output clamp policies
+// ---------------------------------------------------------------------------
+
+// Unlimited output. Same behavior as PIDController.
+template <typename Real>
+struct NoClamp {
+    Real apply(Real u) const { return u; }
+};
+
+// Saturate output to [min_val, max_val]
+template <typename Real>
+struct OutputClamp {
+    Real min_val;
+    Real max_val;
+
+    OutputClamp(Real min_v = Real(-1), Real max_v = Real(1)) : min_val(min_v), max_val(max_v) {}
+
+    Real apply(Real u) const {
+        if (u < min_val) return min_val;
+        if (u > max_val) return max_val;
+        return u;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Policy-based position PID
+// ---------------------------------------------------------------------------
+
+template <typename Real,
+          template <typename> class DerivativePolicy = DerivativeOnMeasurement,
+          template <typename> class AntiWindupPolicy = NoAntiWindup,
+          template <typename> class ClampPolicy = NoClamp>
+class BasicPID {
+public:
+    typedef Real value_type;
+    typedef DerivativePolicy<Real> derivative_type;
+    typedef AntiWindupPolicy<Real> anti_windup_type;
+    typedef ClampPolicy<Real> clamp_type;
+
+    // Constructor
+    BasicPID(Real kp_val, Real ki_val, Real kd_val, Real dt_val,
+             const anti_windup_type& anti_windup_val = anti_windup_type(),
+             const clamp_type& clamp_val = clamp_type())
+        : kp(kp_val), ki_dt(ki_val * dt_val), kd_over_dt(kd_val / dt_val), integral(0),
+          derivative(), anti_windup(anti_windup_val), clamp(clamp_val)
+    {
+    }
+
+    // Calculate PID output
+    Real compute(Real setpoint, Real process_val) {
+        Real err = setpoint - process_val;
+        Real previous = integral;
+
+        Real i_term = anti_windup.limit(integral + ki_dt * err);
+        Real u = kp * err + i_term + derivative.term(err, process_val, kd_over_dt);
+        Real output = clamp.apply(u);
+
+        integral = anti_windup.commit(previous, i_term, u, output);
+        return output;
+    }
+
+    // Reset controller
+    void reset() {
+        integral = Real(0);
+        derivative.reset();
+    }
+
+private:
+    Real kp;
+    Real ki_dt;
+    Real kd_over_dt;
+    Real integral;
+
+    derivative_type derivative;
+    anti_windup_type anti_windup;
+    clamp_type clamp;
+};
+
+// Thin adapter exposing any BasicPID instantiation through the Controller
+// interface for code that still dispatches virtually
+template <typename PID>
+class ControllerAdapter : public Controller {
+public:
+    typedef typename PID::value_type value_type;
+
+    explicit ControllerAdapter(const PID& pid_val) : pid(pid_val) {}
+
+    // Calculate PID output
+    double compute(double setpoint, double process_val) override {
+        return static_cast<double>(pid.compute(static_cast<value_type>(setpoint),
+                                               static_cast<value_type>(process_val)));
+    }
+
+    // Reset controller
+    void reset() override { pid.reset(); }
+
+    // Direct access to the wrapped controller
+    PID& controller() { return pid; }
+
+private:
+    PID pid;
+};
+
+// Policy configuration equivalent to PIDController
+typedef BasicPID<double> StaticPID;
+
+#endif // _BASIC_PID_H_
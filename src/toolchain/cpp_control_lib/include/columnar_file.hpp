@@ -0,0 +1,177 @@
+// Columnar binary result file definition
+#ifndef _COLUMNAR_FILE_H_
+#define _COLUMNAR_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Chunked columnar format for simulation output (.ccol).
+// Rows are buffered per column and written one chunk at a time, each
+// column's chunk as one contiguous, 64-byte aligned block of raw values,
+// so writing is a memcpy plus one fwrite per column and chunk, and readers
+// map the file and use the blocks in place without parsing. All values are
+// stored in the writer's native byte order, recorded by the header's
+// byte_order mark; readers reject files written with the other byte order.
+//
+// Layout:
+//   ColumnarFileHeader                       64 bytes, written last on close
+//   chunk 0: column 0 block, column 1 block, ...
+//   chunk 1: ...
+//   directory at header.directory_offset:
+//     ColumnarColumnInfo[num_columns]
+//     per chunk: uint64 rows, uint64 offset[num_columns]
+
+// Column value types
+enum ColumnType {
+    COLUMN_FLOAT64 = 1,
+    COLUMN_FLOAT32 = 2,
+    COLUMN_INT32 = 3,
+    COLUMN_INT64 = 4
+};
+
+// File header
+struct ColumnarFileHeader {
+    char magic[4];                  // "CCOL"
+    std::uint32_t version;          // columnar_file_version
+    std::uint32_t num_columns;
+    std::uint32_t chunk_rows;       // Rows per full chunk
+    std::uint64_t num_rows;
+    std::uint64_t num_chunks;
+    std::uint64_t directory_offset;
+    std::uint32_t byte_order;       // columnar_byte_order_mark in the writer's byte order
+    std::uint8_t reserved[20];
+};
+
+// Column directory entry
+struct ColumnarColumnInfo {
+    char name[40];                  // NUL padded
+    std::uint32_t type;             // ColumnType
+    std::uint32_t element_size;
+};
+
+static const std::uint32_t columnar_file_version = 2;
+static const std::uint32_t columnar_byte_order_mark = 0x01020304;
+static const std::size_t columnar_block_alignment = 64;
+
+// Size in bytes of one value of the given type, 0 for unknown types
+std::size_t column_type_size(ColumnType type);
+
+// Streaming writer
+class ColumnarWriter {
+public:
+    ColumnarWriter();
+
+    // Destructor - closes the file if still open
+    ~ColumnarWriter();
+
+    // Declare a column before open(). Names are truncated to 39 characters.
+    // Returns the column index, or -1 after open() or for an unknown type.
+    int addColumn(const std::string& name, ColumnType type);
+
+    // Create the file and allocate one chunk of row buffers
+    bool open(const std::string& path, std::size_t chunk_rows = 65536);
+
+    // Append one row; values holds one entry per column, converted to the column type.
+    // Integer columns truncate toward zero, saturate out-of-range values and store NaN as 0.
+    void appendRow(const double* values);
+
+    // Flush the last chunk, write the directory and the final header
+    bool close();
+
+    bool isOpen() const { return file != nullptr; }
+    std::size_t numColumns() const { return columns.size(); }
+    std::uint64_t numRows() const { return total_rows; }
+
+private:
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+    // Write the buffered rows as one chunk
+    bool flushChunk();
+
+    // Write bytes and track the file position
+    bool write(const void* data, std::size_t size);
+
+    // Pad the file with zeros up to the next multiple of alignment
+    bool pad(std::size_t alignment);
+
+    std::FILE* file;
+    std::uint64_t position;
+    bool failed;
+    std::size_t chunk_rows;
+    std::size_t buffered_rows;
+    std::uint64_t total_rows;
+
+    std::vector<ColumnarColumnInfo> columns;
+    std::vector<std::vector<unsigned char> > buffers;  // One chunk per column
+    std::vector<std::uint64_t> chunk_index;            // rows, offsets... per chunk
+};
+
+// Memory-mapped reader; column blocks are used in place
+class ColumnarReader {
+public:
+    ColumnarReader();
+
+    // Destructor - unmaps the file
+    ~ColumnarReader();
+
+    // Map a file and validate its header and directory
+    bool open(const std::string& path);
+
+    // Unmap the file
+    void close();
+
+    std::size_t numColumns() const { return num_columns; }
+    std::uint64_t numRows() const { return num_rows; }
+    std::size_t numChunks() const { return num_chunks; }
+
+    // Column metadata; findColumn() returns -1 if there is no such column
+    std::string columnName(std::size_t column) const;
+    ColumnType columnType(std::size_t column) const;
+    int findColumn(const std::string& name) const;
+
+    // Rows in a chunk and a pointer to a column's raw values in that chunk
+    std::size_t chunkRows(std::size_t chunk) const;
+    const void* chunkData(std::size_t chunk, std::size_t column) const;
+
+    // Typed chunk access, nullptr if T does not match the column type
+    template <typename T>
+    const T* chunkColumn(std::size_t chunk, std::size_t column) const;
+
+    // Gather a whole column converted to double
+    bool readColumn(std::size_t column, std::vector<double>& values) const;
+
+private:
+    ColumnarReader(const ColumnarReader&) = delete;
+    ColumnarReader& operator=(const ColumnarReader&) = delete;
+
+    // Check that the type tag matches T
+    template <typename T> static bool matches(ColumnType type);
+
+    const unsigned char* base;
+    std::size_t length;
+    std::size_t num_columns;
+    std::uint64_t num_rows;
+    std::size_t num_chunks;
+    const ColumnarColumnInfo* column_info;
+    const std::uint64_t* chunk_index;
+};
+
+template <> inline bool ColumnarReader::matches<double>(ColumnType type) { return type == COLUMN_FLOAT64; }
+template <> inline bool ColumnarReader::matches<float>(ColumnType type) { return type == COLUMN_FLOAT32; }
+template <> inline bool ColumnarReader::matches<std::int32_t>(ColumnType type) { return type == COLUMN_INT32; }
+template <> inline bool ColumnarReader::matches<std::int64_t>(ColumnType type) { return type == COLUMN_INT64; }
+
+template <typename T>
+const T* ColumnarReader::chunkColumn(std::size_t chunk, std::size_t column) const
+{
+    if (column >= num_columns || !matches<T>(columnType(column))) {
+        return nullptr;
+    }
+    return static_cast<const T*>(chunkData(chunk, column));
+}
+
+#endif // _COLUMNAR_FILE_H_
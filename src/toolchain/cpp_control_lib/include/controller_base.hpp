@@ -2,17 +2,38 @@
 #ifndef _CONTROLLER_BASE_H_
 #define _CONTROLLER_BASE_H_
 
-// Controller base class, defines unified interface
-class Controller {
+#include <cstddef>
+
+// Controller base class template, defines unified interface for numeric type Real
+template <typename Real>
+class ControllerT {
 public:
     // Virtual destructor
-    virtual ~Controller() = default;
-    
+    virtual ~ControllerT() = default;
+
     // Calculate controller output - pure virtual function
-    virtual double compute(double setpoint, double process_val) = 0;
-    
+    virtual Real compute(Real setpoint, Real process_val) = 0;
+
     // Reset controller state - virtual function
     virtual void reset() = 0;
+
+    // Size in bytes of the binary state snapshot, 0 if snapshots are not supported
+    virtual std::size_t stateSize() const { return 0; }
+
+    // Write a snapshot of gains, integrals and history into buffer.
+    // Returns the number of bytes written, 0 if unsupported or capacity is too small.
+    virtual std::size_t saveState(void*, std::size_t) const { return 0; }
+
+    // Restore a snapshot taken from a controller of the same type and numeric
+    // type; the next compute() continues exactly where the snapshot was taken.
+    // Returns false and leaves the controller unchanged on any mismatch.
+    virtual bool restoreState(const void*, std::size_t) { return false; }
+
+    // Check that restoreState() would accept a snapshot, without applying it
+    virtual bool checkState(const void*, std::size_t) const { return false; }
 };
 
-#endif // _CONTROLLER_BASE_H_
\ No newline at end of file
+// Double precision controller interface
+typedef ControllerT<double> Controller;
+
+#endif // _CONTROLLER_BASE_H_
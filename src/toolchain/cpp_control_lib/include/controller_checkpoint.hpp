@@ -0,0 +1,98 @@
+// Multi-controller state checkpoint definition
+#ifndef _CONTROLLER_CHECKPOINT_H_
+#define _CONTROLLER_CHECKPOINT_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "controller_base.hpp"
+
+// State snapshots of a fixed list of controllers in one contiguous buffer,
+// optionally persisted to a file for warm restart after a process restart.
+// Controllers are restored in the order they were captured; restoring is a
+// header check and a memcpy per controller.
+class ControllerCheckpoint {
+public:
+    ControllerCheckpoint() : count(0) {}
+
+    // Snapshot count controllers. Returns false if any controller does not
+    // support snapshots, in which case the checkpoint is left empty.
+    template <typename Real>
+    bool capture(ControllerT<Real>* const* controllers, std::size_t count_val);
+
+    // Restore count controllers of the same types as captured. Every snapshot
+    // is validated first, so on a count, type or numeric type mismatch it
+    // returns false and leaves all controllers unchanged.
+    template <typename Real>
+    bool restore(ControllerT<Real>* const* controllers, std::size_t count_val) const;
+
+    // Write to a file via a temporary file and rename, so a crash never
+    // leaves a partial checkpoint behind
+    bool saveFile(const std::string& path) const;
+
+    // Read a file written by saveFile(), verifying its checksum
+    bool loadFile(const std::string& path);
+
+    // Number of controllers and raw snapshot bytes
+    std::size_t size() const { return count; }
+    const std::vector<unsigned char>& data() const { return buffer; }
+
+    // Discard all snapshots
+    void clear() { buffer.clear(); count = 0; }
+
+private:
+    std::vector<unsigned char> buffer;
+    std::size_t count;
+};
+
+template <typename Real>
+bool ControllerCheckpoint::capture(ControllerT<Real>* const* controllers, std::size_t count_val)
+{
+    clear();
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < count_val; ++i) {
+        std::size_t size = controllers[i]->stateSize();
+        if (size == 0) {
+            return false;
+        }
+        total += size;
+    }
+
+    buffer.resize(total);
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < count_val; ++i) {
+        offset += controllers[i]->saveState(buffer.data() + offset, total - offset);
+    }
+    count = count_val;
+    return true;
+}
+
+template <typename Real>
+bool ControllerCheckpoint::restore(ControllerT<Real>* const* controllers, std::size_t count_val) const
+{
+    if (count_val != count) {
+        return false;
+    }
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < count_val; ++i) {
+        std::size_t size = controllers[i]->stateSize();
+        if (size == 0 || offset + size > buffer.size() ||
+            !controllers[i]->checkState(buffer.data() + offset, size)) {
+            return false;
+        }
+        offset += size;
+    }
+    if (offset != buffer.size()) {
+        return false;
+    }
+
+    offset = 0;
+    for (std::size_t i = 0; i < count_val; ++i) {
+        std::size_t size = controllers[i]->stateSize();
+        controllers[i]->restoreState(buffer.data() + offset, size);
+        offset += size;
+    }
+    return true;
+}
+
+#endif // _CONTROLLER_CHECKPOINT_H_
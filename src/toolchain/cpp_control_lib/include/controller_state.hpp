@@ -0,0 +1,108 @@
+// Controller state snapshot format (header-only)
+#ifndef _CONTROLLER_STATE_H_
+#define _CONTROLLER_STATE_H_
+
+#include <cstdint>
+#include <cstring>
+#include "fixed_point.hpp"
+
+// A snapshot is a fixed-size header followed by the controller's state
+// fields as raw values of its numeric type, in native byte order. Snapshots
+// are meant for warm restart on the same machine; configuration that is not
+// state (fuzzy rule tables, inference mode) is not stored and must match.
+
+// Controller type stored in a snapshot
+enum ControllerStateKind {
+    STATE_PID = 1,
+    STATE_INCREMENTAL_PID = 2,
+    STATE_FUZZY_PID = 3,
+    STATE_ADAPTIVE_PID = 4
+};
+
+// Snapshot header, 12 bytes
+struct ControllerStateHeader {
+    std::uint32_t magic;          // controller_state_magic
+    std::uint16_t kind;           // ControllerStateKind
+    std::uint8_t real_type;       // RealTypeTag of the numeric type
+    std::uint8_t version;         // controller_state_version
+    std::uint32_t payload_size;   // Bytes of state following the header
+};
+
+static const std::uint32_t controller_state_magic = 0x41545343;  // "CSTA"
+static const std::uint8_t controller_state_version = 2;
+
+// Numeric type identifier stored in snapshots
+template <typename Real> struct RealTypeTag;
+template <> struct RealTypeTag<double> { static const std::uint8_t value = 1; };
+template <> struct RealTypeTag<float> { static const std::uint8_t value = 2; };
+template <int FracBits> struct RealTypeTag<FixedPoint<FracBits> > {
+    static const std::uint8_t value = 0x80 | FracBits;
+};
+
+// Snapshot size of a controller with N state fields
+template <typename Real, std::size_t N>
+inline std::size_t controller_state_size()
+{
+    return sizeof(ControllerStateHeader) + N * sizeof(Real);
+}
+
+// Write the members listed in fields. Returns bytes written, 0 if the buffer is too small.
+template <class C, typename Real, std::size_t N>
+inline std::size_t save_controller_state(const C& controller, Real C::* const (&fields)[N],
+                                         ControllerStateKind kind, void* buffer, std::size_t capacity)
+{
+    const std::size_t size = controller_state_size<Real, N>();
+    if (buffer == nullptr || capacity < size) {
+        return 0;
+    }
+
+    ControllerStateHeader header;
+    header.magic = controller_state_magic;
+    header.kind = static_cast<std::uint16_t>(kind);
+    header.real_type = RealTypeTag<Real>::value;
+    header.version = controller_state_version;
+    header.payload_size = static_cast<std::uint32_t>(N * sizeof(Real));
+
+    unsigned char* out = static_cast<unsigned char*>(buffer);
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    for (std::size_t i = 0; i < N; ++i) {
+        std::memcpy(out, &(controller.*fields[i]), sizeof(Real));
+        out += sizeof(Real);
+    }
+    return size;
+}
+
+// Validate a snapshot header against a controller with N state fields
+template <typename Real, std::size_t N>
+inline bool check_controller_state(ControllerStateKind kind, const void* buffer, std::size_t size)
+{
+    if (buffer == nullptr || size < controller_state_size<Real, N>()) {
+        return false;
+    }
+
+    ControllerStateHeader header;
+    std::memcpy(&header, buffer, sizeof(header));
+    return header.magic == controller_state_magic && header.kind == kind &&
+           header.real_type == RealTypeTag<Real>::value && header.version == controller_state_version &&
+           header.payload_size == N * sizeof(Real);
+}
+
+// Read the members listed in fields after validating the header
+template <class C, typename Real, std::size_t N>
+inline bool restore_controller_state(C& controller, Real C::* const (&fields)[N],
+                                     ControllerStateKind kind, const void* buffer, std::size_t size)
+{
+    if (!check_controller_state<Real, N>(kind, buffer, size)) {
+        return false;
+    }
+
+    const unsigned char* in = static_cast<const unsigned char*>(buffer) + sizeof(ControllerStateHeader);
+    for (std::size_t i = 0; i < N; ++i) {
+        std::memcpy(&(controller.*fields[i]), in, sizeof(Real));
+        in += sizeof(Real);
+    }
+    return true;
+}
+
+#endif // _CONTROLLER_STATE_H_
@@ -0,0 +1,124 @@
+// Controller/plant co-simulation over shared-memory rings definition
+#ifndef _COSIM_H_
+#define _COSIM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include "controller_base.hpp"
+#include "data_transfer.h"
+#include "system_models.hpp"
+
+// Where the plant runs
+enum CosimMode {
+    COSIM_THREAD,       // Plant thread in this process
+    COSIM_PROCESS       // Forked plant process sharing an anonymous or named mapping
+};
+
+// Co-simulation settings
+struct CosimConfig {
+    CosimMode mode;
+    long period_ns;             // Cycle of both sides, 1000000 for 1 kHz
+    long controller_offset_ns;  // Controller release after the plant release, within the period
+    double duration;            // Simulated seconds, also the wall-clock run time
+    double setpoint;
+    int plant_priority;         // SCHED_FIFO priority 1-99, 0 keeps the default policy
+    int controller_priority;    // Applied to the calling thread
+    int plant_cpu;              // CPU to pin to, -1 for no pinning
+    int controller_cpu;
+    std::string shm_name;       // Named POSIX shared memory object, empty for anonymous
+    std::string output_file;    // CSV of the co-simulated response, empty for none
+
+    CosimConfig();
+};
+
+// Latency distribution with 1 us bins up to 5 ms and exact extremes
+class LatencyHistogram {
+public:
+    static const std::size_t num_bins = 5000;
+    static const std::int64_t bin_ns = 1000;
+
+    LatencyHistogram() { clear(); }
+
+    void clear();
+    void add(std::int64_t ns);
+    void merge(const LatencyHistogram& other);
+
+    std::uint64_t count() const { return samples; }
+    std::int64_t min() const { return samples ? minimum : 0; }
+    std::int64_t max() const { return samples ? maximum : 0; }
+    double mean() const { return samples ? static_cast<double>(sum) / samples : 0.0; }
+
+    // Upper edge of the bin holding the p-quantile (0..1), at most max()
+    std::int64_t percentile(double p) const;
+
+private:
+    std::uint64_t samples;
+    std::int64_t minimum;
+    std::int64_t maximum;
+    std::int64_t sum;
+    std::uint32_t bins[num_bins + 1];   // Last bin collects everything above 5 ms
+};
+
+// Step response metrics of one run
+struct CosimResponse {
+    double rise_time;
+    double overshoot;
+    double settling_time;
+    double steady_state_error;
+    double iae;
+    double itae;
+    double control_effort;
+};
+
+// Timing statistics and closed-loop outcome, all times in nanoseconds
+struct CosimResult {
+    bool ok;                            // Both sides ran to completion
+    std::uint64_t cycles;
+
+    // Plant sampling instant to the instant the command computed from that
+    // sample is applied: the sensor-to-actuator delay seen by the loop
+    LatencyHistogram loop_delay;
+    // Ring push to pop, both directions. A sample sits in the ring until the
+    // other side's next release, so this is mostly the phase between the
+    // sides (controller_offset_ns one way, the rest of the period the other)
+    // plus wake-up latency, not the cost of the transfer itself
+    LatencyHistogram ring_wait;
+    // Wake-up after the release deadline of each side
+    LatencyHistogram plant_wakeup;
+    LatencyHistogram controller_wakeup;
+
+    std::uint64_t stale_measurements;   // Controller cycles without the current plant sample
+    std::uint64_t late_commands;        // Plant cycles without the command for the previous sample
+    std::uint64_t dropped;              // Pushes into a full ring
+
+    // The same controller and plant stepped inline, as in test_all_controllers.
+    // With perfect timing the co-simulated trace equals it exactly, so any
+    // difference is the closed-loop effect of jitter and late samples.
+    CosimResponse cosim;
+    CosimResponse ideal;
+    double max_deviation;               // Largest |process value - inline process value|
+};
+
+typedef std::function<std::unique_ptr<Controller>()> CosimControllerFactory;
+typedef std::function<std::unique_ptr<SystemModel>()> CosimPlantFactory;
+
+// Run controller and plant as two periodic tasks on CLOCK_MONOTONIC deadlines.
+// Every plant cycle applies the newest command, steps the model once and
+// publishes the output as a JointData_t (position, velocity, acceleration
+// and the applied force) through a ShmRing in shared memory; every
+// controller cycle, controller_offset_ns later, reads the newest sample,
+// computes the command and sends it back the same way. The plant runs in a
+// thread or forked process, the controller in the calling thread. Models
+// must be built for a sample time of period_ns. A late or missing sample is
+// not waited for: the controller reuses the previous one and the plant holds
+// the previous command, as a real periodic loop would.
+CosimResult run_cosimulation(const CosimConfig& config, const CosimControllerFactory& make_controller,
+                             const CosimPlantFactory& make_plant);
+
+// Print timing statistics and the response next to the inline reference
+void print_cosim_result(const CosimResult& result);
+
+#endif // _COSIM_H_
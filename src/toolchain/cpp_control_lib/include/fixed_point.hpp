@@ -0,0 +1,137 @@
+// Saturating fixed-point number type (header-only)
+#ifndef _FIXED_POINT_H_
+#define _FIXED_POINT_H_
+
+#include <cstdint>
+
+// Signed 32-bit fixed-point value with FracBits fractional bits.
+// Every arithmetic operation saturates at the representable range instead of
+// wrapping, so controller integrators clip rather than flip sign on overflow.
+// Products are rounded to nearest. Division is provided for completeness but
+// the controllers keep it out of compute() by precomputing reciprocals.
+template <int FracBits>
+class FixedPoint {
+public:
+    static_assert(FracBits > 0 && FracBits < 32, "FracBits must be in [1, 31]");
+
+    typedef std::int32_t raw_type;
+    static const int frac_bits = FracBits;
+
+    FixedPoint() : raw(0) {}
+
+    // Convert from floating point with rounding and saturation
+    explicit FixedPoint(double value) : raw(saturate(round_to_raw(value))) {}
+
+    // Construct from a raw two's complement value
+    static FixedPoint from_raw(raw_type raw_val) {
+        FixedPoint result;
+        result.raw = raw_val;
+        return result;
+    }
+
+    raw_type raw_value() const { return raw; }
+
+    explicit operator double() const { return static_cast<double>(raw) / one_raw(); }
+    explicit operator float() const { return static_cast<float>(static_cast<double>(*this)); }
+
+    // Largest, smallest and smallest positive representable values
+    static FixedPoint max() { return from_raw(INT32_MAX); }
+    static FixedPoint min() { return from_raw(INT32_MIN); }
+    static FixedPoint epsilon() { return from_raw(1); }
+
+    FixedPoint operator+(FixedPoint other) const {
+        return from_raw(saturate(static_cast<std::int64_t>(raw) + other.raw));
+    }
+
+    FixedPoint operator-(FixedPoint other) const {
+        return from_raw(saturate(static_cast<std::int64_t>(raw) - other.raw));
+    }
+
+    FixedPoint operator-() const {
+        return from_raw(saturate(-static_cast<std::int64_t>(raw)));
+    }
+
+    FixedPoint operator*(FixedPoint other) const {
+        std::int64_t product = static_cast<std::int64_t>(raw) * other.raw;
+        product += static_cast<std::int64_t>(1) << (FracBits - 1);
+        return from_raw(saturate(product >> FracBits));
+    }
+
+    FixedPoint operator/(FixedPoint other) const {
+        if (other.raw == 0) {
+            return raw >= 0 ? max() : min();
+        }
+        std::int64_t numerator = static_cast<std::int64_t>(raw) * (static_cast<std::int64_t>(1) << FracBits);
+        return from_raw(saturate(numerator / other.raw));
+    }
+
+    FixedPoint& operator+=(FixedPoint other) { return *this = *this + other; }
+    FixedPoint& operator-=(FixedPoint other) { return *this = *this - other; }
+    FixedPoint& operator*=(FixedPoint other) { return *this = *this * other; }
+    FixedPoint& operator/=(FixedPoint other) { return *this = *this / other; }
+
+    bool operator==(FixedPoint other) const { return raw == other.raw; }
+    bool operator!=(FixedPoint other) const { return raw != other.raw; }
+    bool operator<(FixedPoint other) const { return raw < other.raw; }
+    bool operator<=(FixedPoint other) const { return raw <= other.raw; }
+    bool operator>(FixedPoint other) const { return raw > other.raw; }
+    bool operator>=(FixedPoint other) const { return raw >= other.raw; }
+
+private:
+    static double one_raw() { return static_cast<double>(static_cast<std::int64_t>(1) << FracBits); }
+
+    static std::int64_t round_to_raw(double value) {
+        double scaled = value * one_raw();
+        // Clip before the integer conversion, which is undefined out of range
+        if (scaled >= 9.2e18) return INT64_MAX;
+        if (scaled <= -9.2e18) return INT64_MIN;
+        return static_cast<std::int64_t>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+    }
+
+    static raw_type saturate(std::int64_t value) {
+        if (value > INT32_MAX) return INT32_MAX;
+        if (value < INT32_MIN) return INT32_MIN;
+        return static_cast<raw_type>(value);
+    }
+
+    raw_type raw;
+};
+
+// Absolute value, saturating at max() for min()
+template <int FracBits>
+inline FixedPoint<FracBits> abs(FixedPoint<FracBits> value) {
+    return value < FixedPoint<FracBits>() ? -value : value;
+}
+
+// sum += a * b for integrators. Floating-point types accumulate directly and
+// leave residue untouched.
+template <typename Real>
+inline void accumulate_product(Real& sum, Real& residue, Real a, Real b) {
+    (void)residue;
+    sum += a * b;
+}
+
+// Fixed-point overload: the part of each full-precision product below one
+// resolution step is carried in residue (raw value in [0, 2^FracBits)), so
+// increments smaller than epsilon() - a small error times ki * dt - still
+// add up instead of rounding to zero every cycle.
+template <int FracBits>
+inline void accumulate_product(FixedPoint<FracBits>& sum, FixedPoint<FracBits>& residue,
+                               FixedPoint<FracBits> a, FixedPoint<FracBits> b) {
+    const std::int64_t one = static_cast<std::int64_t>(1) << FracBits;
+    std::int64_t product = static_cast<std::int64_t>(a.raw_value()) * b.raw_value() + residue.raw_value();
+    std::int64_t whole = product >> FracBits;
+    residue = FixedPoint<FracBits>::from_raw(static_cast<std::int32_t>(product - whole * one));
+    if (whole > INT32_MAX) whole = INT32_MAX;
+    if (whole < INT32_MIN) whole = INT32_MIN;
+    sum += FixedPoint<FracBits>::from_raw(static_cast<std::int32_t>(whole));
+}
+
+// Q16.16: range [-32768, 32768), resolution 1.5e-5
+typedef FixedPoint<16> Q16_16;
+
+// Q1.31: range [-1, 1), resolution 4.7e-10. Gains, dt-scaled gains and
+// signals must all be normalized into [-1, 1).
+typedef FixedPoint<31> Q1_31;
+
+#endif // _FIXED_POINT_H_
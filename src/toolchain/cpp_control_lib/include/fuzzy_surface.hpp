@@ -0,0 +1,52 @@
+// Precompiled fuzzy inference surface definition
+#ifndef _FUZZY_SURFACE_H_
+#define _FUZZY_SURFACE_H_
+
+#include <vector>
+
+// Mamdani fuzzy inference (Gaussian membership, min/max, centroid) sampled
+// once onto a regular (e, ec) grid and evaluated with bilinear interpolation.
+// The rule base and inference follow src/control_algorithms/fuzzy_pid/
+// fuzzy_inference.m: seven Gaussian sets centered at -3..3 on both inputs,
+// output singletons at -3..3, so every output lies in [-3, 3].
+class FuzzySurface {
+public:
+    // Number of fuzzy sets per variable
+    static const int num_sets = 7;
+
+    // Empty surface - evaluate() returns zero until build() is called
+    FuzzySurface();
+
+    // Sample the rule base on a resolution x resolution grid.
+    // e_range and ec_range map physical inputs [-range, range] onto the
+    // universe [-3, 3]; inputs outside the range are clamped.
+    void build(const int (*kp_rules)[num_sets], const int (*ki_rules)[num_sets],
+               const int (*kd_rules)[num_sets], double e_range, double ec_range,
+               int resolution = 41, double sigma = 1.0);
+
+    // Interpolated (delta_kp, delta_ki, delta_kd) in universe units, O(1)
+    void evaluate(double e, double ec, double& delta_kp, double& delta_ki, double& delta_kd) const;
+
+    // Direct Mamdani inference at a normalized (e, ec) point - reference for
+    // build() and accuracy checks
+    static void infer(const int (*kp_rules)[num_sets], const int (*ki_rules)[num_sets],
+                      const int (*kd_rules)[num_sets], double e_norm, double ec_norm,
+                      double sigma, double& delta_kp, double& delta_ki, double& delta_kd);
+
+    // Whether build() has been called
+    bool empty() const { return table.empty(); }
+
+private:
+    // Values per cell: (c0, cx, cy, cxy) for kp, ki and kd
+    static const int cell_stride = 12;
+
+    int resolution;
+    double e_scale;      // Physical error to grid coordinate
+    double ec_scale;     // Physical error rate to grid coordinate
+    double grid_offset;  // Grid coordinate of zero input
+
+    // Bilinear coefficients per cell, row-major in e then ec
+    std::vector<double> table;
+};
+
+#endif // _FUZZY_SURFACE_H_
@@ -0,0 +1,93 @@
+// Parallel controller gain optimizer definition
+#ifndef _GAIN_OPTIMIZER_H_
+#define _GAIN_OPTIMIZER_H_
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "controller_base.hpp"
+#include "system_models.hpp"
+
+// Candidate controller parameters; gamma is only used by the adaptive controller
+struct GainSet {
+    double kp;
+    double ki;
+    double kd;
+    double gamma;
+};
+
+// Controller types the optimizer can build
+enum TunedController {
+    TUNE_PID,
+    TUNE_INCREMENTAL_PID,
+    TUNE_FUZZY_PID,
+    TUNE_ADAPTIVE_PID
+};
+
+// One closed-loop step response the candidates are scored on
+struct TuningScenario {
+    std::string name;
+    std::function<std::unique_ptr<SystemModel>()> make_plant;  // Called once per evaluation
+    double setpoint;
+    double weight;
+};
+
+// Optimizer settings
+struct GainOptimizerConfig {
+    TunedController controller;
+    double dt;
+    double simulation_time;
+    GainSet lower;              // Search box
+    GainSet upper;
+    int grid_points;            // Coarse grid points per dimension
+    int num_starts;             // Nelder-Mead runs started from the best grid points
+    int max_iterations;         // Nelder-Mead iterations per start
+    double tolerance;           // Stop a start when the simplex cost spread falls below this
+    std::size_t num_threads;    // 0 for one per hardware thread
+
+    // Cost weights on top of the integral of time-weighted absolute error
+    double overshoot_weight;    // Per percent overshoot
+    double steady_state_weight; // Per unit steady-state error
+    double effort_weight;       // Per unit integral of squared control output
+};
+
+// Optimization outcome
+struct GainOptimizerResult {
+    GainSet best;
+    double best_cost;
+    std::size_t evaluations;    // Closed-loop simulations started
+    std::size_t early_stops;    // Simulations aborted once they could not beat the incumbent
+    double elapsed_seconds;
+};
+
+// Defaults: PID, test_all_controllers timing, kp [0, 10], ki [0, 5],
+// kd [0, 2], gamma [0, 0.1], 5^d grid, 8 starts
+GainOptimizerConfig default_optimizer_config(TunedController controller);
+
+// The three test_all_controllers plants; unit steps for the linear plants,
+// a 0.3 step for the nonlinear plant whose output saturates at 0.4
+std::vector<TuningScenario> default_tuning_scenarios(double dt);
+
+// Build a controller of the configured type with the given gains
+std::unique_ptr<Controller> make_tuned_controller(TunedController controller, const GainSet& gains, double dt);
+
+// Cost of one gain set summed over all scenarios. Simulation stops early
+// once the running cost exceeds cutoff; the returned cost is then a lower
+// bound that is still above cutoff.
+double evaluate_gains(const GainOptimizerConfig& config, const std::vector<TuningScenario>& scenarios,
+                      const GainSet& gains, double cutoff = HUGE_VAL, bool* stopped_early = nullptr);
+
+// Grid seeding followed by parallel multi-start Nelder-Mead. The grid is
+// evaluated across the thread pool. With at least as many starts as threads,
+// each Nelder-Mead run executes on its own thread; with fewer, the runs go
+// one after another and the independent simplex vertex evaluations (initial
+// simplex, shrink steps) are spread across the pool. Reflection, expansion
+// and contraction trials depend on each other and stay serial, so in that
+// mode the speedup is bounded by the number of dimensions. The result does
+// not depend on the number of threads.
+GainOptimizerResult optimize_gains(const GainOptimizerConfig& config, const std::vector<TuningScenario>& scenarios);
+
+#endif // _GAIN_OPTIMIZER_H_
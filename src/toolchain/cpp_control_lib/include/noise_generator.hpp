@@ -0,0 +1,116 @@
+// Reproducible multi-stream measurement noise generator definition
+#ifndef _NOISE_GENERATOR_H_
+#define _NOISE_GENERATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// xoshiro256++ pseudo random generator (Blackman and Vigna).
+// 256 bits of state, period 2^256 - 1, a few cycles per 64-bit draw.
+// Seeding goes through splitmix64 so that any (seed, stream) pair gives a
+// well mixed, non-zero state.
+class Xoshiro256pp {
+public:
+    // Constructor - independent stream `stream` of the generator family `seed`
+    explicit Xoshiro256pp(std::uint64_t seed_val = 0, std::uint64_t stream_val = 0) {
+        seed(seed_val, stream_val);
+    }
+
+    // Restart the sequence of stream `stream` of the family `seed`.
+    // The stream number is hashed into the seed, so stream k of a Monte
+    // Carlo run is the same no matter which thread or order creates it.
+    void seed(std::uint64_t seed_val, std::uint64_t stream_val = 0) {
+        std::uint64_t x = seed_val ^ splitmix64(stream_val ^ 0x6a09e667f3bcc909ULL);
+        for (int i = 0; i < 4; ++i) {
+            x += 0x9e3779b97f4a7c15ULL;
+            s[i] = splitmix64(x);
+        }
+    }
+
+    // Next 64 random bits
+    std::uint64_t next() {
+        const std::uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+        const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform double in [0, 1) with 53 random bits
+    double uniform() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Advance by 2^128 draws; 2^128 calls of next() never overlap the next jump
+    void jump();
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static std::uint64_t splitmix64(std::uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    std::uint64_t s[4];
+};
+
+// Noise settings, defaults match test_all_controllers
+struct NoiseConfig {
+    double mean;                    // Mean value for Gaussian noise
+    double std_dev;                 // Standard deviation for Gaussian noise
+    double max_impulse_amplitude;   // Impulses are uniform in [-max, max)
+    double impulse_probability;     // Probability of an impulse per sample
+
+    NoiseConfig(double mean_val = 0.0, double std_dev_val = 0.05,
+                double max_impulse_val = 0.2, double impulse_prob_val = 0.02)
+        : mean(mean_val), std_dev(std_dev_val),
+          max_impulse_amplitude(max_impulse_val), impulse_probability(impulse_prob_val) {}
+};
+
+// Gaussian plus impulse measurement noise on its own random stream.
+// Each simulation run owns one NoiseStream, so parallel runs need no shared
+// RNG state and a run's noise depends only on (seed, stream), never on
+// thread scheduling. Gaussian samples use the 128-layer ziggurat method,
+// which needs one 64-bit draw and no transcendental function for ~99% of
+// samples. The fill functions write batches into caller buffers and produce
+// exactly the sequence that the same number of scalar calls would.
+class NoiseStream {
+public:
+    NoiseStream(const NoiseConfig& config_val = NoiseConfig(),
+                std::uint64_t seed_val = 0, std::uint64_t stream_val = 0);
+
+    // Restart the stream
+    void seed(std::uint64_t seed_val, std::uint64_t stream_val = 0) {
+        rng.seed(seed_val, stream_val);
+    }
+
+    // Single samples
+    double gaussian();                  // mean + std_dev * N(0, 1)
+    double impulse();                   // 0, or an impulse with impulse_probability
+    double combined();                  // gaussian() + impulse()
+
+    // Batches into out[0..count)
+    void fillGaussian(double* out, std::size_t count);
+    void fillImpulse(double* out, std::size_t count);
+    void fillCombined(double* out, std::size_t count);
+
+    // Standard normal sample
+    double standardNormal();
+
+    const NoiseConfig& getConfig() const { return config; }
+    Xoshiro256pp& generator() { return rng; }
+
+private:
+    NoiseConfig config;
+    Xoshiro256pp rng;
+};
+
+#endif // _NOISE_GENERATOR_H_
@@ -0,0 +1,130 @@
+// Runge-Kutta ODE solvers for plant simulation (header-only)
+#ifndef _ODE_SOLVERS_H_
+#define _ODE_SOLVERS_H_
+
+#include <cmath>
+#include <cstddef>
+
+// C++ versions of src/math_foundations/ODE_Solvers/runge_kutta/rk4.m and
+// rkf45.m for small fixed-size systems. The state is a plain double[N] and
+// f is any callable f(t, y, dydt) writing dy/dt for state y at time t.
+
+// Solver work counters
+struct OdeStats {
+    std::size_t evaluations;    // Calls of f
+    std::size_t accepted;       // Accepted steps
+    std::size_t rejected;       // Rejected RKF45 steps
+
+    OdeStats() : evaluations(0), accepted(0), rejected(0) {}
+};
+
+// One classical fourth-order Runge-Kutta step of size h, y updated in place
+template <int N, typename F>
+void rk4_step(F& f, double t, double* y, double h, OdeStats* stats = nullptr)
+{
+    double k1[N], k2[N], k3[N], k4[N], tmp[N];
+    f(t, y, k1);
+    for (int i = 0; i < N; ++i) tmp[i] = y[i] + h * k1[i] / 2;
+    f(t + h / 2, tmp, k2);
+    for (int i = 0; i < N; ++i) tmp[i] = y[i] + h * k2[i] / 2;
+    f(t + h / 2, tmp, k3);
+    for (int i = 0; i < N; ++i) tmp[i] = y[i] + h * k3[i];
+    f(t + h, tmp, k4);
+    for (int i = 0; i < N; ++i) y[i] += h * (k1[i] + 2 * k2[i] + 2 * k3[i] + k4[i]) / 6;
+
+    if (stats) {
+        stats->evaluations += 4;
+        ++stats->accepted;
+    }
+}
+
+// Runge-Kutta-Fehlberg 4(5) settings, defaults as in rkf45.m
+struct Rkf45Options {
+    double tol;         // Bound on the norm of the local error estimate
+    double h_min;       // Smallest step; a step of h_min is accepted regardless of error
+    double h_max;       // Largest step
+
+    Rkf45Options(double tol_val = 1e-6, double h_min_val = 1e-10, double h_max_val = 1e3)
+        : tol(tol_val), h_min(h_min_val), h_max(h_max_val) {}
+};
+
+// Integrate y from t0 to t_end with adaptive RKF45 substeps.
+// h is the initial step on entry and the proposed next step on return, so
+// repeated calls over consecutive sample periods keep the adapted step size.
+// Like rkf45.m, the local error is the 2-norm of y5 - y4 and y5 is kept.
+template <int N, typename F>
+void rkf45_integrate(F& f, double t0, double t_end, double* y, double& h,
+                     const Rkf45Options& options = Rkf45Options(), OdeStats* stats = nullptr)
+{
+    static const double a[6] = {0.0, 1.0 / 4, 3.0 / 8, 12.0 / 13, 1.0, 1.0 / 2};
+    static const double b[6][5] = {
+        {0, 0, 0, 0, 0},
+        {1.0 / 4, 0, 0, 0, 0},
+        {3.0 / 32, 9.0 / 32, 0, 0, 0},
+        {1932.0 / 2197, -7200.0 / 2197, 7296.0 / 2197, 0, 0},
+        {439.0 / 216, -8.0, 3680.0 / 513, -845.0 / 4104, 0},
+        {-8.0 / 27, 2.0, -3544.0 / 2565, 1859.0 / 4104, -11.0 / 40}
+    };
+    static const double c4[6] = {25.0 / 216, 0, 1408.0 / 2565, 2197.0 / 4104, -1.0 / 5, 0};
+    static const double c5[6] = {16.0 / 135, 0, 6656.0 / 12825, 28561.0 / 56430, -9.0 / 50, 2.0 / 55};
+    const double safety = 0.9;
+    const double max_factor = 5.0;
+    const double min_factor = 0.2;
+
+    if (!(h > 0.0)) h = t_end - t0;
+    double t = t0;
+    while (t < t_end) {
+        // Make sure the last step does not pass t_end
+        double step = h;
+        bool last = t + step >= t_end;
+        if (last) step = t_end - t;
+
+        double k[6][N], tmp[N];
+        for (int s = 0; s < 6; ++s) {
+            for (int i = 0; i < N; ++i) {
+                double sum = y[i];
+                for (int j = 0; j < s; ++j) sum += b[s][j] * k[j][i];
+                tmp[i] = sum;
+            }
+            f(t + a[s] * step, tmp, k[s]);
+            for (int i = 0; i < N; ++i) k[s][i] *= step;
+        }
+        if (stats) stats->evaluations += 6;
+
+        double y5[N], error = 0.0;
+        for (int i = 0; i < N; ++i) {
+            double y4 = y[i], fifth = y[i];
+            for (int s = 0; s < 6; ++s) {
+                y4 += c4[s] * k[s][i];
+                fifth += c5[s] * k[s][i];
+            }
+            y5[i] = fifth;
+            error += (fifth - y4) * (fifth - y4);
+        }
+        error = std::sqrt(error);
+
+        double h_new;
+        if (error < options.tol || step <= options.h_min) {
+            // Step accepted
+            t = last ? t_end : t + step;
+            for (int i = 0; i < N; ++i) y[i] = y5[i];
+            if (stats) ++stats->accepted;
+
+            if (step < h) {
+                // A final step shortened to hit t_end says nothing about the
+                // step size that works; keep the previous proposal
+                h_new = h;
+            } else {
+                h_new = error == 0.0 ? step * max_factor : safety * step * std::pow(options.tol / error, 0.2);
+                h_new = std::fmin(std::fmax(h_new, min_factor * step), max_factor * step);
+            }
+        } else {
+            // Step rejected, retry with a smaller step
+            h_new = std::fmax(safety * step * std::pow(options.tol / error, 0.2), min_factor * step);
+            if (stats) ++stats->rejected;
+        }
+        h = std::fmax(std::fmin(h_new, options.h_max), options.h_min);
+    }
+}
+
+#endif // _ODE_SOLVERS_H_
@@ -0,0 +1,96 @@
+// Lock-free parameter block for hot-swapping controller settings (header-only)
+#ifndef _PARAMETER_SEQLOCK_H_
+#define _PARAMETER_SEQLOCK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Single-writer, single-reader seqlock holding a trivially copyable value.
+// The tuning thread calls publish(); the control thread calls poll() once
+// per cycle. poll() never blocks or spins: when nothing new was published it
+// costs one acquire load, and when it overlaps a publish() it reports no
+// update so the control thread keeps its current value and picks up the new
+// one at the next cycle boundary.
+// The payload is stored in relaxed atomic words, so the overlapping copy is
+// a detected retry rather than a data race.
+template <typename T>
+class ParameterSeqlock {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "ParameterSeqlock requires a trivially copyable type");
+
+    ParameterSeqlock() : sequence(0), seen_sequence(0)
+    {
+        for (std::size_t i = 0; i < num_words; ++i) {
+            words[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Copies carry over any value not yet polled. Copying is not synchronized
+    // with publish(), so copy controllers before sharing them with a tuning thread.
+    ParameterSeqlock(const ParameterSeqlock& other) : sequence(0), seen_sequence(0)
+    {
+        *this = other;
+    }
+
+    ParameterSeqlock& operator=(const ParameterSeqlock& other)
+    {
+        for (std::size_t i = 0; i < num_words; ++i) {
+            words[i].store(other.words[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        sequence.store(other.sequence.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        seen_sequence = other.seen_sequence;
+        return *this;
+    }
+
+    // Publish a new value - tuning thread only
+    void publish(const T& value)
+    {
+        std::uint64_t buffer[num_words] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+
+        std::uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < num_words; ++i) {
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // Copy out a value published since the last successful poll - control
+    // thread only. Returns false when there is nothing new or a publish is in
+    // progress.
+    bool poll(T& value)
+    {
+        std::uint32_t before = sequence.load(std::memory_order_acquire);
+        if (before == seen_sequence || (before & 1u) != 0) {
+            return false;
+        }
+
+        std::uint64_t buffer[num_words];
+        for (std::size_t i = 0; i < num_words; ++i) {
+            buffer[i] = words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+
+        std::memcpy(&value, buffer, sizeof(T));
+        seen_sequence = before;
+        return true;
+    }
+
+private:
+    static const std::size_t num_words = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    std::atomic<std::uint32_t> sequence;
+    std::atomic<std::uint64_t> words[num_words];
+
+    // Last sequence consumed by the reader
+    std::uint32_t seen_sequence;
+};
+
+#endif // _PARAMETER_SEQLOCK_H_
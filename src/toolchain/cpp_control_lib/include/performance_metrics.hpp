@@ -0,0 +1,221 @@
+// Closed-loop step response performance metrics (header-only)
+#ifndef _PERFORMANCE_METRICS_H_
+#define _PERFORMANCE_METRICS_H_
+
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include "columnar_file.hpp"
+
+// Performance metrics calculation class
+// Metrics are accumulated online in O(1) time and memory per sample, so the
+// class can run for arbitrarily long simulations or live next to a
+// controller. Step response metrics (rise time, overshoot, settling time,
+// steady-state error) refer to the current setpoint and restart whenever
+// the setpoint changes. Error and effort integrals cover the whole run and
+// use the interval since the previous sample, so the first sample adds nothing.
+class PerformanceMetrics {
+private:
+    std::size_t samples;
+    double prev_time;
+    double last_process_val;
+
+    // Step response of the current setpoint segment
+    double final_value;
+    bool low_crossed;
+    bool risen;
+    double rise_time;
+    double max_value;
+    bool settling;          // All samples since settling_start are in the 2% band
+    double settling_start;
+
+    // Integrals over the whole run
+    double iae;
+    double ise;
+    double itae;
+    double effort;
+
+    // Optional CSV and columnar output written while samples arrive
+    std::ofstream outfile;
+    std::unique_ptr<ColumnarWriter> columnar;
+
+    // Start step response metrics for a new setpoint
+    void start_segment(double sp) {
+        final_value = sp;
+        low_crossed = false;
+        risen = false;
+        rise_time = 0.0;
+        max_value = -std::numeric_limits<double>::infinity();
+        settling = false;
+        settling_start = 0.0;
+    }
+
+public:
+    PerformanceMetrics() {
+        reset();
+    }
+
+    // Clear all metrics; open output files stay open
+    void reset() {
+        samples = 0;
+        prev_time = 0.0;
+        last_process_val = 0.0;
+        iae = 0.0;
+        ise = 0.0;
+        itae = 0.0;
+        effort = 0.0;
+        start_segment(0.0);
+    }
+
+    // Add data point
+    void add_data_point(double t, double sp, double pv, double u) {
+        if (samples == 0 || sp != final_value) {
+            start_segment(sp);
+        }
+
+        // Rise time (from 10% to 90% of final value)
+        if (!risen) {
+            if (!low_crossed) {
+                low_crossed = pv >= 0.1 * final_value;
+            } else if (pv >= 0.9 * final_value) {
+                risen = true;
+                rise_time = t;
+            }
+        }
+
+        // Peak for overshoot
+        if (pv > max_value) {
+            max_value = pv;
+        }
+
+        // Settling time (time to enter 2% error band for good)
+        double tolerance = 0.02 * final_value;
+        if (pv >= final_value - tolerance && pv <= final_value + tolerance) {
+            if (!settling) {
+                settling = true;
+                settling_start = t;
+            }
+        } else {
+            settling = false;
+        }
+
+        // Error and effort integrals
+        if (samples > 0) {
+            double dt = t - prev_time;
+            double abs_err = std::fabs(sp - pv);
+            iae += abs_err * dt;
+            ise += abs_err * abs_err * dt;
+            itae += t * abs_err * dt;
+            effort += u * u * dt;
+        }
+
+        if (outfile.is_open()) {
+            outfile << t << "," << sp << "," << pv << "," << u << "\n";
+        }
+        if (columnar) {
+            const double row[4] = {t, sp, pv, u};
+            columnar->appendRow(row);
+        }
+
+        prev_time = t;
+        last_process_val = pv;
+        ++samples;
+    }
+
+    // Number of data points added
+    std::size_t sample_count() const {
+        return samples;
+    }
+
+    // Calculate rise time (from 10% to 90% of final value)
+    double calculate_rise_time() const {
+        return rise_time;
+    }
+
+    // Calculate overshoot percentage
+    double calculate_overshoot() const {
+        if (samples == 0 || max_value <= final_value) {
+            return 0.0; // No overshoot
+        }
+        return ((max_value - final_value) / final_value) * 100.0;
+    }
+
+    // Calculate settling time (time to enter 2% error band), 0 if not settled
+    double calculate_settling_time() const {
+        return settling ? settling_start : 0.0;
+    }
+
+    // Calculate steady state error
+    double calculate_steady_state_error() const {
+        if (samples == 0) return 0.0;
+        return std::fabs(final_value - last_process_val);
+    }
+
+    // Integral of absolute error
+    double calculate_iae() const {
+        return iae;
+    }
+
+    // Integral of squared error
+    double calculate_ise() const {
+        return ise;
+    }
+
+    // Integral of time-weighted absolute error
+    double calculate_itae() const {
+        return itae;
+    }
+
+    // Control effort - integral of squared controller output
+    double calculate_control_effort() const {
+        return effort;
+    }
+
+    // Write every following data point to a CSV file as it is added
+    bool stream_to_file(const std::string& filename) {
+        outfile.close();
+        outfile.open(filename);
+        if (!outfile.is_open()) {
+            std::cerr << "Failed to open file: " << filename << std::endl;
+            return false;
+        }
+
+        // Write header
+        outfile << "time,setpoint,process_val,output\n";
+        return true;
+    }
+
+    // Write every following data point to a columnar binary file (.ccol)
+    // with float64 columns time, setpoint, process_val and output
+    bool stream_to_columnar(const std::string& filename) {
+        columnar.reset(new ColumnarWriter());
+        columnar->addColumn("time", COLUMN_FLOAT64);
+        columnar->addColumn("setpoint", COLUMN_FLOAT64);
+        columnar->addColumn("process_val", COLUMN_FLOAT64);
+        columnar->addColumn("output", COLUMN_FLOAT64);
+        if (!columnar->open(filename)) {
+            columnar.reset();
+            return false;
+        }
+        return true;
+    }
+
+    // Print performance metrics
+    void print_metrics(const std::string& controller_name) const {
+        std::cout << "\n=== " << controller_name << " Performance Metrics ===" << std::endl;
+        std::cout << "Rise Time: " << calculate_rise_time() << " seconds" << std::endl;
+        std::cout << "Overshoot: " << calculate_overshoot() << "%" << std::endl;
+        std::cout << "Settling Time: " << calculate_settling_time() << " seconds" << std::endl;
+        std::cout << "Steady State Error: " << calculate_steady_state_error() << std::endl;
+        std::cout << "IAE: " << calculate_iae() << std::endl;
+        std::cout << "ISE: " << calculate_ise() << std::endl;
+        std::cout << "ITAE: " << calculate_itae() << std::endl;
+        std::cout << "Control Effort: " << calculate_control_effort() << std::endl;
+    }
+};
+
+#endif // _PERFORMANCE_METRICS_H_
@@ -0,0 +1,52 @@
+// Batched PID controller bank definition
+#ifndef _PID_BANK_H_
+#define _PID_BANK_H_
+
+#include <cstddef>
+
+// Position PID for N joints stored as structure-of-arrays.
+// All per-joint state lives in contiguous, cache-line aligned arrays so that
+// one compute() call updates every joint in a single vectorizable pass.
+// Numerically equivalent to running N independent PIDController objects.
+class PIDBank {
+public:
+    // Alignment of every per-joint array in bytes
+    static const std::size_t alignment = 64;
+
+    // Constructor - all joints start with the given gains
+    PIDBank(std::size_t num_joints, double kp_val, double ki_val, double kd_val, double dt_val);
+
+    // Destructor
+    ~PIDBank();
+
+    // Set gains for one joint
+    void setGains(std::size_t joint, double kp_val, double ki_val, double kd_val);
+
+    // Calculate outputs for all joints
+    // setpoints, process_vals and outputs must each hold size() elements
+    void compute(const double* setpoints, const double* process_vals, double* outputs);
+
+    // Reset integral and derivative history of all joints
+    void reset();
+
+    // Number of joints in the bank
+    std::size_t size() const { return num_joints; }
+
+private:
+    PIDBank(const PIDBank&) = delete;
+    PIDBank& operator=(const PIDBank&) = delete;
+
+    std::size_t num_joints;
+    double dt;
+    double inv_dt;
+
+    // Backing storage and aligned per-joint arrays carved out of it
+    char* storage;
+    double* kp;
+    double* ki;
+    double* kd;
+    double* integral;
+    double* prev_pv;
+};
+
+#endif // _PID_BANK_H_
@@ -3,63 +3,163 @@
 #define _PID_CONTROLLER_H_
 
 #include "controller_base.hpp"
+#include "controller_state.hpp"
+#include "fixed_point.hpp"
+#include "fuzzy_surface.hpp"
+#include "parameter_seqlock.hpp"
+
+// All controllers are templates on the numeric type Real and are explicitly
+// instantiated in pid_controller.cpp for double, float and Q16_16; the
+// position and incremental PID controllers also for Q1_31.
+// Constructor parameters stay double: configuration happens once, and dt
+// scaled gains and reciprocals are precomputed there so compute() never
+// divides. With fixed-point types every operation saturates, so the
+// integrators clip at the range limit instead of wrapping, and integrator
+// increments below one resolution step are carried (see accumulate_product)
+// so small steady-state errors are still integrated out.
+
+// Runtime parameter set of PIDControllerT
+struct PIDParameters {
+    double kp;
+    double ki;
+    double kd;
+    double dt;
+    double output_min;
+    double output_max;
+};
+
+// Runtime parameter set of AdaptivePIDControllerT, including the range the
+// adapted gains are limited to
+struct AdaptivePIDParameters {
+    double kp;
+    double ki;
+    double kd;
+    double dt;
+    double gamma;
+    double kp_min;
+    double kp_max;
+    double ki_min;
+    double ki_max;
+    double kd_min;
+    double kd_max;
+};
 
 // Position PID controller
-class PIDController : public Controller {
+template <typename Real>
+class PIDControllerT : public ControllerT<Real> {
 public:
-    // Constructor
-    PIDController(double kp_val, double ki_val, double kd_val, double dt_val);
-    
+    // Constructor, output unlimited
+    PIDControllerT(double kp_val, double ki_val, double kd_val, double dt_val);
+
     // Calculate PID output
-    double compute(double setpoint, double process_val) override;
-    
+    Real compute(Real setpoint, Real process_val) override;
+
     // Reset controller
     void reset() override;
 
+    // Binary state snapshot for warm restart, see controller_state.hpp
+    std::size_t stateSize() const override;
+    std::size_t saveState(void* buffer, std::size_t capacity) const override;
+    bool restoreState(const void* buffer, std::size_t size) override;
+    bool checkState(const void* buffer, std::size_t size) const override;
+
+    // Publish a new parameter set - safe to call from a tuning thread while
+    // another thread runs compute(). The set is applied at the start of the
+    // next compute() with bumpless transfer: the proportional change is moved
+    // into the integral so the output does not jump. The integral already
+    // holds ki * err * dt, so ki and dt changes only affect future increments.
+    void setParameters(const PIDParameters& params);
+
+    // Parameter set currently in use - control thread only
+    PIDParameters parameters() const;
+
 private:
-    double kp;
-    double ki;
-    double kd;
-    double dt;
-    double prev_err;
-    double integral;
-    double prev_pv;
+    // Members saved in state snapshots
+    static Real PIDControllerT::* const state_fields[12];
+
+    // Switch to a published parameter set
+    void applyParameters(const PIDParameters& params);
+
+    Real kp;
+    Real ki;
+    Real kd;
+    Real dt;
+    Real ki_dt;
+    Real kd_over_dt;
+    Real output_min;
+    Real output_max;
+    Real prev_err;
+    Real integral;
+    Real integral_residue;
+    Real prev_pv;
+
+    // Parameter sets published by setParameters()
+    ParameterSeqlock<PIDParameters> pending;
 };
 
 // Incremental PID controller
-class IncrementalPIDController : public Controller {
+template <typename Real>
+class IncrementalPIDControllerT : public ControllerT<Real> {
 public:
     // Constructor
-    IncrementalPIDController(double kp_val, double ki_val, double kd_val, double dt_val);
-    
+    IncrementalPIDControllerT(double kp_val, double ki_val, double kd_val, double dt_val);
+
     // Calculate PID output
-    double compute(double setpoint, double process_val) override;
-    
+    Real compute(Real setpoint, Real process_val) override;
+
     // Reset controller
     void reset() override;
 
+    // Binary state snapshot for warm restart, see controller_state.hpp
+    std::size_t stateSize() const override;
+    std::size_t saveState(void* buffer, std::size_t capacity) const override;
+    bool restoreState(const void* buffer, std::size_t size) override;
+    bool checkState(const void* buffer, std::size_t size) const override;
+
 private:
-    double kp;
-    double ki;
-    double kd;
-    double dt;
-    double prev_err1;
-    double prev_err2;
+    // Members saved in state snapshots
+    static Real IncrementalPIDControllerT::* const state_fields[5];
+
+    Real kp;
+    Real ki_dt;
+    Real kd_over_dt;
+    Real prev_err1;
+    Real prev_err2;
 };
 
 // Fuzzy PID controller
-class FuzzyPIDController : public Controller {
+template <typename Real>
+class FuzzyPIDControllerT : public ControllerT<Real> {
 public:
+    // Fuzzy inference mode
+    enum InferenceMode {
+        CRISP,   // Interval fuzzification and direct rule lookup
+        SMOOTH   // Gaussian Mamdani inference, precomputed surface with bilinear interpolation
+    };
+
     // Constructor
-    FuzzyPIDController(double kp_val, double ki_val, double kd_val, double dt_val);
-    
+    // In SMOOTH mode e and ec are normalized from [-e_range, e_range] and
+    // [-ec_range, ec_range] onto the fuzzy universe [-3, 3]. The surface is
+    // evaluated in double, so SMOOTH mode targets hosts with a double FPU.
+    FuzzyPIDControllerT(double kp_val, double ki_val, double kd_val, double dt_val,
+                        InferenceMode mode_val = CRISP, double e_range = 3.0, double ec_range = 3.0);
+
     // Calculate PID output
-    double compute(double setpoint, double process_val) override;
-    
+    Real compute(Real setpoint, Real process_val) override;
+
     // Reset controller
     void reset() override;
 
+    // Binary state snapshot for warm restart, see controller_state.hpp
+    std::size_t stateSize() const override;
+    std::size_t saveState(void* buffer, std::size_t capacity) const override;
+    bool restoreState(const void* buffer, std::size_t size) override;
+    bool checkState(const void* buffer, std::size_t size) const override;
+
 private:
+    // Members saved in state snapshots
+    static Real FuzzyPIDControllerT::* const state_fields[7];
+
     // Fuzzy variable enumeration
     enum FuzzyVariable {
         NB = -3,  // Negative Big
@@ -70,83 +170,160 @@ private:
         PM = 2,   // Positive Medium
         PB = 3    // Positive Big
     };
-    
+
     // Calculate membership function - Gaussian function
     double gaussian(double x, double mean, double sigma);
-    
+
     // Fuzzification - convert precise value to fuzzy value
-    void fuzzify(double err, double err_dot, FuzzyVariable& fuzzy_err, FuzzyVariable& fuzzy_err_dot);
-    
+    // The error change is compared against dt-scaled thresholds, which is
+    // equivalent to fuzzifying the error rate without dividing by dt
+    void fuzzify(Real err, Real err_change, FuzzyVariable& fuzzy_err, FuzzyVariable& fuzzy_err_dot);
+
+    // Map a value onto a fuzzy variable using six ascending interval bounds
+    static FuzzyVariable quantize(Real value, const Real* bounds);
+
     // Fuzzy rule table - determine PID parameter adjustment based on error and error change rate
-    void getFuzzyRules(FuzzyVariable fuzzy_err, FuzzyVariable fuzzy_err_dot, 
+    void getFuzzyRules(FuzzyVariable fuzzy_err, FuzzyVariable fuzzy_err_dot,
                      FuzzyVariable& delta_kp, FuzzyVariable& delta_ki, FuzzyVariable& delta_kd);
-    
+
     // Defuzzification - convert fuzzy value to precise value
     double defuzzify(FuzzyVariable fuzzy_value, double range);
-    
-    // Calculate error change rate
-    double calculateErrorDot(double err, double prev_err);
-    
+
     // PID parameters
-    double kp;
-    double ki;
-    double kd;
+    Real kp;
+    Real ki_dt;
+    Real kd_over_dt;
     double dt;
-    
+
     // Error history
-    double prev_err;
-    double prev_pv;
-    double integral;
-    
+    Real prev_err;
+    Real prev_pv;
+    Real integral;
+    Real integral_residue;
+
+    // Fuzzification interval bounds for error and per-cycle error change
+    Real err_bounds[6];
+    Real err_change_bounds[6];
+
+    // Defuzzified gain adjustment per fuzzy level, already scaled by dt
+    Real delta_kp_levels[7];
+    Real delta_ki_dt_levels[7];
+    Real delta_kd_over_dt_levels[7];
+
     // Fuzzy rule database
     static const int rule_table_size = 7;
     int delta_kp_rules[7][7];
     int delta_ki_rules[7][7];
     int delta_kd_rules[7][7];
+
+    // Inference mode and precomputed surface (SMOOTH mode only)
+    InferenceMode mode;
+    FuzzySurface surface;
 };
 
 // Adaptive PID controller - using MIT rule
-class AdaptivePIDController : public Controller {
+template <typename Real>
+class AdaptivePIDControllerT : public ControllerT<Real> {
 public:
     // Constructor
-    AdaptivePIDController(double kp_val, double ki_val, double kd_val, double dt_val, double gamma_val = 0.01);
-    
+    AdaptivePIDControllerT(double kp_val, double ki_val, double kd_val, double dt_val, double gamma_val = 0.01);
+
     // Calculate PID output
-    double compute(double setpoint, double process_val) override;
-    
+    Real compute(Real setpoint, Real process_val) override;
+
     // Reset controller
     void reset() override;
 
+    // Binary state snapshot for warm restart, see controller_state.hpp
+    std::size_t stateSize() const override;
+    std::size_t saveState(void* buffer, std::size_t capacity) const override;
+    bool restoreState(const void* buffer, std::size_t size) override;
+    bool checkState(const void* buffer, std::size_t size) const override;
+
+    // Publish a new parameter set - safe to call from a tuning thread while
+    // another thread runs compute(). The set is applied at the start of the
+    // next compute(): the adapted gains restart from the published ones,
+    // limited to the published ranges, with the same bumpless transfer as
+    // PIDControllerT.
+    void setParameters(const AdaptivePIDParameters& params);
+
+    // Parameter set currently in use, with the adapted gains - control thread only
+    AdaptivePIDParameters parameters() const;
+
 private:
+    // Members saved in state snapshots
+    static Real AdaptivePIDControllerT::* const state_fields[19];
+
+    // Switch to a published parameter set
+    void applyParameters(const AdaptivePIDParameters& params);
+
     // PID parameters
-    double kp;
-    double ki;
-    double kd;
-    double dt;
-    
+    Real kp;
+    Real ki;
+    Real kd;
+    Real dt;
+    Real ki_dt;      // ki * dt, updated whenever ki adapts
+    Real inv_dt;
+
     // Adaptive gain
-    double gamma;
-    
+    Real gamma;
+
+    // Adapted gain ranges
+    Real kp_min;
+    Real kp_max;
+    Real ki_min;
+    Real ki_max;
+    Real kd_min;
+    Real kd_max;
+
+    // Parameter sets published by setParameters()
+    ParameterSeqlock<AdaptivePIDParameters> pending;
+
     // Error history
-    double prev_err;
-    double prev_pv;
-    double integral;
-    
+    Real prev_err;
+    Real prev_pv;
+    Real integral;
+    Real integral_residue;
+
     // Used to calculate partial derivatives of error with respect to parameters
-    double prev_u;
-    double prev_process_val;
-    
+    Real prev_u;
+    Real prev_process_val;
+
     // Performance index calculation - simple implementation: error squared
-    double performance_index(double err);
-    
+    Real performance_index(Real err);
+
     // Calculate partial derivative of error with respect to Kp
-    double d_err_d_kp(double err, double prev_err, double process_val, double prev_process_val);
-    
+    Real d_err_d_kp(Real err, Real prev_err, Real process_val, Real prev_process_val);
+
     // Calculate partial derivative of error with respect to Ki
-    double d_err_d_ki(double err, double prev_err, double process_val, double prev_process_val);
-    
+    Real d_err_d_ki(Real err, Real prev_err, Real process_val, Real prev_process_val);
+
     // Calculate partial derivative of error with respect to Kd
-    double d_err_d_kd(double err, double prev_err, double process_val, double prev_process_val);
+    Real d_err_d_kd(Real err, Real prev_err, Real process_val, Real prev_process_val);
 };
 
-#endif // _PID_CONTROLLER_H_
\ No newline at end of file
+// Double precision controllers
+typedef PIDControllerT<double> PIDController;
+typedef IncrementalPIDControllerT<double> IncrementalPIDController;
+typedef FuzzyPIDControllerT<double> FuzzyPIDController;
+typedef AdaptivePIDControllerT<double> AdaptivePIDController;
+
+// Single precision controllers for MCUs with a single-precision FPU
+typedef PIDControllerT<float> PIDControllerF;
+typedef IncrementalPIDControllerT<float> IncrementalPIDControllerF;
+typedef FuzzyPIDControllerT<float> FuzzyPIDControllerF;
+typedef AdaptivePIDControllerT<float> AdaptivePIDControllerF;
+
+// Q16.16 fixed-point controllers
+typedef PIDControllerT<Q16_16> PIDControllerQ16;
+typedef IncrementalPIDControllerT<Q16_16> IncrementalPIDControllerQ16;
+typedef FuzzyPIDControllerT<Q16_16> FuzzyPIDControllerQ16;
+typedef AdaptivePIDControllerT<Q16_16> AdaptivePIDControllerQ16;
+
+// Q1.31 fixed-point controllers - gains, dt-scaled gains and signals in [-1, 1).
+// There are no Q1.31 fuzzy or adaptive controllers: their gain adjustments
+// and adapted gain ranges (kp up to 15) do not fit in [-1, 1).
+typedef PIDControllerT<Q1_31> PIDControllerQ31;
+typedef IncrementalPIDControllerT<Q1_31> IncrementalPIDControllerQ31;
+
+#endif // _PID_CONTROLLER_H_
@@ -0,0 +1,93 @@
+// Batched plant simulator definition
+#ifndef _PLANT_BANK_H_
+#define _PLANT_BANK_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Plant model simulated by a PlantBank
+enum PlantType {
+    PLANT_FIRST_ORDER,      // FirstOrderSystem
+    PLANT_SECOND_ORDER,     // SecondOrderSystem
+    PLANT_NONLINEAR         // NonlinearSystem (saturation + deadzone)
+};
+
+// N plants of one model type stepped in lockstep, stored as
+// structure-of-arrays. Parameters are folded into per-plant coefficients
+// when they are set, so one step() call is a single branch-free,
+// vectorizable pass over aligned arrays. Each plant produces bit-identical
+// outputs to the corresponding scalar model in system_models.hpp.
+// Meant for robustness studies over thousands of perturbed plants,
+// typically driven by a PIDBank of the same size.
+class PlantBank {
+public:
+    // Alignment of every per-plant array in bytes
+    static const std::size_t alignment = 64;
+
+    // Constructor - all plants start with the nominal parameters of
+    // test_all_controllers: K = 1, T = 1, zeta = 0.7, omega_n = 1,
+    // saturation limit 0.5 and deadzone width 0.1
+    PlantBank(PlantType type_val, std::size_t num_plants, double dt_val);
+
+    // Destructor
+    ~PlantBank();
+
+    // Set parameters of one plant, in the argument order of the scalar models.
+    // Only the parameters of the bank's model type are used.
+    void setFirstOrder(std::size_t plant, double T_val, double K_val);
+    void setSecondOrder(std::size_t plant, double K_val, double zeta_val, double omega_n_val);
+    void setNonlinear(std::size_t plant, double K_val, double T_val,
+                      double saturation_limit_val, double deadzone_width_val);
+
+    // Multiply every parameter of every plant by an independent factor drawn
+    // uniformly from [1 - spread, 1 + spread]. Reproducible for a given seed.
+    void perturb(double spread, std::uint64_t seed);
+
+    // Advance all plants by one sample period
+    // inputs and outputs must each hold size() elements
+    void step(const double* inputs, double* outputs);
+
+    // Reset the state of all plants
+    void reset();
+
+    // Current output of one plant
+    double output(std::size_t plant) const { return y[plant]; }
+
+    // Number of plants in the bank
+    std::size_t size() const { return num_plants; }
+
+    PlantType type() const { return plant_type; }
+
+private:
+    PlantBank(const PlantBank&) = delete;
+    PlantBank& operator=(const PlantBank&) = delete;
+
+    // Recompute the step coefficients of one plant from its parameters
+    void updateCoefficients(std::size_t plant);
+
+    PlantType plant_type;
+    std::size_t num_plants;
+    double dt;
+
+    // Backing storage and aligned per-plant arrays carved out of it
+    char* storage;
+
+    // Parameters
+    double* gain;
+    double* time_constant;
+    double* zeta;
+    double* omega_n;
+    double* saturation_limit;
+    double* deadzone_width;
+
+    // Step coefficients
+    double* c0;     // first order: dt/T        second order: K*omega_n^2
+    double* c1;     // first order: K           second order: 2*zeta*omega_n
+    double* c2;     //                          second order: omega_n^2
+
+    // State
+    double* y;      // Output
+    double* dy;     // Output derivative (second order)
+};
+
+#endif // _PLANT_BANK_H_
@@ -0,0 +1,106 @@
+// Concurrent controller x plant x noise scenario matrix runner definition
+#ifndef _SCENARIO_RUNNER_H_
+#define _SCENARIO_RUNNER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "gain_optimizer.hpp"
+#include "noise_generator.hpp"
+#include "plant_bank.hpp"
+
+// Output written for every cell
+enum ScenarioOutput {
+    SCENARIO_OUTPUT_NONE,
+    SCENARIO_OUTPUT_CSV,
+    SCENARIO_OUTPUT_CCOL
+};
+
+// Scenario matrix, normally loaded from a config file of `key = value` lines
+// ('#' starts a comment, lists are comma separated):
+//
+//   controllers = pid, incremental_pid, fuzzy_pid, adaptive_pid
+//   plants      = first_order, second_order, nonlinear
+//   noise       = off, on
+//   seeds       = 1, 2, 3            # Unsigned 64-bit, only used by cells with noise on
+//   durations   = 20, 100            # Simulated seconds
+//   dt = 0.1, setpoint = 1, kp/ki/kd/gamma, noise_mean, noise_std_dev,
+//   noise_max_impulse, noise_impulse_probability, integration (euler, rk4, rkf45),
+//   output (none, csv, ccol), output_prefix, threads (0 = one per hardware thread)
+//
+// Defaults reproduce the test_all_controllers setup.
+struct ScenarioMatrix {
+    std::vector<TunedController> controllers;
+    std::vector<PlantType> plants;
+    std::vector<bool> noise;
+    std::vector<std::uint64_t> seeds;
+    std::vector<double> durations;
+
+    double dt;
+    double setpoint;
+    GainSet gains;
+    NoiseConfig noise_config;
+    IntegrationMethod integration;
+    ScenarioOutput output;
+    std::string output_prefix;
+    std::size_t num_threads;
+
+    ScenarioMatrix();
+};
+
+// One controller x plant x noise x seed x duration cell
+struct ScenarioCell {
+    TunedController controller;
+    PlantType plant;
+    bool noise;
+    std::uint64_t seed;
+    double duration;
+};
+
+// Metrics of one finished cell
+struct ScenarioResult {
+    ScenarioCell cell;
+    double rise_time;
+    double overshoot;
+    double settling_time;
+    double steady_state_error;
+    double iae;
+    double ise;
+    double itae;
+    double control_effort;
+    std::string output_file;    // Empty without output
+    bool ok;                    // False if the output file could not be opened; the cell did not run
+};
+
+// Names used in config files and reports
+const char* scenario_controller_name(TunedController controller);
+const char* scenario_plant_name(PlantType plant);
+
+// Parse a config; reports the offending line and returns false on errors
+bool parse_scenario_matrix(std::istream& in, ScenarioMatrix& matrix);
+bool load_scenario_matrix(const std::string& path, ScenarioMatrix& matrix);
+
+// All cells of the matrix; cells without noise appear once, not once per seed
+std::vector<ScenarioCell> expand_scenario_matrix(const ScenarioMatrix& matrix);
+
+// Simulate one cell; writes its trace when an output format is configured.
+// Fails the cell (ok = false, metrics zero) if the output file cannot be opened.
+ScenarioResult run_scenario_cell(const ScenarioMatrix& matrix, const ScenarioCell& cell);
+
+// Run every cell on a thread pool. Each cell owns its controller, plant,
+// noise stream, metrics and output file, so workers share nothing and the
+// results, returned in expand_scenario_matrix() order, do not depend on the
+// number of threads. All cells with the same plant, noise and seed see the
+// same noise sequence, so controllers are compared on equal terms.
+std::vector<ScenarioResult> run_scenario_matrix(const ScenarioMatrix& matrix);
+
+// One CSV row per successful cell
+bool write_scenario_results(const std::string& path, const std::vector<ScenarioResult>& results);
+
+// Print metrics aggregated over seeds (mean and standard deviation) per
+// controller, plant, noise and duration; failed cells are left out
+void print_scenario_summary(const std::vector<ScenarioResult>& results);
+
+#endif // _SCENARIO_RUNNER_H_
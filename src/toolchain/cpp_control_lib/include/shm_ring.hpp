@@ -0,0 +1,99 @@
+// Lock-free single-producer single-consumer ring in shared memory definition
+#ifndef _SHM_RING_H_
+#define _SHM_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// The ring is placed in memory shared between threads or processes, so its
+// indices must be address-free atomics rather than a lock
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "ShmRing needs lock-free 64-bit atomics");
+
+// Bounded SPSC ring of trivially copyable elements. head and tail are free
+// running counters on their own cache lines, so producer and consumer never
+// write the same line. The object has no pointers and can be constructed
+// directly in a shared mapping with placement new; both sides then use it
+// through their own mapping address.
+template <typename T, std::size_t Capacity>
+class ShmRing {
+    static_assert((Capacity & (Capacity - 1)) == 0 && Capacity > 0, "capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "ring elements are copied with memcpy semantics");
+
+public:
+    ShmRing() : head(0), tail(0) {}
+
+    // Producer side; returns false when the ring is full
+    bool push(const T& item) {
+        const std::uint64_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == Capacity) return false;
+        slots[h & (Capacity - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; returns false when the ring is empty
+    bool pop(T& item) {
+        const std::uint64_t t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == t) return false;
+        item = slots[t & (Capacity - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; pop everything queued and keep only the newest element.
+    // Returns the number of elements consumed, 0 leaves item unchanged.
+    std::size_t popLatest(T& item) {
+        std::size_t count = 0;
+        while (pop(item)) ++count;
+        return count;
+    }
+
+    // Elements queued, exact only when called by producer or consumer
+    std::size_t size() const {
+        return static_cast<std::size_t>(head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire));
+    }
+
+    static std::size_t capacity() { return Capacity; }
+
+private:
+    alignas(64) std::atomic<std::uint64_t> head;    // Next slot to write, producer only
+    alignas(64) std::atomic<std::uint64_t> tail;    // Next slot to read, consumer only
+    alignas(64) T slots[Capacity];
+};
+
+// Shared memory mapping. An empty name gives an anonymous shared mapping that
+// is inherited across fork(); a name ("/cosim") creates a POSIX shared
+// memory object that unrelated processes can map with open().
+class SharedMemory {
+public:
+    SharedMemory();
+    ~SharedMemory();
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    // Create and zero a mapping of size bytes; the creator unlinks a named
+    // object when it is destroyed
+    bool create(std::size_t size_val, const std::string& name_val = std::string());
+
+    // Map an existing named object
+    bool open(std::size_t size_val, const std::string& name_val);
+
+    void close();
+
+    void* data() const { return address; }
+    std::size_t size() const { return length; }
+
+private:
+    bool map(int fd, std::size_t size_val);
+
+    void* address;
+    std::size_t length;
+    std::string name;
+    bool owner;
+};
+
+#endif // _SHM_RING_H_
@@ -0,0 +1,247 @@
+// Simulation plant models for controller tests and benchmarks (header-only)
+#ifndef _SYSTEM_MODELS_H_
+#define _SYSTEM_MODELS_H_
+
+#include <cstddef>
+#include <string>
+#include "ode_solvers.hpp"
+
+// How a plant integrates its dynamics over one sample period.
+// The input is held constant over the period (zero-order hold).
+enum IntegrationMethod {
+    INTEGRATION_EULER,      // One explicit Euler step (default, the original models)
+    INTEGRATION_RK4,        // One classical Runge-Kutta step
+    INTEGRATION_RKF45       // Adaptive Runge-Kutta-Fehlberg substeps with error control
+};
+
+// System model base class
+class SystemModel {
+public:
+    SystemModel() : method(INTEGRATION_EULER), rkf45_step(0.0) {}
+    virtual ~SystemModel() = default;
+    virtual double compute(double input) = 0;
+    virtual void reset() = 0;
+    virtual std::string get_name() const = 0;
+
+    // Select the integration method; tolerance bounds the RKF45 local error
+    void set_integration(IntegrationMethod method_val, double tolerance = 1e-6) {
+        method = method_val;
+        rkf45_options.tol = tolerance;
+        rkf45_step = 0.0;
+    }
+
+    IntegrationMethod get_integration() const { return method; }
+
+    // Derivative evaluations and steps spent so far, a measure of simulation cost
+    const OdeStats& integration_stats() const { return stats; }
+
+protected:
+    // Advance the N states x over one period dt with the selected higher-order
+    // method; f(t, x, dxdt) evaluates the plant dynamics for the held input
+    template <int N, typename F>
+    void integrate(F f, double* x, double dt) {
+        if (method == INTEGRATION_RK4) {
+            rk4_step<N>(f, 0.0, x, dt, &stats);
+        } else {
+            rkf45_integrate<N>(f, 0.0, dt, x, rkf45_step, rkf45_options, &stats);
+        }
+    }
+
+    // Forget the adapted RKF45 step size; called by reset()
+    void reset_integration() {
+        rkf45_step = 0.0;
+    }
+
+    IntegrationMethod method;
+    Rkf45Options rkf45_options;
+    double rkf45_step;          // Adapted RKF45 step carried across periods
+    OdeStats stats;
+};
+
+// First-order system model
+class FirstOrderSystem : public SystemModel {
+private:
+    double T;  // Time constant
+    double K;  // Gain
+    double dt;  // Sampling time
+    double prev_input;  // Previous input
+    double prev_output;  // Previous output
+
+public:
+    // Constructor
+    FirstOrderSystem(double T_val, double K_val, double dt_val)
+        : T(T_val), K(K_val), dt(dt_val), prev_input(0.0), prev_output(0.0) {}
+    
+    // Calculate system output
+    double compute(double input) override {
+        // First-order differential equation dx/dt = (K*u - x)/T
+        double output;
+        if (method == INTEGRATION_EULER) {
+            output = prev_output + (dt / T) * (K * input - prev_output);
+        } else {
+            double x = prev_output;
+            integrate<1>([this, input](double, const double* s, double* ds) {
+                ds[0] = (K * input - s[0]) / T;
+            }, &x, dt);
+            output = x;
+        }
+        
+        // Update history values
+        prev_input = input;
+        prev_output = output;
+        
+        return output;
+    }
+    
+    // Reset system
+    void reset() override {
+        prev_input = 0.0;
+        prev_output = 0.0;
+        reset_integration();
+    }
+    
+    // Get model name
+    std::string get_name() const override {
+        return "FirstOrderSystem";
+    }
+};
+
+// Second-order system model
+class SecondOrderSystem : public SystemModel {
+private:
+    double K;  // Gain
+    double zeta;  // Damping ratio
+    double omega_n;  // Natural frequency
+    double dt;  // Sampling time
+    double prev_input;  // Previous input
+    double prev_output;  // Previous output
+    double prev_derivative;  // Previous derivative
+
+public:
+    // Constructor
+    SecondOrderSystem(double K_val, double zeta_val, double omega_n_val, double dt_val)
+        : K(K_val), zeta(zeta_val), omega_n(omega_n_val), dt(dt_val),
+          prev_input(0.0), prev_output(0.0), prev_derivative(0.0) {}
+    
+    // Calculate system output
+    double compute(double input) override {
+        // Second-order system: G(s) = K * omega_n^2 / (s^2 + 2*zeta*omega_n*s + omega_n^2)
+        double derivative, output;
+        if (method == INTEGRATION_EULER) {
+            // Using Euler method for numerical integration
+            double acceleration = K * omega_n * omega_n * input - 
+                                 2 * zeta * omega_n * prev_derivative - 
+                                 omega_n * omega_n * prev_output;
+            
+            derivative = prev_derivative + acceleration * dt;
+            output = prev_output + derivative * dt;
+        } else {
+            double x[2] = {prev_output, prev_derivative};
+            integrate<2>([this, input](double, const double* s, double* ds) {
+                ds[0] = s[1];
+                ds[1] = K * omega_n * omega_n * input - 2 * zeta * omega_n * s[1] - omega_n * omega_n * s[0];
+            }, x, dt);
+            output = x[0];
+            derivative = x[1];
+        }
+        
+        // Update history values
+        prev_input = input;
+        prev_output = output;
+        prev_derivative = derivative;
+        
+        return output;
+    }
+    
+    // Reset system
+    void reset() override {
+        prev_input = 0.0;
+        prev_output = 0.0;
+        prev_derivative = 0.0;
+        reset_integration();
+    }
+    
+    // Get model name
+    std::string get_name() const override {
+        return "SecondOrderSystem";
+    }
+};
+
+// Nonlinear system model (saturation + deadzone)
+class NonlinearSystem : public SystemModel {
+private:
+    double K;  // Gain
+    double T;  // Time constant
+    double saturation_limit;  // Saturation limit
+    double deadzone_width;  // Deadzone width
+    double dt;  // Sampling time
+    double prev_input;  // Previous input
+    double prev_output;  // Previous output
+
+public:
+    // Constructor
+    NonlinearSystem(double K_val, double T_val, double saturation_limit_val, 
+                   double deadzone_width_val, double dt_val)
+        : K(K_val), T(T_val), saturation_limit(saturation_limit_val),
+          deadzone_width(deadzone_width_val), dt(dt_val),
+          prev_input(0.0), prev_output(0.0) {}
+    
+    // Apply saturation nonlinearity
+    double apply_saturation(double input) {
+        if (input > saturation_limit) {
+            return saturation_limit;
+        } else if (input < -saturation_limit) {
+            return -saturation_limit;
+        }
+        return input;
+    }
+    
+    // Apply deadzone nonlinearity
+    double apply_deadzone(double input) {
+        if (input > deadzone_width) {
+            return input - deadzone_width;
+        } else if (input < -deadzone_width) {
+            return input + deadzone_width;
+        }
+        return 0.0;
+    }
+    
+    // Calculate system output
+    double compute(double input) override {
+        // Apply nonlinearities
+        double nonlinear_input = apply_saturation(input);
+        nonlinear_input = apply_deadzone(nonlinear_input);
+        
+        // First-order dynamics with nonlinear input
+        double output;
+        if (method == INTEGRATION_EULER) {
+            output = prev_output + (dt / T) * (K * nonlinear_input - prev_output);
+        } else {
+            double x = prev_output;
+            integrate<1>([this, nonlinear_input](double, const double* s, double* ds) {
+                ds[0] = (K * nonlinear_input - s[0]) / T;
+            }, &x, dt);
+            output = x;
+        }
+        
+        // Update history values
+        prev_input = input;
+        prev_output = output;
+        
+        return output;
+    }
+    
+    // Reset system
+    void reset() override {
+        prev_input = 0.0;
+        prev_output = 0.0;
+        reset_integration();
+    }
+    
+    // Get model name
+    std::string get_name() const override {
+        return "NonlinearSystem";
+    }
+};
+
+#endif // _SYSTEM_MODELS_H_
@@ -0,0 +1,58 @@
+// Fixed-size worker thread pool definition
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Worker threads for data-parallel offline work such as simulation sweeps.
+// parallelFor() hands out indices dynamically, so uneven work items (early
+// stopped simulations) still balance across workers. The calling thread
+// takes part in the work. Not intended for the real-time control thread.
+class ThreadPool {
+public:
+    // Constructor - num_threads total threads including the caller,
+    // 0 for one per hardware thread
+    explicit ThreadPool(std::size_t num_threads = 0);
+
+    // Destructor - joins all workers
+    ~ThreadPool();
+
+    // Run fn(i) for every i in [0, count) and wait until all calls returned.
+    // Calls from several threads at once are serialized.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+    // Total number of threads working on a parallelFor()
+    std::size_t size() const { return workers.size() + 1; }
+
+private:
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Worker thread main loop
+    void workerLoop();
+
+    // Claim and run indices of the current job until none are left
+    void runJob();
+
+    std::vector<std::thread> workers;
+    std::mutex submit_mutex;    // Serializes parallelFor() callers
+    std::mutex mutex;
+    std::condition_variable job_ready;
+    std::condition_variable job_done;
+
+    // Current job, guarded by mutex except for the atomic counters
+    const std::function<void(std::size_t)>* job;
+    std::size_t job_count;
+    std::size_t generation;
+    std::size_t active_workers;
+    std::atomic<std::size_t> next_index;
+    bool stopping;
+};
+
+#endif // _THREAD_POOL_H_
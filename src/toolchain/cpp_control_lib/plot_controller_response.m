@@ -33,20 +33,28 @@ for i = 1:size(controllers, 1)
     csv_file = fullfile(csv_dir, controllers{i, 2});
     color = colors{i};
     
-    % Check if the CSV file exists
-    if ~exist(csv_file, 'file')
+    % Prefer the columnar binary file (test_all_controllers <prefix> ccol)
+    [file_dir, file_base] = fileparts(csv_file);
+    ccol_file = fullfile(file_dir, [file_base, '.ccol']);
+    if exist(ccol_file, 'file')
+        data = read_ccol(ccol_file);
+        time = data.time;
+        setpoint = data.setpoint;
+        process_val = data.process_val;
+        output = data.output;
+    elseif exist(csv_file, 'file')
+        % Read CSV data
+        % The CSV format is: time,setpoint,process_val,output
+        data = readmatrix(csv_file);
+        time = data(:, 1);
+        setpoint = data(:, 2);
+        process_val = data(:, 3);
+        output = data(:, 4);
+    else
         warning('CSV file not found: %s', csv_file);
         continue;
     end
     
-    % Read CSV data
-    % The CSV format is: time,setpoint,process_val,output
-    data = readmatrix(csv_file);
-    time = data(:, 1);
-    setpoint = data(:, 2);
-    process_val = data(:, 3);
-    output = data(:, 4);
-    
     % Plot process value (response) vs time
     subplot(3, 2, 1);
     hold on;
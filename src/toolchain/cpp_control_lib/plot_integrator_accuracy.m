@@ -0,0 +1,39 @@
+% MATLAB script to plot plant integrator accuracy against cost
+% This script reads the CSV written by bench_integrators
+% (bench_integrators integrator_accuracy.csv) and plots the maximum step
+% response error against the number of derivative evaluations
+
+clear;
+close all;
+clc;
+
+% Change this path to match your actual build directory
+csv_file = 'integrator_accuracy.csv';
+if ~exist(csv_file, 'file')
+    error('CSV file not found: %s', csv_file);
+end
+
+% Columns: plant,method,dt,tolerance,max_error,evaluations,us
+data = readtable(csv_file, 'TextType', 'string');
+
+plants = {'second_order', 'first_order'};
+methods = {'euler', 'rk4', 'rkf45'};
+markers = {'r-o', 'g-s', 'b-^'};
+
+figure('Name', 'Integrator Accuracy vs Cost', 'Position', [100, 100, 1200, 500]);
+for p = 1:numel(plants)
+    subplot(1, 2, p);
+    for m = 1:numel(methods)
+        rows = data.plant == plants{p} & data.method == methods{m};
+        loglog(data.evaluations(rows), data.max_error(rows), markers{m}, 'LineWidth', 2);
+        hold on;
+    end
+    grid on;
+    xlabel('Derivative evaluations (20 s step response)');
+    ylabel('Maximum error');
+    title(strrep(plants{p}, '_', ' '));
+    legend({'Euler (dt sweep)', 'RK4 (dt sweep)', 'RKF45 (dt = 0.1, tolerance sweep)'}, 'Location', 'best');
+end
+
+saveas(gcf, 'integrator_accuracy.png');
+fprintf('Plot saved as integrator_accuracy.png\n');
@@ -0,0 +1,68 @@
+function data = read_ccol(filename)
+% READ_CCOL Read a columnar binary result file (.ccol) written by ColumnarWriter
+%   data = read_ccol(filename) returns a struct with one field per column,
+%   e.g. data.time, data.setpoint, data.process_val, data.output.
+%   Each column is read block by block with fread, so no text parsing is
+%   needed. See include/columnar_file.hpp for the file layout.
+
+fid = fopen(filename, 'r');
+if fid < 0
+    error('read_ccol:open', 'Failed to open file: %s', filename);
+end
+
+% Values are in the writer's byte order, given by the byte order mark
+fseek(fid, 40, 'bof');
+mark = fread(fid, 4, '*uint8')';
+fclose(fid);
+if isequal(mark, uint8([4 3 2 1]))
+    byte_order = 'ieee-le';
+elseif isequal(mark, uint8([1 2 3 4]))
+    byte_order = 'ieee-be';
+else
+    error('read_ccol:format', 'Not a columnar file: %s', filename);
+end
+fid = fopen(filename, 'r', byte_order);
+cleanup = onCleanup(@() fclose(fid));
+
+% File header (64 bytes)
+magic = fread(fid, 4, '*char')';
+if ~strcmp(magic, 'CCOL')
+    error('read_ccol:format', 'Not a columnar file: %s', filename);
+end
+version = fread(fid, 1, 'uint32');
+if version ~= 2
+    error('read_ccol:format', 'Unsupported columnar file version %d', version);
+end
+num_columns = fread(fid, 1, 'uint32');
+fread(fid, 1, 'uint32');                % chunk_rows
+num_rows = fread(fid, 1, 'uint64');
+num_chunks = fread(fid, 1, 'uint64');
+directory_offset = fread(fid, 1, 'uint64');
+
+% Column directory
+fseek(fid, directory_offset, 'bof');
+names = cell(num_columns, 1);
+types = zeros(num_columns, 1);
+for c = 1:num_columns
+    raw = fread(fid, 40, '*uint8')';
+    names{c} = char(raw(1:find([raw 0] == 0, 1) - 1));
+    types(c) = fread(fid, 1, 'uint32');
+    fread(fid, 1, 'uint32');            % element_size
+end
+chunk_index = reshape(fread(fid, num_chunks * (1 + num_columns), 'uint64'), 1 + num_columns, []);
+
+% Column blocks
+precisions = {'double', 'single', 'int32', 'int64'};
+data = struct();
+for c = 1:num_columns
+    values = zeros(num_rows, 1);
+    row = 0;
+    for k = 1:num_chunks
+        rows = chunk_index(1, k);
+        fseek(fid, chunk_index(1 + c, k), 'bof');
+        values(row + 1:row + rows) = fread(fid, rows, precisions{types(c)});
+        row = row + rows;
+    end
+    data.(matlab.lang.makeValidName(names{c})) = values;
+end
+end
@@ -0,0 +1,368 @@
+// Columnar binary result file implementation
+#include "columnar_file.hpp"
+#include <cstring>
+#include <limits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char kMagic[4] = {'C', 'C', 'O', 'L'};
+
+// Entries per chunk in the chunk index: row count plus one offset per column
+std::size_t index_stride(std::size_t num_columns)
+{
+    return 1 + num_columns;
+}
+
+// Convert to an integer column type, saturating out-of-range values and
+// mapping NaN to 0 (a plain cast of either is undefined)
+template <typename Int>
+inline Int saturate_to(double value)
+{
+    // -min is 2^(bits-1), exactly representable, the first value past max
+    const double limit = -static_cast<double>(std::numeric_limits<Int>::min());
+    if (value != value) {
+        return 0;
+    }
+    if (value >= limit) {
+        return std::numeric_limits<Int>::max();
+    }
+    if (value < -limit) {
+        return std::numeric_limits<Int>::min();
+    }
+    return static_cast<Int>(value);
+}
+
+// Store one value converted to the column type
+inline void store_value(unsigned char* dst, std::uint32_t type, double value)
+{
+    switch (type) {
+    case COLUMN_FLOAT64: {
+        std::memcpy(dst, &value, sizeof(value));
+        break;
+    }
+    case COLUMN_FLOAT32: {
+        float v = static_cast<float>(value);
+        std::memcpy(dst, &v, sizeof(v));
+        break;
+    }
+    case COLUMN_INT32: {
+        std::int32_t v = saturate_to<std::int32_t>(value);
+        std::memcpy(dst, &v, sizeof(v));
+        break;
+    }
+    default: {
+        std::int64_t v = saturate_to<std::int64_t>(value);
+        std::memcpy(dst, &v, sizeof(v));
+        break;
+    }
+    }
+}
+
+} // namespace
+
+std::size_t column_type_size(ColumnType type)
+{
+    switch (type) {
+    case COLUMN_FLOAT64: return 8;
+    case COLUMN_FLOAT32: return 4;
+    case COLUMN_INT32: return 4;
+    case COLUMN_INT64: return 8;
+    default: return 0;
+    }
+}
+
+// Columnar Writer Implementation
+ColumnarWriter::ColumnarWriter()
+    : file(nullptr), position(0), failed(false), chunk_rows(0), buffered_rows(0), total_rows(0)
+{
+}
+
+ColumnarWriter::~ColumnarWriter()
+{
+    if (file) {
+        close();
+    }
+}
+
+int ColumnarWriter::addColumn(const std::string& name, ColumnType type)
+{
+    std::size_t size = column_type_size(type);
+    if (file || size == 0) {
+        return -1;
+    }
+    ColumnarColumnInfo info;
+    std::memset(&info, 0, sizeof(info));
+    std::strncpy(info.name, name.c_str(), sizeof(info.name) - 1);
+    info.type = type;
+    info.element_size = static_cast<std::uint32_t>(size);
+    columns.push_back(info);
+    return static_cast<int>(columns.size()) - 1;
+}
+
+bool ColumnarWriter::open(const std::string& path, std::size_t chunk_rows_val)
+{
+    if (file || columns.empty() || chunk_rows_val == 0) {
+        return false;
+    }
+    file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        printf("Failed to open file: %s\n", path.c_str());
+        return false;
+    }
+
+    position = 0;
+    failed = false;
+    chunk_rows = chunk_rows_val;
+    buffered_rows = 0;
+    total_rows = 0;
+    chunk_index.clear();
+    buffers.resize(columns.size());
+    for (std::size_t c = 0; c < columns.size(); ++c) {
+        buffers[c].resize(chunk_rows * columns[c].element_size);
+    }
+
+    // Placeholder header; the real one is written by close()
+    ColumnarFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    return write(&header, sizeof(header));
+}
+
+void ColumnarWriter::appendRow(const double* values)
+{
+    for (std::size_t c = 0; c < columns.size(); ++c) {
+        unsigned char* dst = buffers[c].data() + buffered_rows * columns[c].element_size;
+        store_value(dst, columns[c].type, values[c]);
+    }
+    ++total_rows;
+    if (++buffered_rows == chunk_rows) {
+        flushChunk();
+    }
+}
+
+bool ColumnarWriter::flushChunk()
+{
+    if (buffered_rows == 0) {
+        return !failed;
+    }
+    chunk_index.push_back(buffered_rows);
+    for (std::size_t c = 0; c < columns.size(); ++c) {
+        pad(columnar_block_alignment);
+        chunk_index.push_back(position);
+        write(buffers[c].data(), buffered_rows * columns[c].element_size);
+    }
+    buffered_rows = 0;
+    return !failed;
+}
+
+bool ColumnarWriter::write(const void* data, std::size_t size)
+{
+    if (!failed && size > 0 && std::fwrite(data, size, 1, file) != 1) {
+        failed = true;
+    }
+    position += size;
+    return !failed;
+}
+
+bool ColumnarWriter::pad(std::size_t alignment)
+{
+    static const unsigned char zeros[columnar_block_alignment] = {};
+    std::size_t padding = static_cast<std::size_t>((alignment - position % alignment) % alignment);
+    return write(zeros, padding);
+}
+
+bool ColumnarWriter::close()
+{
+    if (file == nullptr) {
+        return false;
+    }
+    flushChunk();
+
+    // Directory: column info followed by the chunk index
+    pad(8);
+    ColumnarFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = columnar_file_version;
+    header.num_columns = static_cast<std::uint32_t>(columns.size());
+    header.chunk_rows = static_cast<std::uint32_t>(chunk_rows);
+    header.num_rows = total_rows;
+    header.num_chunks = chunk_index.size() / index_stride(columns.size());
+    header.directory_offset = position;
+    header.byte_order = columnar_byte_order_mark;
+    write(columns.data(), columns.size() * sizeof(ColumnarColumnInfo));
+    if (!chunk_index.empty()) {
+        write(chunk_index.data(), chunk_index.size() * sizeof(std::uint64_t));
+    }
+
+    // The valid header goes in last, so an interrupted file is never accepted
+    bool ok = !failed && std::fseek(file, 0, SEEK_SET) == 0 &&
+              std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    buffers.clear();
+    if (!ok) {
+        printf("Failed to write columnar file\n");
+    }
+    return ok;
+}
+
+// Columnar Reader Implementation
+ColumnarReader::ColumnarReader()
+    : base(nullptr), length(0), num_columns(0), num_rows(0), num_chunks(0),
+      column_info(nullptr), chunk_index(nullptr)
+{
+}
+
+ColumnarReader::~ColumnarReader()
+{
+    close();
+}
+
+bool ColumnarReader::open(const std::string& path)
+{
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        printf("Failed to open file: %s\n", path.c_str());
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(ColumnarFileHeader)) {
+        ::close(fd);
+        printf("Invalid columnar file: %s\n", path.c_str());
+        return false;
+    }
+    length = static_cast<std::size_t>(info.st_size);
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        length = 0;
+        printf("Failed to map file: %s\n", path.c_str());
+        return false;
+    }
+    base = static_cast<const unsigned char*>(mapping);
+
+    // Validate header, directory and every block against the file size
+    const ColumnarFileHeader* header = reinterpret_cast<const ColumnarFileHeader*>(base);
+    bool ok = std::memcmp(header->magic, kMagic, sizeof(kMagic)) == 0 &&
+              header->version == columnar_file_version && header->byte_order == columnar_byte_order_mark &&
+              header->num_columns > 0 && header->num_columns <= length / sizeof(ColumnarColumnInfo) &&
+              header->directory_offset % 8 == 0 && header->directory_offset <= length;
+    if (ok) {
+        // Bound the chunk count first so the directory size cannot overflow
+        std::uint64_t index_entry_size = index_stride(header->num_columns) * sizeof(std::uint64_t);
+        ok = header->num_chunks <= length / index_entry_size;
+        ok = ok && header->num_columns * sizeof(ColumnarColumnInfo) + header->num_chunks * index_entry_size <=
+                   length - header->directory_offset;
+    }
+    if (ok) {
+        num_columns = header->num_columns;
+        num_rows = header->num_rows;
+        num_chunks = static_cast<std::size_t>(header->num_chunks);
+        column_info = reinterpret_cast<const ColumnarColumnInfo*>(base + header->directory_offset);
+        chunk_index = reinterpret_cast<const std::uint64_t*>(column_info + num_columns);
+
+        std::uint64_t rows = 0;
+        for (std::size_t c = 0; c < num_columns && ok; ++c) {
+            std::size_t size = column_type_size(static_cast<ColumnType>(column_info[c].type));
+            ok = size != 0 && size == column_info[c].element_size;
+        }
+        for (std::size_t k = 0; k < num_chunks && ok; ++k) {
+            const std::uint64_t* entry = chunk_index + k * index_stride(num_columns);
+            rows += entry[0];
+            for (std::size_t c = 0; c < num_columns && ok; ++c) {
+                std::uint64_t offset = entry[1 + c];
+                ok = offset % columnar_block_alignment == 0 && offset <= length &&
+                     entry[0] <= (length - offset) / column_info[c].element_size;
+            }
+        }
+        ok = ok && rows == num_rows;
+    }
+
+    if (!ok) {
+        printf("Invalid columnar file: %s\n", path.c_str());
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ColumnarReader::close()
+{
+    if (base) {
+        munmap(const_cast<unsigned char*>(base), length);
+    }
+    base = nullptr;
+    length = 0;
+    num_columns = 0;
+    num_rows = 0;
+    num_chunks = 0;
+    column_info = nullptr;
+    chunk_index = nullptr;
+}
+
+std::string ColumnarReader::columnName(std::size_t column) const
+{
+    const char* name = column_info[column].name;
+    return std::string(name, strnlen(name, sizeof(column_info[column].name)));
+}
+
+ColumnType ColumnarReader::columnType(std::size_t column) const
+{
+    return static_cast<ColumnType>(column_info[column].type);
+}
+
+int ColumnarReader::findColumn(const std::string& name) const
+{
+    for (std::size_t c = 0; c < num_columns; ++c) {
+        if (columnName(c) == name) {
+            return static_cast<int>(c);
+        }
+    }
+    return -1;
+}
+
+std::size_t ColumnarReader::chunkRows(std::size_t chunk) const
+{
+    return static_cast<std::size_t>(chunk_index[chunk * index_stride(num_columns)]);
+}
+
+const void* ColumnarReader::chunkData(std::size_t chunk, std::size_t column) const
+{
+    return base + chunk_index[chunk * index_stride(num_columns) + 1 + column];
+}
+
+bool ColumnarReader::readColumn(std::size_t column, std::vector<double>& values) const
+{
+    if (column >= num_columns) {
+        return false;
+    }
+    values.resize(static_cast<std::size_t>(num_rows));
+    std::size_t row = 0;
+    for (std::size_t k = 0; k < num_chunks; ++k) {
+        std::size_t rows = chunkRows(k);
+        const void* data = chunkData(k, column);
+        switch (columnType(column)) {
+        case COLUMN_FLOAT64:
+            std::memcpy(&values[row], data, rows * sizeof(double));
+            break;
+        case COLUMN_FLOAT32:
+            for (std::size_t i = 0; i < rows; ++i) values[row + i] = static_cast<const float*>(data)[i];
+            break;
+        case COLUMN_INT32:
+            for (std::size_t i = 0; i < rows; ++i) values[row + i] = static_cast<const std::int32_t*>(data)[i];
+            break;
+        default:
+            for (std::size_t i = 0; i < rows; ++i) {
+                values[row + i] = static_cast<double>(static_cast<const std::int64_t*>(data)[i]);
+            }
+            break;
+        }
+        row += rows;
+    }
+    return true;
+}
@@ -0,0 +1,86 @@
+// Multi-controller state checkpoint implementation
+#include "controller_checkpoint.hpp"
+#include <cstdio>
+
+namespace {
+
+// Checkpoint file header
+struct CheckpointFileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t count;
+    std::uint64_t bytes;
+    std::uint64_t checksum;
+};
+
+const std::uint32_t kFileMagic = 0x54504B43;  // "CKPT"
+const std::uint32_t kFileVersion = 1;
+
+// Upper bound on snapshot bytes accepted from a file
+const std::uint64_t kMaxBytes = 1ULL << 30;
+
+// FNV-1a hash of the snapshot bytes
+std::uint64_t checksum(const unsigned char* data, std::size_t size)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+bool ControllerCheckpoint::saveFile(const std::string& path) const
+{
+    CheckpointFileHeader header;
+    header.magic = kFileMagic;
+    header.version = kFileVersion;
+    header.count = count;
+    header.bytes = buffer.size();
+    header.checksum = checksum(buffer.data(), buffer.size());
+
+    std::string temp_path = path + ".tmp";
+    FILE* file = fopen(temp_path.c_str(), "wb");
+    if (file == nullptr) {
+        printf("Failed to open checkpoint file: %s\n", temp_path.c_str());
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              (buffer.empty() || fwrite(buffer.data(), buffer.size(), 1, file) == 1);
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(temp_path.c_str(), path.c_str()) != 0) {
+        printf("Failed to write checkpoint file: %s\n", path.c_str());
+        remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ControllerCheckpoint::loadFile(const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        printf("Failed to open checkpoint file: %s\n", path.c_str());
+        return false;
+    }
+
+    CheckpointFileHeader header;
+    std::vector<unsigned char> data;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+              header.magic == kFileMagic && header.version == kFileVersion && header.bytes <= kMaxBytes;
+    if (ok) {
+        data.resize(static_cast<std::size_t>(header.bytes));
+        ok = data.empty() || fread(data.data(), data.size(), 1, file) == 1;
+    }
+    fclose(file);
+
+    if (!ok || checksum(data.data(), data.size()) != header.checksum) {
+        printf("Invalid checkpoint file: %s\n", path.c_str());
+        return false;
+    }
+    buffer.swap(data);
+    count = static_cast<std::size_t>(header.count);
+    return true;
+}
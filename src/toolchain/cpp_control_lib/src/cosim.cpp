@@ -0,0 +1,401 @@
+// Controller/plant co-simulation over shared-memory rings implementation
+#include "cosim.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <thread>
+#include <vector>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "performance_metrics.hpp"
+#include "shm_ring.hpp"
+
+namespace {
+
+const std::int64_t kNsPerSec = 1000000000;
+const std::size_t kRingCapacity = 64;
+const std::int64_t kStartDelayNs = 20000000;    // Time for the plant thread or process to come up
+
+// One JointData_t on the wire with its timing. For commands, cycle and
+// stamp_ns identify the plant sample the command was computed from.
+struct CosimSample {
+    std::int64_t cycle;         // Plant cycle of the sample, -1 for the initial command
+    std::int64_t stamp_ns;      // Plant sampling instant
+    std::int64_t sent_ns;       // Push into the ring
+    JointData_t joint;
+};
+
+// Plant output and applied command of one cycle
+struct TraceEntry {
+    double process_val;
+    double output;
+};
+
+enum PlantState {
+    PLANT_STARTING = 0,
+    PLANT_RUNNING = 1,
+    PLANT_DONE = 2,
+    PLANT_FAILED = -1
+};
+
+// Layout of the shared mapping, followed by one TraceEntry per cycle.
+// Statistics here are written by the plant side only and read after it ends.
+struct CosimShared {
+    ShmRing<CosimSample, kRingCapacity> measurements;  // Plant to controller
+    ShmRing<CosimSample, kRingCapacity> commands;      // Controller to plant
+    LatencyHistogram loop_delay;
+    LatencyHistogram ring_wait;
+    LatencyHistogram wakeup;
+    std::uint64_t late_commands;
+    std::uint64_t dropped;
+    std::atomic<int> plant_state;
+    std::int64_t start_ns;
+
+    CosimShared() : late_commands(0), dropped(0), plant_state(PLANT_STARTING), start_ns(0) {}
+
+    TraceEntry* trace() {
+        return reinterpret_cast<TraceEntry*>(reinterpret_cast<char*>(this) + sizeof(CosimShared));
+    }
+};
+
+std::int64_t to_ns(const timespec& ts)
+{
+    return static_cast<std::int64_t>(ts.tv_sec) * kNsPerSec + ts.tv_nsec;
+}
+
+timespec from_ns(std::int64_t ns)
+{
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / kNsPerSec);
+    ts.tv_nsec = static_cast<long>(ns % kNsPerSec);
+    return ts;
+}
+
+std::int64_t monotonic_now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return to_ns(ts);
+}
+
+// Sleep until an absolute CLOCK_MONOTONIC deadline, return the wake-up time
+std::int64_t sleep_until(std::int64_t deadline)
+{
+    timespec ts = from_ns(deadline);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+    return monotonic_now();
+}
+
+// Apply SCHED_FIFO priority and CPU affinity to the calling thread
+bool setup_thread(const char* side, int priority, int cpu)
+{
+#if defined(__linux__)
+    if (cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (err != 0) {
+            printf("Cosim: pinning %s to CPU %d failed: %s\n", side, cpu, strerror(err));
+            return false;
+        }
+    }
+#else
+    if (cpu >= 0) {
+        printf("Cosim: CPU pinning is not supported on this platform\n");
+        return false;
+    }
+#endif
+    if (priority > 0) {
+        sched_param param;
+        param.sched_priority = priority;
+        int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (err != 0) {
+            printf("Cosim: SCHED_FIFO priority %d for %s failed: %s\n", priority, side, strerror(err));
+            return false;
+        }
+    }
+    return true;
+}
+
+// Plant side: apply the newest command, step, publish the output
+void plant_loop(CosimShared* shared, const CosimConfig& config, const CosimPlantFactory& make_plant,
+                std::uint64_t cycles)
+{
+    std::unique_ptr<SystemModel> plant;
+    if (setup_thread("plant", config.plant_priority, config.plant_cpu)) plant = make_plant();
+    if (!plant) {
+        shared->plant_state.store(PLANT_FAILED, std::memory_order_release);
+        return;
+    }
+    shared->plant_state.store(PLANT_RUNNING, std::memory_order_release);
+
+    const double dt = config.period_ns * 1e-9;
+    TraceEntry* trace = shared->trace();
+    double u = 0.0;
+    std::int64_t applied_cycle = -2;
+    double prev_position = 0.0;
+    double prev_velocity = 0.0;
+
+    for (std::uint64_t k = 0; k < cycles; ++k) {
+        const std::int64_t deadline = shared->start_ns + static_cast<std::int64_t>(k) * config.period_ns;
+        const std::int64_t wake = sleep_until(deadline);
+        shared->wakeup.add(wake - deadline);
+
+        CosimSample command;
+        if (shared->commands.popLatest(command)) {
+            u = command.joint.force;
+            applied_cycle = command.cycle;
+            if (command.cycle >= 0) {
+                shared->ring_wait.add(monotonic_now() - command.sent_ns);
+                shared->loop_delay.add(wake - command.stamp_ns);
+            }
+        }
+        if (applied_cycle != static_cast<std::int64_t>(k) - 1) ++shared->late_commands;
+
+        const double position = plant->compute(u);
+        const double velocity = (position - prev_position) / dt;
+        const double acceleration = (velocity - prev_velocity) / dt;
+        prev_position = position;
+        prev_velocity = velocity;
+        trace[k].process_val = position;
+        trace[k].output = u;
+
+        CosimSample measurement;
+        measurement.cycle = static_cast<std::int64_t>(k);
+        measurement.stamp_ns = wake;
+        measurement.joint.position = static_cast<float>(position);
+        measurement.joint.velocity = static_cast<float>(velocity);
+        measurement.joint.force = static_cast<float>(u);
+        measurement.joint.acceleration = static_cast<float>(acceleration);
+        measurement.sent_ns = monotonic_now();
+        if (!shared->measurements.push(measurement)) ++shared->dropped;
+    }
+    shared->plant_state.store(PLANT_DONE, std::memory_order_release);
+}
+
+CosimSample make_command(const CosimSample& measurement, double setpoint, double u)
+{
+    CosimSample command;
+    command.cycle = measurement.cycle;
+    command.stamp_ns = measurement.stamp_ns;
+    command.joint.position = static_cast<float>(setpoint);
+    command.joint.velocity = 0.0f;
+    command.joint.force = static_cast<float>(u);
+    command.joint.acceleration = 0.0f;
+    command.sent_ns = monotonic_now();
+    return command;
+}
+
+void fill_response(const PerformanceMetrics& metrics, CosimResponse& response)
+{
+    response.rise_time = metrics.calculate_rise_time();
+    response.overshoot = metrics.calculate_overshoot();
+    response.settling_time = metrics.calculate_settling_time();
+    response.steady_state_error = metrics.calculate_steady_state_error();
+    response.iae = metrics.calculate_iae();
+    response.itae = metrics.calculate_itae();
+    response.control_effort = metrics.calculate_control_effort();
+}
+
+} // namespace
+
+CosimConfig::CosimConfig()
+    : mode(COSIM_THREAD), period_ns(1000000), controller_offset_ns(500000), duration(5.0), setpoint(1.0),
+      plant_priority(0), controller_priority(0), plant_cpu(-1), controller_cpu(-1)
+{
+}
+
+void LatencyHistogram::clear()
+{
+    samples = 0;
+    minimum = std::numeric_limits<std::int64_t>::max();
+    maximum = std::numeric_limits<std::int64_t>::min();
+    sum = 0;
+    std::fill(bins, bins + num_bins + 1, 0u);
+}
+
+void LatencyHistogram::add(std::int64_t ns)
+{
+    ++samples;
+    minimum = std::min(minimum, ns);
+    maximum = std::max(maximum, ns);
+    sum += ns;
+    std::int64_t bin = ns > 0 ? ns / bin_ns : 0;
+    ++bins[std::min(bin, static_cast<std::int64_t>(num_bins))];
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    samples += other.samples;
+    minimum = std::min(minimum, other.minimum);
+    maximum = std::max(maximum, other.maximum);
+    sum += other.sum;
+    for (std::size_t i = 0; i <= num_bins; ++i) bins[i] += other.bins[i];
+}
+
+std::int64_t LatencyHistogram::percentile(double p) const
+{
+    if (samples == 0) return 0;
+    const std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(p * samples));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < num_bins; ++i) {
+        seen += bins[i];
+        if (seen >= rank && seen > 0) {
+            return std::min(static_cast<std::int64_t>(i + 1) * bin_ns, maximum);
+        }
+    }
+    return maximum;
+}
+
+CosimResult run_cosimulation(const CosimConfig& config, const CosimControllerFactory& make_controller,
+                             const CosimPlantFactory& make_plant)
+{
+    CosimResult result;
+    result.ok = false;
+    result.cycles = static_cast<std::uint64_t>(config.duration * kNsPerSec / config.period_ns);
+    result.stale_measurements = 0;
+    result.late_commands = 0;
+    result.dropped = 0;
+    result.max_deviation = 0.0;
+
+    const double dt = config.period_ns * 1e-9;
+    const std::uint64_t cycles = result.cycles;
+
+    // Inline reference. Samples and commands pass through the float fields
+    // of JointData_t in the co-simulation, so they are rounded the same way
+    // here and only timing separates the two runs.
+    std::vector<double> ideal_trace(cycles);
+    {
+        std::unique_ptr<Controller> controller = make_controller();
+        std::unique_ptr<SystemModel> plant = make_plant();
+        if (!controller || !plant) return result;
+        PerformanceMetrics metrics;
+        double process_val = 0.0;
+        for (std::uint64_t k = 0; k < cycles; ++k) {
+            float u = static_cast<float>(controller->compute(config.setpoint, static_cast<float>(process_val)));
+            process_val = plant->compute(u);
+            ideal_trace[k] = process_val;
+            metrics.add_data_point(k * dt, config.setpoint, process_val, u);
+        }
+        fill_response(metrics, result.ideal);
+    }
+
+    SharedMemory memory;
+    if (!memory.create(sizeof(CosimShared) + cycles * sizeof(TraceEntry), config.shm_name)) return result;
+    CosimShared* shared = new (memory.data()) CosimShared();
+
+    std::unique_ptr<Controller> controller = make_controller();
+    if (!setup_thread("controller", config.controller_priority, config.controller_cpu)) return result;
+
+    // The command for plant cycle 0 is computed from the initial output,
+    // like the first iteration of the inline loop
+    CosimSample latest;
+    latest.cycle = -1;
+    latest.stamp_ns = 0;
+    latest.joint.position = 0.0f;
+    shared->commands.push(make_command(latest, config.setpoint, controller->compute(config.setpoint, 0.0f)));
+    shared->start_ns = monotonic_now() + kStartDelayNs;
+
+    std::thread plant_thread;
+    pid_t plant_pid = -1;
+    if (config.mode == COSIM_PROCESS) {
+        plant_pid = fork();
+        if (plant_pid < 0) {
+            printf("Cosim: fork failed: %s\n", strerror(errno));
+            return result;
+        }
+        if (plant_pid == 0) {
+            plant_loop(shared, config, make_plant, cycles);
+            _exit(shared->plant_state.load() == PLANT_DONE ? 0 : 1);
+        }
+    } else {
+        plant_thread = std::thread(plant_loop, shared, std::cref(config), std::cref(make_plant), cycles);
+    }
+
+    // Controller side
+    for (std::uint64_t k = 0; k < cycles; ++k) {
+        if (shared->plant_state.load(std::memory_order_acquire) == PLANT_FAILED) break;
+        const std::int64_t deadline = shared->start_ns + static_cast<std::int64_t>(k) * config.period_ns +
+                                      config.controller_offset_ns;
+        const std::int64_t wake = sleep_until(deadline);
+        result.controller_wakeup.add(wake - deadline);
+
+        CosimSample measurement;
+        if (shared->measurements.popLatest(measurement)) {
+            result.ring_wait.add(monotonic_now() - measurement.sent_ns);
+            latest = measurement;
+        }
+        if (latest.cycle != static_cast<std::int64_t>(k)) ++result.stale_measurements;
+
+        double u = controller->compute(config.setpoint, latest.joint.position);
+        if (!shared->commands.push(make_command(latest, config.setpoint, u))) ++result.dropped;
+    }
+
+    if (plant_pid > 0) {
+        int status = 0;
+        while (waitpid(plant_pid, &status, 0) < 0 && errno == EINTR) {
+        }
+    } else if (plant_thread.joinable()) {
+        plant_thread.join();
+    }
+    if (shared->plant_state.load(std::memory_order_acquire) != PLANT_DONE) {
+        printf("Cosim: plant side did not complete\n");
+        return result;
+    }
+
+    // Merge plant side statistics and evaluate the co-simulated response
+    result.loop_delay = shared->loop_delay;
+    result.plant_wakeup = shared->wakeup;
+    result.ring_wait.merge(shared->ring_wait);
+    result.late_commands = shared->late_commands;
+    result.dropped += shared->dropped;
+
+    PerformanceMetrics metrics;
+    if (!config.output_file.empty()) metrics.stream_to_file(config.output_file);
+    const TraceEntry* trace = shared->trace();
+    for (std::uint64_t k = 0; k < cycles; ++k) {
+        metrics.add_data_point(k * dt, config.setpoint, trace[k].process_val, trace[k].output);
+        result.max_deviation = std::max(result.max_deviation, std::fabs(trace[k].process_val - ideal_trace[k]));
+    }
+    fill_response(metrics, result.cosim);
+    result.ok = true;
+    return result;
+}
+
+void print_cosim_result(const CosimResult& result)
+{
+    printf("Co-simulation: %llu cycles%s\n", static_cast<unsigned long long>(result.cycles),
+           result.ok ? "" : " (failed)");
+
+    const LatencyHistogram* histograms[] = {&result.loop_delay, &result.ring_wait,
+                                            &result.plant_wakeup, &result.controller_wakeup};
+    const char* names[] = {"loop delay", "ring wait", "plant wakeup", "ctrl wakeup"};
+    printf("%-14s %10s %10s %10s %10s %10s\n", "[us]", "samples", "min", "mean", "p99", "max");
+    for (int i = 0; i < 4; ++i) {
+        const LatencyHistogram& h = *histograms[i];
+        printf("%-14s %10llu %10.1f %10.1f %10.1f %10.1f\n", names[i], static_cast<unsigned long long>(h.count()),
+               h.min() * 1e-3, h.mean() * 1e-3, h.percentile(0.99) * 1e-3, h.max() * 1e-3);
+    }
+    printf("Stale measurements: %llu, late commands: %llu, dropped: %llu\n",
+           static_cast<unsigned long long>(result.stale_measurements),
+           static_cast<unsigned long long>(result.late_commands), static_cast<unsigned long long>(result.dropped));
+
+    printf("%-10s %10s %10s %10s %12s %10s %10s\n", "", "rise", "overshoot", "settling", "ss_error", "IAE", "ITAE");
+    const CosimResponse* responses[] = {&result.ideal, &result.cosim};
+    const char* labels[] = {"inline", "cosim"};
+    for (int i = 0; i < 2; ++i) {
+        const CosimResponse& r = *responses[i];
+        printf("%-10s %10.4f %9.2f%% %10.4f %12.3e %10.5f %10.5f\n", labels[i], r.rise_time, r.overshoot,
+               r.settling_time, r.steady_state_error, r.iae, r.itae);
+    }
+    printf("Max deviation from inline response: %.3e\n", result.max_deviation);
+}
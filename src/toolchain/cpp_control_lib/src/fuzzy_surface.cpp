@@ -0,0 +1,138 @@
+// Precompiled fuzzy inference surface implementation
+#include "fuzzy_surface.hpp"
+#include <cmath>
+
+namespace {
+
+// Universe of discourse of every fuzzy variable
+const double kUniverse = 3.0;
+
+double gaussian_mf(double x, double center, double sigma)
+{
+    double d = x - center;
+    return std::exp(-(d * d) / (2.0 * sigma * sigma));
+}
+
+// Centroid defuzzification over output singletons at -3..3
+double centroid(const double* mu)
+{
+    double numerator = 0.0;
+    double denominator = 0.0;
+    for (int i = 0; i < FuzzySurface::num_sets; ++i) {
+        numerator += (i - kUniverse) * mu[i];
+        denominator += mu[i];
+    }
+    return denominator == 0.0 ? 0.0 : numerator / denominator;
+}
+
+} // namespace
+
+FuzzySurface::FuzzySurface()
+    : resolution(0), e_scale(0.0), ec_scale(0.0), grid_offset(0.0)
+{
+}
+
+void FuzzySurface::infer(const int (*kp_rules)[num_sets], const int (*ki_rules)[num_sets],
+                         const int (*kd_rules)[num_sets], double e_norm, double ec_norm,
+                         double sigma, double& delta_kp, double& delta_ki, double& delta_kd)
+{
+    double mu_e[num_sets];
+    double mu_ec[num_sets];
+    for (int i = 0; i < num_sets; ++i) {
+        mu_e[i] = gaussian_mf(e_norm, i - kUniverse, sigma);
+        mu_ec[i] = gaussian_mf(ec_norm, i - kUniverse, sigma);
+    }
+
+    // Rule strength by min, aggregation by max
+    double mu_kp[num_sets] = {0.0};
+    double mu_ki[num_sets] = {0.0};
+    double mu_kd[num_sets] = {0.0};
+    for (int i = 0; i < num_sets; ++i) {
+        for (int j = 0; j < num_sets; ++j) {
+            double strength = mu_e[i] < mu_ec[j] ? mu_e[i] : mu_ec[j];
+            int kp_idx = kp_rules[i][j] + 3;
+            int ki_idx = ki_rules[i][j] + 3;
+            int kd_idx = kd_rules[i][j] + 3;
+            if (strength > mu_kp[kp_idx]) mu_kp[kp_idx] = strength;
+            if (strength > mu_ki[ki_idx]) mu_ki[ki_idx] = strength;
+            if (strength > mu_kd[kd_idx]) mu_kd[kd_idx] = strength;
+        }
+    }
+
+    delta_kp = centroid(mu_kp);
+    delta_ki = centroid(mu_ki);
+    delta_kd = centroid(mu_kd);
+}
+
+void FuzzySurface::build(const int (*kp_rules)[num_sets], const int (*ki_rules)[num_sets],
+                         const int (*kd_rules)[num_sets], double e_range, double ec_range,
+                         int resolution_val, double sigma)
+{
+    resolution = resolution_val < 2 ? 2 : resolution_val;
+
+    // Sample the rule base at every grid node, node k sits at -3 + k * step
+    const double step = 2.0 * kUniverse / (resolution - 1);
+    std::vector<double> nodes(static_cast<std::size_t>(resolution) * resolution * 3);
+    for (int i = 0; i < resolution; ++i) {
+        for (int j = 0; j < resolution; ++j) {
+            double* node = &nodes[(static_cast<std::size_t>(i) * resolution + j) * 3];
+            infer(kp_rules, ki_rules, kd_rules, -kUniverse + i * step, -kUniverse + j * step,
+                  sigma, node[0], node[1], node[2]);
+        }
+    }
+
+    // Convert node samples to per-cell bilinear coefficients so evaluate()
+    // reads one contiguous cell: v = c0 + fx * (cx + fy * cxy) + fy * cy
+    const int cells = resolution - 1;
+    table.assign(static_cast<std::size_t>(cells) * cells * cell_stride, 0.0);
+    for (int i = 0; i < cells; ++i) {
+        for (int j = 0; j < cells; ++j) {
+            const double* n00 = &nodes[(static_cast<std::size_t>(i) * resolution + j) * 3];
+            const double* n01 = n00 + 3;
+            const double* n10 = n00 + static_cast<std::size_t>(resolution) * 3;
+            const double* n11 = n10 + 3;
+            double* cell = &table[(static_cast<std::size_t>(i) * cells + j) * cell_stride];
+            for (int k = 0; k < 3; ++k) {
+                cell[4 * k + 0] = n00[k];
+                cell[4 * k + 1] = n10[k] - n00[k];
+                cell[4 * k + 2] = n01[k] - n00[k];
+                cell[4 * k + 3] = n11[k] - n10[k] - n01[k] + n00[k];
+            }
+        }
+    }
+
+    // Physical input x maps to grid coordinate (x * 3 / range + 3) / step
+    e_scale = kUniverse / (e_range * step);
+    ec_scale = kUniverse / (ec_range * step);
+    grid_offset = kUniverse / step;
+}
+
+void FuzzySurface::evaluate(double e, double ec, double& delta_kp, double& delta_ki, double& delta_kd) const
+{
+    if (table.empty()) {
+        delta_kp = delta_ki = delta_kd = 0.0;
+        return;
+    }
+
+    // Continuous grid coordinates, clamped just inside the last cell so the
+    // cell index needs no further check. Written as select expressions so the
+    // compiler emits branchless min/max; NaN inputs map to the first cell.
+    const int cells = resolution - 1;
+    const double upper = cells - 1e-9;
+    double x = e * e_scale + grid_offset;
+    double y = ec * ec_scale + grid_offset;
+    x = x > 0.0 ? x : 0.0;
+    y = y > 0.0 ? y : 0.0;
+    x = x < upper ? x : upper;
+    y = y < upper ? y : upper;
+
+    int i = static_cast<int>(x);
+    int j = static_cast<int>(y);
+    double fx = x - i;
+    double fy = y - j;
+
+    const double* cell = &table[(static_cast<std::size_t>(i) * cells + j) * cell_stride];
+    delta_kp = cell[0] + fx * (cell[1] + fy * cell[3]) + fy * cell[2];
+    delta_ki = cell[4] + fx * (cell[5] + fy * cell[7]) + fy * cell[6];
+    delta_kd = cell[8] + fx * (cell[9] + fy * cell[11]) + fy * cell[10];
+}
@@ -0,0 +1,375 @@
+// Parallel controller gain optimizer implementation
+#include "gain_optimizer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include "performance_metrics.hpp"
+#include "pid_controller.hpp"
+#include "thread_pool.hpp"
+
+namespace {
+
+// Cost assigned to simulations whose output leaves kDivergenceLimit times the setpoint
+const double kDivergedCost = 1e9;
+const double kDivergenceLimit = 100.0;
+
+// Nelder-Mead coefficients
+const double kReflection = 1.0;
+const double kExpansion = 2.0;
+const double kContraction = 0.5;
+const double kShrink = 0.5;
+
+typedef std::vector<double> Point;
+
+std::size_t num_dimensions(TunedController controller)
+{
+    return controller == TUNE_ADAPTIVE_PID ? 4 : 3;
+}
+
+Point to_point(const GainSet& gains, std::size_t dims)
+{
+    Point point(dims);
+    point[0] = gains.kp;
+    point[1] = gains.ki;
+    point[2] = gains.kd;
+    if (dims > 3) point[3] = gains.gamma;
+    return point;
+}
+
+GainSet to_gains(const Point& point, const GainSet& defaults)
+{
+    GainSet gains = defaults;
+    gains.kp = point[0];
+    gains.ki = point[1];
+    gains.kd = point[2];
+    if (point.size() > 3) gains.gamma = point[3];
+    return gains;
+}
+
+// Project a point into the search box
+void clamp_point(Point& point, const Point& lower, const Point& upper)
+{
+    for (std::size_t d = 0; d < point.size(); ++d) {
+        point[d] = std::min(std::max(point[d], lower[d]), upper[d]);
+    }
+}
+
+// Cost of one scenario; stops once the weighted running cost exceeds cutoff
+double simulate(const GainOptimizerConfig& config, const TuningScenario& scenario, const GainSet& gains,
+                double cutoff, bool& stopped_early)
+{
+    std::unique_ptr<SystemModel> plant = scenario.make_plant();
+    std::unique_ptr<Controller> controller = make_tuned_controller(config.controller, gains, config.dt);
+    PerformanceMetrics metrics;
+
+    const int steps = static_cast<int>(config.simulation_time / config.dt);
+    const double setpoint = scenario.setpoint;
+    const double limit = kDivergenceLimit * std::max(1.0, std::fabs(setpoint));
+    double process_val = 0.0;
+
+    for (int i = 0; i < steps; ++i) {
+        double t = i * config.dt;
+        double u = controller->compute(setpoint, process_val);
+        process_val = plant->compute(u);
+        if (!(std::fabs(process_val) < limit)) {
+            return scenario.weight * kDivergedCost;
+        }
+        metrics.add_data_point(t, setpoint, process_val, u);
+
+        // The integral terms only grow, so they bound the final cost from below
+        double running = scenario.weight * (metrics.calculate_itae() +
+                                            config.effort_weight * metrics.calculate_control_effort());
+        if (running > cutoff) {
+            stopped_early = true;
+            return running;
+        }
+    }
+
+    double cost = metrics.calculate_itae() + config.effort_weight * metrics.calculate_control_effort() +
+                  config.overshoot_weight * metrics.calculate_overshoot() +
+                  config.steady_state_weight * metrics.calculate_steady_state_error();
+    return scenario.weight * cost;
+}
+
+// Evaluation counters shared by all threads
+struct Counters {
+    std::atomic<std::size_t> evaluations;
+    std::atomic<std::size_t> early_stops;
+};
+
+double counted_evaluate(const GainOptimizerConfig& config, const std::vector<TuningScenario>& scenarios,
+                        const GainSet& gains, double cutoff, Counters& counters)
+{
+    bool stopped = false;
+    double cost = evaluate_gains(config, scenarios, gains, cutoff, &stopped);
+    counters.evaluations.fetch_add(1, std::memory_order_relaxed);
+    if (stopped) counters.early_stops.fetch_add(1, std::memory_order_relaxed);
+    return cost;
+}
+
+// Runs fn(i) for every i in [0, count), serially or across a thread pool
+typedef std::function<void(std::size_t, const std::function<void(std::size_t)>&)> ForEach;
+
+void serial_for(std::size_t count, const std::function<void(std::size_t)>& fn)
+{
+    for (std::size_t i = 0; i < count; ++i) fn(i);
+}
+
+// One bounded Nelder-Mead run from seed. Trial points are evaluated with
+// the worst vertex cost as cutoff: every decision only compares a trial
+// against the worst or better vertices, so stopping early never changes
+// the path of the search. The independent vertex evaluations of the initial
+// simplex and of a shrink step go through for_each.
+void nelder_mead(const GainOptimizerConfig& config, const std::vector<TuningScenario>& scenarios,
+                 const Point& seed, double seed_cost, const Point& step,
+                 const Point& lower, const Point& upper, const ForEach& for_each, Counters& counters,
+                 Point& best_point, double& best_cost)
+{
+    const std::size_t dims = seed.size();
+    std::vector<Point> simplex(dims + 1, seed);
+    std::vector<double> costs(dims + 1, seed_cost);
+    for_each(dims, [&](std::size_t d) {
+        Point& vertex = simplex[d + 1];
+        vertex[d] += (seed[d] + step[d] <= upper[d]) ? step[d] : -step[d];
+        clamp_point(vertex, lower, upper);
+        costs[d + 1] = counted_evaluate(config, scenarios, to_gains(vertex, config.lower), HUGE_VAL, counters);
+    });
+
+    std::vector<std::size_t> order(dims + 1);
+    for (int iteration = 0; iteration < config.max_iterations; ++iteration) {
+        for (std::size_t i = 0; i <= dims; ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return costs[a] < costs[b];
+        });
+        const std::size_t best = order[0];
+        const std::size_t worst = order[dims];
+        const std::size_t second_worst = order[dims - 1];
+        if (costs[worst] - costs[best] < config.tolerance) {
+            break;
+        }
+
+        // Centroid of all vertices except the worst
+        Point centroid(dims, 0.0);
+        for (std::size_t i = 0; i <= dims; ++i) {
+            if (i == worst) continue;
+            for (std::size_t d = 0; d < dims; ++d) centroid[d] += simplex[i][d] / dims;
+        }
+
+        Point reflected(dims);
+        for (std::size_t d = 0; d < dims; ++d) {
+            reflected[d] = centroid[d] + kReflection * (centroid[d] - simplex[worst][d]);
+        }
+        clamp_point(reflected, lower, upper);
+        double reflected_cost = counted_evaluate(config, scenarios, to_gains(reflected, config.lower),
+                                                 costs[worst], counters);
+
+        if (reflected_cost < costs[best]) {
+            Point expanded(dims);
+            for (std::size_t d = 0; d < dims; ++d) {
+                expanded[d] = centroid[d] + kExpansion * (reflected[d] - centroid[d]);
+            }
+            clamp_point(expanded, lower, upper);
+            double expanded_cost = counted_evaluate(config, scenarios, to_gains(expanded, config.lower),
+                                                    reflected_cost, counters);
+            if (expanded_cost < reflected_cost) {
+                simplex[worst] = expanded;
+                costs[worst] = expanded_cost;
+            } else {
+                simplex[worst] = reflected;
+                costs[worst] = reflected_cost;
+            }
+            continue;
+        }
+        if (reflected_cost < costs[second_worst]) {
+            simplex[worst] = reflected;
+            costs[worst] = reflected_cost;
+            continue;
+        }
+
+        // Contract towards the better of the worst vertex and the reflection
+        bool outside = reflected_cost < costs[worst];
+        const Point& anchor = outside ? reflected : simplex[worst];
+        double anchor_cost = outside ? reflected_cost : costs[worst];
+        Point contracted(dims);
+        for (std::size_t d = 0; d < dims; ++d) {
+            contracted[d] = centroid[d] + kContraction * (anchor[d] - centroid[d]);
+        }
+        double contracted_cost = counted_evaluate(config, scenarios, to_gains(contracted, config.lower),
+                                                  anchor_cost, counters);
+        if (contracted_cost < anchor_cost) {
+            simplex[worst] = contracted;
+            costs[worst] = contracted_cost;
+            continue;
+        }
+
+        // Shrink towards the best vertex; shrunk vertices need exact costs
+        for_each(dims, [&](std::size_t k) {
+            std::size_t i = order[k + 1];
+            for (std::size_t d = 0; d < dims; ++d) {
+                simplex[i][d] = simplex[best][d] + kShrink * (simplex[i][d] - simplex[best][d]);
+            }
+            costs[i] = counted_evaluate(config, scenarios, to_gains(simplex[i], config.lower), HUGE_VAL, counters);
+        });
+    }
+
+    std::size_t best = 0;
+    for (std::size_t i = 1; i <= dims; ++i) {
+        if (costs[i] < costs[best]) best = i;
+    }
+    best_point = simplex[best];
+    best_cost = costs[best];
+}
+
+} // namespace
+
+GainOptimizerConfig default_optimizer_config(TunedController controller)
+{
+    GainOptimizerConfig config;
+    config.controller = controller;
+    config.dt = 0.1;
+    config.simulation_time = 20.0;
+    config.lower.kp = 0.0;
+    config.lower.ki = 0.0;
+    config.lower.kd = 0.0;
+    config.lower.gamma = controller == TUNE_ADAPTIVE_PID ? 0.0 : 0.01;
+    config.upper.kp = 10.0;
+    config.upper.ki = 5.0;
+    config.upper.kd = 2.0;
+    config.upper.gamma = controller == TUNE_ADAPTIVE_PID ? 0.1 : 0.01;
+    config.grid_points = 5;
+    config.num_starts = 8;
+    config.max_iterations = 100;
+    config.tolerance = 1e-6;
+    config.num_threads = 0;
+    config.overshoot_weight = 0.05;
+    config.steady_state_weight = 10.0;
+    config.effort_weight = 0.001;
+    return config;
+}
+
+std::vector<TuningScenario> default_tuning_scenarios(double dt)
+{
+    std::vector<TuningScenario> scenarios(3);
+    scenarios[0].name = "FirstOrderSystem";
+    scenarios[0].make_plant = [dt]() {
+        return std::unique_ptr<SystemModel>(new FirstOrderSystem(1.0, 1.0, dt));
+    };
+    scenarios[1].name = "SecondOrderSystem";
+    scenarios[1].make_plant = [dt]() {
+        return std::unique_ptr<SystemModel>(new SecondOrderSystem(1.0, 0.7, 1.0, dt));
+    };
+    scenarios[2].name = "NonlinearSystem";
+    scenarios[2].make_plant = [dt]() {
+        return std::unique_ptr<SystemModel>(new NonlinearSystem(1.0, 1.0, 0.5, 0.1, dt));
+    };
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        scenarios[i].setpoint = 1.0;
+        scenarios[i].weight = 1.0;
+    }
+    // Saturation and deadzone cap the nonlinear plant output at 0.4
+    scenarios[2].setpoint = 0.3;
+    return scenarios;
+}
+
+std::unique_ptr<Controller> make_tuned_controller(TunedController controller, const GainSet& gains, double dt)
+{
+    switch (controller) {
+    case TUNE_INCREMENTAL_PID:
+        return std::unique_ptr<Controller>(new IncrementalPIDController(gains.kp, gains.ki, gains.kd, dt));
+    case TUNE_FUZZY_PID:
+        return std::unique_ptr<Controller>(new FuzzyPIDController(gains.kp, gains.ki, gains.kd, dt));
+    case TUNE_ADAPTIVE_PID:
+        return std::unique_ptr<Controller>(new AdaptivePIDController(gains.kp, gains.ki, gains.kd, dt, gains.gamma));
+    default:
+        return std::unique_ptr<Controller>(new PIDController(gains.kp, gains.ki, gains.kd, dt));
+    }
+}
+
+double evaluate_gains(const GainOptimizerConfig& config, const std::vector<TuningScenario>& scenarios,
+                      const GainSet& gains, double cutoff, bool* stopped_early)
+{
+    bool stopped = false;
+    double total = 0.0;
+    for (std::size_t i = 0; i < scenarios.size() && !stopped; ++i) {
+        total += simulate(config, scenarios[i], gains, cutoff - total, stopped);
+    }
+    if (stopped_early) *stopped_early = stopped;
+    return total;
+}
+
+GainOptimizerResult optimize_gains(const GainOptimizerConfig& config, const std::vector<TuningScenario>& scenarios)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ThreadPool pool(config.num_threads);
+    Counters counters;
+    counters.evaluations.store(0);
+    counters.early_stops.store(0);
+
+    const std::size_t dims = num_dimensions(config.controller);
+    const Point lower = to_point(config.lower, dims);
+    const Point upper = to_point(config.upper, dims);
+    const std::size_t points_per_dim = static_cast<std::size_t>(std::max(1, config.grid_points));
+
+    // Coarse grid over cell centers of the search box
+    std::size_t grid_size = 1;
+    for (std::size_t d = 0; d < dims; ++d) grid_size *= points_per_dim;
+    Point step(dims);
+    for (std::size_t d = 0; d < dims; ++d) step[d] = (upper[d] - lower[d]) / points_per_dim;
+
+    std::vector<Point> grid(grid_size, Point(dims));
+    std::vector<double> grid_costs(grid_size);
+    pool.parallelFor(grid_size, [&](std::size_t index) {
+        std::size_t rest = index;
+        for (std::size_t d = 0; d < dims; ++d) {
+            grid[index][d] = lower[d] + step[d] * (rest % points_per_dim + 0.5);
+            rest /= points_per_dim;
+        }
+        grid_costs[index] = counted_evaluate(config, scenarios, to_gains(grid[index], config.lower),
+                                             HUGE_VAL, counters);
+    });
+
+    std::vector<std::size_t> ranking(grid_size);
+    for (std::size_t i = 0; i < grid_size; ++i) ranking[i] = i;
+    std::stable_sort(ranking.begin(), ranking.end(), [&](std::size_t a, std::size_t b) {
+        return grid_costs[a] < grid_costs[b];
+    });
+
+    // Independent Nelder-Mead runs from the best grid points
+    const std::size_t num_starts = std::min(grid_size, static_cast<std::size_t>(std::max(1, config.num_starts)));
+    Point half_step(dims);
+    for (std::size_t d = 0; d < dims; ++d) half_step[d] = 0.5 * step[d];
+    std::vector<Point> start_best(num_starts);
+    std::vector<double> start_cost(num_starts);
+    if (num_starts >= pool.size()) {
+        // Enough starts to keep every thread busy: one run per thread
+        pool.parallelFor(num_starts, [&](std::size_t s) {
+            std::size_t seed = ranking[s];
+            nelder_mead(config, scenarios, grid[seed], grid_costs[seed], half_step, lower, upper,
+                        serial_for, counters, start_best[s], start_cost[s]);
+        });
+    } else {
+        // Fewer starts than threads: run the starts in turn and spread the
+        // vertex evaluations of each run across the pool instead
+        ForEach pool_for = [&pool](std::size_t count, const std::function<void(std::size_t)>& fn) {
+            pool.parallelFor(count, fn);
+        };
+        for (std::size_t s = 0; s < num_starts; ++s) {
+            std::size_t seed = ranking[s];
+            nelder_mead(config, scenarios, grid[seed], grid_costs[seed], half_step, lower, upper,
+                        pool_for, counters, start_best[s], start_cost[s]);
+        }
+    }
+
+    std::size_t winner = 0;
+    for (std::size_t s = 1; s < num_starts; ++s) {
+        if (start_cost[s] < start_cost[winner]) winner = s;
+    }
+
+    GainOptimizerResult result;
+    result.best = to_gains(start_best[winner], config.lower);
+    result.best_cost = start_cost[winner];
+    result.evaluations = counters.evaluations.load();
+    result.early_stops = counters.early_stops.load();
+    result.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,154 @@
+// Reproducible multi-stream measurement noise generator implementation
+#include "noise_generator.hpp"
+#include <cmath>
+
+namespace {
+
+// Ziggurat with 128 layers of equal area under exp(-x^2/2) (Marsaglia and
+// Tsang, table layout after Doornik's ZIGNOR). x[0] is the width of the
+// base strip including the tail, x[1] = r is where the tail starts.
+const int kLayers = 128;
+const double kTailStart = 3.442619855899;
+const double kLayerArea = 9.91256303526217e-3;
+
+struct ZigguratTables {
+    double x[kLayers + 1];
+    double ratio[kLayers];      // x[i+1] / x[i], the fast path acceptance bound
+
+    ZigguratTables() {
+        double f = std::exp(-0.5 * kTailStart * kTailStart);
+        x[0] = kLayerArea / f;
+        x[1] = kTailStart;
+        x[kLayers] = 0.0;
+        for (int i = 2; i < kLayers; ++i) {
+            x[i] = std::sqrt(-2.0 * std::log(kLayerArea / x[i - 1] + f));
+            f = std::exp(-0.5 * x[i] * x[i]);
+        }
+        for (int i = 0; i < kLayers; ++i) {
+            ratio[i] = x[i + 1] / x[i];
+        }
+    }
+};
+
+const ZigguratTables& ziggurat_tables()
+{
+    static const ZigguratTables tables;
+    return tables;
+}
+
+// Standard normal sample. One 64-bit draw gives the layer (low 7 bits) and
+// a uniform in (-1, 1) (high 53 bits); the sample is accepted right away
+// when it lies inside the rectangle below the next layer.
+inline double sample_normal(Xoshiro256pp& rng, const ZigguratTables& t)
+{
+    for (;;) {
+        std::uint64_t bits = rng.next();
+        int i = static_cast<int>(bits & (kLayers - 1));
+        double u = 2.0 * (static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0)) - 1.0;
+        if (std::fabs(u) < t.ratio[i]) {
+            return u * t.x[i];
+        }
+
+        if (i == 0) {
+            // Tail beyond r (Marsaglia's method)
+            double x, y;
+            do {
+                x = std::log(1.0 - rng.uniform()) / kTailStart;
+                y = std::log(1.0 - rng.uniform());
+            } while (-2.0 * y < x * x);
+            return u < 0.0 ? x - kTailStart : kTailStart - x;
+        }
+
+        // Wedge between the layer rectangle and the density
+        double x0 = u * t.x[i];
+        double f0 = std::exp(-0.5 * (t.x[i] * t.x[i] - x0 * x0));
+        double f1 = std::exp(-0.5 * (t.x[i + 1] * t.x[i + 1] - x0 * x0));
+        if (f1 + rng.uniform() * (f0 - f1) < 1.0) {
+            return x0;
+        }
+    }
+}
+
+inline double sample_impulse(Xoshiro256pp& rng, const NoiseConfig& config)
+{
+    if (rng.uniform() < config.impulse_probability) {
+        return (rng.uniform() - 0.5) * 2.0 * config.max_impulse_amplitude;
+    }
+    return 0.0;
+}
+
+} // namespace
+
+void Xoshiro256pp::jump()
+{
+    static const std::uint64_t kJump[4] = {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+    std::uint64_t t[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; ++i) {
+        for (int b = 0; b < 64; ++b) {
+            if (kJump[i] & (1ULL << b)) {
+                for (int k = 0; k < 4; ++k) t[k] ^= s[k];
+            }
+            next();
+        }
+    }
+    for (int k = 0; k < 4; ++k) s[k] = t[k];
+}
+
+// Noise Stream Implementation
+NoiseStream::NoiseStream(const NoiseConfig& config_val, std::uint64_t seed_val, std::uint64_t stream_val)
+    : config(config_val), rng(seed_val, stream_val)
+{
+}
+
+double NoiseStream::standardNormal()
+{
+    return sample_normal(rng, ziggurat_tables());
+}
+
+double NoiseStream::gaussian()
+{
+    return config.mean + config.std_dev * sample_normal(rng, ziggurat_tables());
+}
+
+double NoiseStream::impulse()
+{
+    return sample_impulse(rng, config);
+}
+
+double NoiseStream::combined()
+{
+    double noise = gaussian();
+    return noise + impulse();
+}
+
+void NoiseStream::fillGaussian(double* out, std::size_t count)
+{
+    const ZigguratTables& tables = ziggurat_tables();
+    Xoshiro256pp local = rng;
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = config.mean + config.std_dev * sample_normal(local, tables);
+    }
+    rng = local;
+}
+
+void NoiseStream::fillImpulse(double* out, std::size_t count)
+{
+    Xoshiro256pp local = rng;
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = sample_impulse(local, config);
+    }
+    rng = local;
+}
+
+void NoiseStream::fillCombined(double* out, std::size_t count)
+{
+    const ZigguratTables& tables = ziggurat_tables();
+    Xoshiro256pp local = rng;
+    for (std::size_t i = 0; i < count; ++i) {
+        double noise = config.mean + config.std_dev * sample_normal(local, tables);
+        out[i] = noise + sample_impulse(local, config);
+    }
+    rng = local;
+}
@@ -0,0 +1,104 @@
+// Batched PID controller bank implementation
+#include "pid_bank.hpp"
+#include <cstdint>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PID_BANK_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define PID_BANK_RESTRICT __restrict
+#else
+#define PID_BANK_RESTRICT
+#endif
+
+namespace {
+
+// Number of arrays carved out of the backing storage
+const std::size_t kNumArrays = 5;
+
+// Round joint count up so every array starts on an alignment boundary
+std::size_t padded_length(std::size_t n)
+{
+    const std::size_t per_line = PIDBank::alignment / sizeof(double);
+    return ((n + per_line - 1) / per_line) * per_line;
+}
+
+// Batched position PID update. Restrict-qualified parameters let the compiler
+// prove that the arrays do not alias and vectorize the loop body.
+void compute_kernel(std::size_t n, double dt, double inv_dt,
+                    const double* PID_BANK_RESTRICT kp,
+                    const double* PID_BANK_RESTRICT ki,
+                    const double* PID_BANK_RESTRICT kd,
+                    double* PID_BANK_RESTRICT integral,
+                    double* PID_BANK_RESTRICT prev_pv,
+                    const double* PID_BANK_RESTRICT setpoints,
+                    const double* PID_BANK_RESTRICT process_vals,
+                    double* PID_BANK_RESTRICT outputs)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        double pv = process_vals[i];
+        double err = setpoints[i] - pv;
+        double p_term = kp[i] * err;
+
+        double i_term = integral[i] + ki[i] * err * dt;
+        integral[i] = i_term;
+
+        double d_term = kd[i] * (pv - prev_pv[i]) * inv_dt;
+
+        outputs[i] = p_term + i_term - d_term;
+        prev_pv[i] = pv;
+    }
+}
+
+} // namespace
+
+PIDBank::PIDBank(std::size_t num_joints_val, double kp_val, double ki_val, double kd_val, double dt_val)
+    : num_joints(num_joints_val), dt(dt_val), inv_dt(1.0 / dt_val), storage(nullptr),
+      kp(nullptr), ki(nullptr), kd(nullptr), integral(nullptr), prev_pv(nullptr)
+{
+    const std::size_t stride = padded_length(num_joints);
+    storage = new char[kNumArrays * stride * sizeof(double) + alignment];
+
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(storage);
+    base = (base + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    double* arrays = reinterpret_cast<double*>(base);
+
+    kp = arrays;
+    ki = arrays + stride;
+    kd = arrays + 2 * stride;
+    integral = arrays + 3 * stride;
+    prev_pv = arrays + 4 * stride;
+
+    for (std::size_t i = 0; i < num_joints; ++i) {
+        kp[i] = kp_val;
+        ki[i] = ki_val;
+        kd[i] = kd_val;
+    }
+    reset();
+}
+
+PIDBank::~PIDBank()
+{
+    delete[] storage;
+}
+
+void PIDBank::setGains(std::size_t joint, double kp_val, double ki_val, double kd_val)
+{
+    if (joint >= num_joints) return;
+    kp[joint] = kp_val;
+    ki[joint] = ki_val;
+    kd[joint] = kd_val;
+}
+
+void PIDBank::compute(const double* setpoints, const double* process_vals, double* outputs)
+{
+    compute_kernel(num_joints, dt, inv_dt, kp, ki, kd, integral, prev_pv,
+                   setpoints, process_vals, outputs);
+}
+
+void PIDBank::reset()
+{
+    for (std::size_t i = 0; i < num_joints; ++i) {
+        integral[i] = 0.0;
+        prev_pv[i] = 0.0;
+    }
+}
@@ -1,98 +1,218 @@
 // Controller Implementation
 #include "pid_controller.hpp"
 #include <cmath>
+#include <limits>
 
 // Position PID Controller Implementation
-PIDController::PIDController(double kp_val, double ki_val, double kd_val, double dt_val)
-    : kp(kp_val), ki(ki_val), kd(kd_val), dt(dt_val), prev_err(0.0), integral(0.0), prev_pv(0.0)
+template <typename Real>
+PIDControllerT<Real>::PIDControllerT(double kp_val, double ki_val, double kd_val, double dt_val)
+    : kp(kp_val), ki(ki_val), kd(kd_val), dt(dt_val), ki_dt(ki_val * dt_val), kd_over_dt(kd_val / dt_val),
+      output_min(-std::numeric_limits<double>::infinity()), output_max(std::numeric_limits<double>::infinity()),
+      prev_err(0.0), integral(0.0), integral_residue(0.0), prev_pv(0.0)
 {
 }
 
-double PIDController::compute(double setpoint, double process_val)
+template <typename Real>
+Real PIDControllerT<Real>::compute(Real setpoint, Real process_val)
 {
-    double err = setpoint - process_val;
-    double p_term = kp * err;
-    
-    integral += ki * err * dt;
-    double i_term = integral;
-    
-    double d_term = kd * (process_val - prev_pv) / dt;
-    
-    double output = p_term + i_term - d_term;
-    
+    // Pick up parameters published since the last cycle
+    PIDParameters params;
+    if (pending.poll(params)) {
+        applyParameters(params);
+    }
+
+    Real err = setpoint - process_val;
+    Real p_term = kp * err;
+
+    accumulate_product(integral, integral_residue, ki_dt, err);
+    Real i_term = integral;
+
+    Real d_term = kd_over_dt * (process_val - prev_pv);
+
+    Real output = p_term + i_term - d_term;
+    if (output > output_max) output = output_max;
+    if (output < output_min) output = output_min;
+
     prev_err = err;
     prev_pv = process_val;
-    
+
     return output;
 }
 
-void PIDController::reset()
+template <typename Real>
+void PIDControllerT<Real>::reset()
+{
+    prev_err = Real(0.0);
+    integral = Real(0.0);
+    integral_residue = Real(0.0);
+    prev_pv = Real(0.0);
+}
+
+template <typename Real>
+void PIDControllerT<Real>::setParameters(const PIDParameters& params)
 {
-    prev_err = 0.0;
-    integral = 0.0;
-    prev_pv = 0.0;
+    pending.publish(params);
+}
+
+template <typename Real>
+PIDParameters PIDControllerT<Real>::parameters() const
+{
+    PIDParameters params;
+    params.kp = static_cast<double>(kp);
+    params.ki = static_cast<double>(ki);
+    params.kd = static_cast<double>(kd);
+    params.dt = static_cast<double>(dt);
+    params.output_min = static_cast<double>(output_min);
+    params.output_max = static_cast<double>(output_max);
+    return params;
+}
+
+template <typename Real>
+void PIDControllerT<Real>::applyParameters(const PIDParameters& params)
+{
+    // Bumpless transfer: keep kp * prev_err + integral unchanged
+    Real new_kp(params.kp);
+    integral += (kp - new_kp) * prev_err;
+
+    kp = new_kp;
+    ki = Real(params.ki);
+    kd = Real(params.kd);
+    dt = Real(params.dt);
+    ki_dt = Real(params.ki * params.dt);
+    kd_over_dt = Real(params.kd / params.dt);
+    output_min = Real(params.output_min);
+    output_max = Real(params.output_max);
+}
+
+template <typename Real>
+Real PIDControllerT<Real>::* const PIDControllerT<Real>::state_fields[12] = {
+    &PIDControllerT<Real>::kp, &PIDControllerT<Real>::ki, &PIDControllerT<Real>::kd,
+    &PIDControllerT<Real>::dt, &PIDControllerT<Real>::ki_dt, &PIDControllerT<Real>::kd_over_dt,
+    &PIDControllerT<Real>::output_min, &PIDControllerT<Real>::output_max, &PIDControllerT<Real>::prev_err,
+    &PIDControllerT<Real>::integral, &PIDControllerT<Real>::integral_residue, &PIDControllerT<Real>::prev_pv
+};
+
+template <typename Real>
+std::size_t PIDControllerT<Real>::stateSize() const
+{
+    return controller_state_size<Real, 12>();
+}
+
+template <typename Real>
+std::size_t PIDControllerT<Real>::saveState(void* buffer, std::size_t capacity) const
+{
+    return save_controller_state(*this, state_fields, STATE_PID, buffer, capacity);
+}
+
+template <typename Real>
+bool PIDControllerT<Real>::restoreState(const void* buffer, std::size_t size)
+{
+    return restore_controller_state(*this, state_fields, STATE_PID, buffer, size);
+}
+
+template <typename Real>
+bool PIDControllerT<Real>::checkState(const void* buffer, std::size_t size) const
+{
+    return check_controller_state<Real, 12>(STATE_PID, buffer, size);
 }
 
 // Incremental PID Controller Implementation
-IncrementalPIDController::IncrementalPIDController(double kp_val, double ki_val, double kd_val, double dt_val)
-    : kp(kp_val), ki(ki_val), kd(kd_val), dt(dt_val), prev_err1(0.0), prev_err2(0.0)
+template <typename Real>
+IncrementalPIDControllerT<Real>::IncrementalPIDControllerT(double kp_val, double ki_val, double kd_val, double dt_val)
+    : kp(kp_val), ki_dt(ki_val * dt_val), kd_over_dt(kd_val / dt_val), prev_err1(0.0), prev_err2(0.0)
 {
 }
 
-double IncrementalPIDController::compute(double setpoint, double process_val)
+template <typename Real>
+Real IncrementalPIDControllerT<Real>::compute(Real setpoint, Real process_val)
 {
-    double err = setpoint - process_val;
-    double delta_u = kp * (err - prev_err1) + ki * err * dt + kd * (err - 2.0 * prev_err1 + prev_err2) / dt;
-    
+    Real err = setpoint - process_val;
+    Real delta_u = kp * (err - prev_err1) + ki_dt * err + kd_over_dt * (err - prev_err1 - prev_err1 + prev_err2);
+
     prev_err2 = prev_err1;
     prev_err1 = err;
-    
+
     return delta_u;
 }
 
-void IncrementalPIDController::reset()
+template <typename Real>
+void IncrementalPIDControllerT<Real>::reset()
+{
+    prev_err1 = Real(0.0);
+    prev_err2 = Real(0.0);
+}
+
+template <typename Real>
+Real IncrementalPIDControllerT<Real>::* const IncrementalPIDControllerT<Real>::state_fields[5] = {
+    &IncrementalPIDControllerT<Real>::kp, &IncrementalPIDControllerT<Real>::ki_dt,
+    &IncrementalPIDControllerT<Real>::kd_over_dt, &IncrementalPIDControllerT<Real>::prev_err1,
+    &IncrementalPIDControllerT<Real>::prev_err2
+};
+
+template <typename Real>
+std::size_t IncrementalPIDControllerT<Real>::stateSize() const
+{
+    return controller_state_size<Real, 5>();
+}
+
+template <typename Real>
+std::size_t IncrementalPIDControllerT<Real>::saveState(void* buffer, std::size_t capacity) const
 {
-    prev_err1 = 0.0;
-    prev_err2 = 0.0;
+    return save_controller_state(*this, state_fields, STATE_INCREMENTAL_PID, buffer, capacity);
+}
+
+template <typename Real>
+bool IncrementalPIDControllerT<Real>::restoreState(const void* buffer, std::size_t size)
+{
+    return restore_controller_state(*this, state_fields, STATE_INCREMENTAL_PID, buffer, size);
+}
+
+template <typename Real>
+bool IncrementalPIDControllerT<Real>::checkState(const void* buffer, std::size_t size) const
+{
+    return check_controller_state<Real, 5>(STATE_INCREMENTAL_PID, buffer, size);
 }
 
 // Fuzzy PID Controller Implementation
 
-FuzzyPIDController::FuzzyPIDController(double kp_val, double ki_val, double kd_val, double dt_val)
-    : kp(kp_val), ki(ki_val), kd(kd_val), dt(dt_val), prev_err(0.0), prev_pv(0.0), integral(0.0)
+template <typename Real>
+FuzzyPIDControllerT<Real>::FuzzyPIDControllerT(double kp_val, double ki_val, double kd_val, double dt_val,
+                                               InferenceMode mode_val, double e_range, double ec_range)
+    : kp(kp_val), ki_dt(ki_val * dt_val), kd_over_dt(kd_val / dt_val), dt(dt_val),
+      prev_err(0.0), prev_pv(0.0), integral(0.0), integral_residue(0.0), mode(mode_val)
 {
     // Optimized fuzzy rule tables for better performance
     // Rule table values: -3=NB, -2=NM, -1=NS, 0=ZO, 1=PS, 2=PM, 3=PB
     int kp_rules[7][7] = {
-        {3, 3, 2, 2, 2, 1, 0}, 
-        {3, 3, 2, 2, 1, 1, -1}, 
-        {2, 2, 2, 1, 0, -1, -2}, 
-        {2, 1, 0, -1, -1, -2, -2}, 
-        {1, 1, 0, -1, -2, -2, -2}, 
-        {1, 0, -1, -2, -2, -3, -3}, 
+        {3, 3, 2, 2, 2, 1, 0},
+        {3, 3, 2, 2, 1, 1, -1},
+        {2, 2, 2, 1, 0, -1, -2},
+        {2, 1, 0, -1, -1, -2, -2},
+        {1, 1, 0, -1, -2, -2, -2},
+        {1, 0, -1, -2, -2, -3, -3},
         {0, 0, -1, -2, -3, -3, -3}
     };
-    
+
     int ki_rules[7][7] = {
-        {-3, -3, -3, -2, -2, -1, 0}, 
-        {-3, -3, -2, -2, -1, 0, 0}, 
-        {-2, -2, -1, -1, 0, 1, 1}, 
-        {-2, -1, 0, 1, 1, 2, 2}, 
-        {-1, 0, 1, 1, 2, 2, 3}, 
-        {0, 0, 1, 2, 2, 3, 3}, 
+        {-3, -3, -3, -2, -2, -1, 0},
+        {-3, -3, -2, -2, -1, 0, 0},
+        {-2, -2, -1, -1, 0, 1, 1},
+        {-2, -1, 0, 1, 1, 2, 2},
+        {-1, 0, 1, 1, 2, 2, 3},
+        {0, 0, 1, 2, 2, 3, 3},
         {0, 1, 2, 2, 3, 3, 3}
     };
-    
+
     int kd_rules[7][7] = {
-        {2, 1, -1, -2, -2, -2, 0}, 
-        {2, 1, -1, -2, -2, -1, 0}, 
-        {1, 1, -1, -1, -1, -1, 0}, 
-        {1, 0, 0, 0, 0, 0, 0}, 
-        {0, 0, 0, 0, 0, 0, 0}, 
-        {0, 1, 1, 1, 1, 1, 2}, 
+        {2, 1, -1, -2, -2, -2, 0},
+        {2, 1, -1, -2, -2, -1, 0},
+        {1, 1, -1, -1, -1, -1, 0},
+        {1, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0},
+        {0, 1, 1, 1, 1, 1, 2},
         {0, 2, 2, 2, 1, 1, 2}
     };
-    
+
     // Copy rule tables to member variables
     for (int i = 0; i < 7; i++) {
         for (int j = 0; j < 7; j++) {
@@ -101,244 +221,411 @@ FuzzyPIDController::FuzzyPIDController(double kp_val, double ki_val, double kd_v
             delta_kd_rules[i][j] = kd_rules[i][j];
         }
     }
+
+    // Fuzzification interval bounds; error-rate bounds are scaled by dt
+    const double bounds[6] = {-1.5, -0.5, -0.1, 0.1, 0.5, 1.5};
+    for (int i = 0; i < 6; i++) {
+        err_bounds[i] = Real(bounds[i]);
+        err_change_bounds[i] = Real(bounds[i] * dt_val);
+    }
+
+    // Defuzzification ranges
+    const double kp_range = 0.5;
+    const double ki_range = 0.1;
+    const double kd_range = 0.2;
+
+    // Precompute the gain adjustment of every fuzzy level
+    for (int level = NB; level <= PB; level++) {
+        FuzzyVariable value = static_cast<FuzzyVariable>(level);
+        delta_kp_levels[level + 3] = Real(defuzzify(value, kp_range));
+        delta_ki_dt_levels[level + 3] = Real(defuzzify(value, ki_range) * dt_val);
+        delta_kd_over_dt_levels[level + 3] = Real(defuzzify(value, kd_range) / dt_val);
+    }
+
+    // Sample the Gaussian rule surface once so compute() stays O(1).
+    // The error-rate axis is scaled by dt so compute() can pass the raw error
+    // difference and keep the division off the critical path.
+    if (mode == SMOOTH)
+    {
+        surface.build(delta_kp_rules, delta_ki_rules, delta_kd_rules, e_range, ec_range * dt_val);
+    }
 }
 
-double FuzzyPIDController::gaussian(double x, double mean, double sigma)
+template <typename Real>
+double FuzzyPIDControllerT<Real>::gaussian(double x, double mean, double sigma)
 {
     return exp(-pow(x - mean, 2) / (2 * pow(sigma, 2)));
 }
 
-void FuzzyPIDController::fuzzify(double err, double err_dot, FuzzyVariable& fuzzy_err, FuzzyVariable& fuzzy_err_dot)
+template <typename Real>
+typename FuzzyPIDControllerT<Real>::FuzzyVariable FuzzyPIDControllerT<Real>::quantize(Real value, const Real* bounds)
 {
-    // Fuzzify error
-    if (err <= -1.5)
+    if (value <= bounds[0])
     {
-        fuzzy_err = NB;
+        return NB;
     }
-    else if (err <= -0.5)
+    else if (value <= bounds[1])
     {
-        fuzzy_err = NM;
+        return NM;
     }
-    else if (err <= -0.1)
+    else if (value <= bounds[2])
     {
-        fuzzy_err = NS;
+        return NS;
     }
-    else if (err <= 0.1)
+    else if (value <= bounds[3])
     {
-        fuzzy_err = ZO;
+        return ZO;
     }
-    else if (err <= 0.5)
+    else if (value <= bounds[4])
     {
-        fuzzy_err = PS;
+        return PS;
     }
-    else if (err <= 1.5)
+    else if (value <= bounds[5])
     {
-        fuzzy_err = PM;
+        return PM;
     }
     else
     {
-        fuzzy_err = PB;
+        return PB;
     }
-    
+}
+
+template <typename Real>
+void FuzzyPIDControllerT<Real>::fuzzify(Real err, Real err_change, FuzzyVariable& fuzzy_err, FuzzyVariable& fuzzy_err_dot)
+{
+    // Fuzzify error
+    fuzzy_err = quantize(err, err_bounds);
+
     // Fuzzify error derivative
-    if (err_dot <= -1.5)
-    {
-        fuzzy_err_dot = NB;
-    }
-    else if (err_dot <= -0.5)
-    {
-        fuzzy_err_dot = NM;
-    }
-    else if (err_dot <= -0.1)
-    {
-        fuzzy_err_dot = NS;
-    }
-    else if (err_dot <= 0.1)
-    {
-        fuzzy_err_dot = ZO;
-    }
-    else if (err_dot <= 0.5)
-    {
-        fuzzy_err_dot = PS;
-    }
-    else if (err_dot <= 1.5)
-    {
-        fuzzy_err_dot = PM;
-    }
-    else
-    {
-        fuzzy_err_dot = PB;
-    }
+    fuzzy_err_dot = quantize(err_change, err_change_bounds);
 }
 
-void FuzzyPIDController::getFuzzyRules(FuzzyVariable fuzzy_err, FuzzyVariable fuzzy_err_dot, FuzzyVariable& delta_kp, FuzzyVariable& delta_ki, FuzzyVariable& delta_kd)
+template <typename Real>
+void FuzzyPIDControllerT<Real>::getFuzzyRules(FuzzyVariable fuzzy_err, FuzzyVariable fuzzy_err_dot, FuzzyVariable& delta_kp, FuzzyVariable& delta_ki, FuzzyVariable& delta_kd)
 {
     // Convert fuzzy variables to array indices
     int err_idx = fuzzy_err + 3;
     int err_dot_idx = fuzzy_err_dot + 3;
-    
+
     // Find corresponding PID parameter adjustments from rule tables
     delta_kp = static_cast<FuzzyVariable>(delta_kp_rules[err_idx][err_dot_idx]);
     delta_ki = static_cast<FuzzyVariable>(delta_ki_rules[err_idx][err_dot_idx]);
     delta_kd = static_cast<FuzzyVariable>(delta_kd_rules[err_idx][err_dot_idx]);
 }
 
-double FuzzyPIDController::defuzzify(FuzzyVariable fuzzy_value, double range)
+template <typename Real>
+double FuzzyPIDControllerT<Real>::defuzzify(FuzzyVariable fuzzy_value, double range)
 {
     return fuzzy_value * (range / 3.0);
 }
 
-double FuzzyPIDController::calculateErrorDot(double err, double prev_err)
-{
-    return (err - prev_err) / dt;
-}
-
-double FuzzyPIDController::compute(double setpoint, double process_val)
+template <typename Real>
+Real FuzzyPIDControllerT<Real>::compute(Real setpoint, Real process_val)
 {
     // Calculate current error
-    double err = setpoint - process_val;
-    
-    // Calculate error derivative
-    double err_dot_val = calculateErrorDot(err, this->prev_err);
-    
-    // Fuzzification
-    FuzzyVariable fuzzy_err, fuzzy_err_dot;
-    fuzzify(err, err_dot_val, fuzzy_err, fuzzy_err_dot);
-    
-    // Fuzzy rule inference
-    FuzzyVariable delta_kp, delta_ki, delta_kd;
-    getFuzzyRules(fuzzy_err, fuzzy_err_dot, delta_kp, delta_ki, delta_kd);
-    
-    // Defuzzification
-    const double kp_range = 0.5;
-    const double ki_range = 0.1;
-    const double kd_range = 0.2;
-    
-    double dkp = defuzzify(delta_kp, kp_range);
-    double dki = defuzzify(delta_ki, ki_range);
-    double dkd = defuzzify(delta_kd, kd_range);
-    
+    Real err = setpoint - process_val;
+    Real err_change = err - this->prev_err;
+
+    // Gain adjustments, integral and derivative gains already scaled by dt
+    Real dkp, dki_dt, dkd_over_dt;
+    if (mode == SMOOTH)
+    {
+        // Interpolate the precomputed surface, outputs in [-3, 3]
+        double surface_kp, surface_ki, surface_kd;
+        surface.evaluate(static_cast<double>(err), static_cast<double>(err_change),
+                         surface_kp, surface_ki, surface_kd);
+        dkp = Real(surface_kp * (0.5 / 3.0));
+        dki_dt = Real(surface_ki * (0.1 / 3.0) * dt);
+        dkd_over_dt = Real(surface_kd * (0.2 / 3.0) / dt);
+    }
+    else
+    {
+        // Fuzzification
+        FuzzyVariable fuzzy_err, fuzzy_err_dot;
+        fuzzify(err, err_change, fuzzy_err, fuzzy_err_dot);
+
+        // Fuzzy rule inference
+        FuzzyVariable delta_kp, delta_ki, delta_kd;
+        getFuzzyRules(fuzzy_err, fuzzy_err_dot, delta_kp, delta_ki, delta_kd);
+
+        // Defuzzification - precomputed per level in the constructor
+        dkp = delta_kp_levels[delta_kp + 3];
+        dki_dt = delta_ki_dt_levels[delta_ki + 3];
+        dkd_over_dt = delta_kd_over_dt_levels[delta_kd + 3];
+    }
+
     // Dynamically adjust PID parameters
-    double current_kp = kp + dkp;
-    double current_ki = ki + dki;
-    double current_kd = kd + dkd;
-    
+    Real current_kp = kp + dkp;
+    Real current_ki_dt = ki_dt + dki_dt;
+    Real current_kd_over_dt = kd_over_dt + dkd_over_dt;
+
     // Calculate output using position PID algorithm
-    double p_term = current_kp * err;
-    integral += current_ki * err * dt;
-    double i_term = integral;
-    double d_term = current_kd * (process_val - prev_pv) / dt;
-    
-    double output = p_term + i_term - d_term;
-    
+    Real p_term = current_kp * err;
+    accumulate_product(integral, integral_residue, current_ki_dt, err);
+    Real i_term = integral;
+    Real d_term = current_kd_over_dt * (process_val - prev_pv);
+
+    Real output = p_term + i_term - d_term;
+
     // Update history values
     this->prev_err = err;
     prev_pv = process_val;
-    
+
     return output;
 }
 
-void FuzzyPIDController::reset()
+template <typename Real>
+void FuzzyPIDControllerT<Real>::reset()
+{
+    prev_err = Real(0.0);
+    prev_pv = Real(0.0);
+    integral = Real(0.0);
+    integral_residue = Real(0.0);
+}
+
+template <typename Real>
+Real FuzzyPIDControllerT<Real>::* const FuzzyPIDControllerT<Real>::state_fields[7] = {
+    &FuzzyPIDControllerT<Real>::kp, &FuzzyPIDControllerT<Real>::ki_dt,
+    &FuzzyPIDControllerT<Real>::kd_over_dt, &FuzzyPIDControllerT<Real>::prev_err,
+    &FuzzyPIDControllerT<Real>::prev_pv, &FuzzyPIDControllerT<Real>::integral,
+    &FuzzyPIDControllerT<Real>::integral_residue
+};
+
+template <typename Real>
+std::size_t FuzzyPIDControllerT<Real>::stateSize() const
 {
-    prev_err = 0.0;
-    prev_pv = 0.0;
-    integral = 0.0;
+    return controller_state_size<Real, 7>();
+}
+
+template <typename Real>
+std::size_t FuzzyPIDControllerT<Real>::saveState(void* buffer, std::size_t capacity) const
+{
+    return save_controller_state(*this, state_fields, STATE_FUZZY_PID, buffer, capacity);
+}
+
+template <typename Real>
+bool FuzzyPIDControllerT<Real>::restoreState(const void* buffer, std::size_t size)
+{
+    return restore_controller_state(*this, state_fields, STATE_FUZZY_PID, buffer, size);
+}
+
+template <typename Real>
+bool FuzzyPIDControllerT<Real>::checkState(const void* buffer, std::size_t size) const
+{
+    return check_controller_state<Real, 7>(STATE_FUZZY_PID, buffer, size);
 }
 
 // Adaptive PID Controller Implementation
-AdaptivePIDController::AdaptivePIDController(double kp_val, double ki_val, double kd_val, double dt_val, double gamma_val)
-    : kp(kp_val), ki(ki_val), kd(kd_val), dt(dt_val), gamma(gamma_val), prev_err(0.0), prev_pv(0.0), integral(0.0), prev_u(0.0), prev_process_val(0.0)
+template <typename Real>
+AdaptivePIDControllerT<Real>::AdaptivePIDControllerT(double kp_val, double ki_val, double kd_val, double dt_val, double gamma_val)
+    : kp(kp_val), ki(ki_val), kd(kd_val), dt(dt_val), ki_dt(ki_val * dt_val), inv_dt(1.0 / dt_val), gamma(gamma_val),
+      kp_min(0.0), kp_max(15.0), ki_min(0.0), ki_max(3.0), kd_min(0.0), kd_max(2.0),
+      prev_err(0.0), prev_pv(0.0), integral(0.0), integral_residue(0.0), prev_u(0.0), prev_process_val(0.0)
 {
 }
 
-double AdaptivePIDController::performance_index(double err)
+template <typename Real>
+Real AdaptivePIDControllerT<Real>::performance_index(Real err)
 {
-    return 0.5 * err * err;
+    return Real(0.5) * err * err;
 }
 
-double AdaptivePIDController::d_err_d_kp(double err, double prev_err, double process_val, double prev_process_val)
+template <typename Real>
+Real AdaptivePIDControllerT<Real>::d_err_d_kp(Real err, Real prev_err, Real process_val, Real prev_process_val)
 {
     return -err * prev_err;
 }
 
-double AdaptivePIDController::d_err_d_ki(double err, double prev_err, double process_val, double prev_process_val)
+template <typename Real>
+Real AdaptivePIDControllerT<Real>::d_err_d_ki(Real err, Real prev_err, Real process_val, Real prev_process_val)
 {
     return -err * integral;
 }
 
-double AdaptivePIDController::d_err_d_kd(double err, double prev_err, double process_val, double prev_process_val)
+template <typename Real>
+Real AdaptivePIDControllerT<Real>::d_err_d_kd(Real err, Real prev_err, Real process_val, Real prev_process_val)
 {
-    return -err * (process_val - 2 * prev_process_val + prev_pv);
+    return -err * (process_val - prev_process_val - prev_process_val + prev_pv);
 }
 
-double AdaptivePIDController::compute(double setpoint, double process_val)
+template <typename Real>
+Real AdaptivePIDControllerT<Real>::compute(Real setpoint, Real process_val)
 {
+    // Pick up parameters published since the last cycle
+    AdaptivePIDParameters params;
+    if (pending.poll(params)) {
+        applyParameters(params);
+    }
+
     // Calculate current error
-    double err = setpoint - process_val;
-    
+    Real err = setpoint - process_val;
+
     // Calculate PID output
-    double p_term = kp * err;
-    integral += ki * err * dt;
-    double i_term = integral;
-    double d_term = kd * (process_val - prev_pv) / dt;
-    double u = p_term + i_term - d_term;
-    
-    // Calculate performance index
-    double J = performance_index(err);
-    
+    Real p_term = kp * err;
+    accumulate_product(integral, integral_residue, ki_dt, err);
+    Real i_term = integral;
+    Real d_term = kd * (process_val - prev_pv) * inv_dt;
+    Real u = p_term + i_term - d_term;
+
     // Calculate partial derivatives of error with respect to PID parameters
-    double dJ_d_kp = d_err_d_kp(err, prev_err, process_val, prev_process_val);
-    double dJ_d_ki = d_err_d_ki(err, prev_err, process_val, prev_process_val);
-    double dJ_d_kd = d_err_d_kd(err, prev_err, process_val, prev_process_val);
-    
+    Real dJ_d_kp = d_err_d_kp(err, prev_err, process_val, prev_process_val);
+    Real dJ_d_ki = d_err_d_ki(err, prev_err, process_val, prev_process_val);
+    Real dJ_d_kd = d_err_d_kd(err, prev_err, process_val, prev_process_val);
+
     // Adaptive learning rate: decrease as error decreases for better convergence
-    double abs_err = fabs(err);
-    double adaptive_gamma = gamma;
-    
+    Real abs_err = err < Real(0.0) ? -err : err;
+    Real adaptive_gamma = gamma;
+
     // Adjust learning rate based on error magnitude
-    if (abs_err < 0.1) {
-        adaptive_gamma = gamma * 0.1;  // Slow down learning when close to setpoint
-    } else if (abs_err < 0.5) {
-        adaptive_gamma = gamma * 0.5;  // Medium learning rate
+    if (abs_err < Real(0.1)) {
+        adaptive_gamma = gamma * Real(0.1);  // Slow down learning when close to setpoint
+    } else if (abs_err < Real(0.5)) {
+        adaptive_gamma = gamma * Real(0.5);  // Medium learning rate
     } else {
-        adaptive_gamma = gamma;        // Fast learning for large errors
+        adaptive_gamma = gamma;              // Fast learning for large errors
     }
-    
+
     // Adjust PID parameters using MIT rule with adaptive learning rate
     kp -= adaptive_gamma * dJ_d_kp;
     ki -= adaptive_gamma * dJ_d_ki;
     kd -= adaptive_gamma * dJ_d_kd;
-    
-    // Enhanced parameter limits with symmetric ranges for better performance
-    const double min_kp = 0.0;
-    const double max_kp = 15.0;      // Increased upper limit for more aggressive control
-    const double min_ki = 0.0;
-    const double max_ki = 3.0;       // Increased upper limit for better steady-state accuracy
-    const double min_kd = 0.0;
-    const double max_kd = 2.0;       // Increased upper limit for better transient response
-    
+
     // Limit parameter values
-    if (kp < min_kp) kp = min_kp;
-    if (kp > max_kp) kp = max_kp;
-    if (ki < min_ki) ki = min_ki;
-    if (ki > max_ki) ki = max_ki;
-    if (kd < min_kd) kd = min_kd;
-    if (kd > max_kd) kd = max_kd;
-    
+    if (kp < kp_min) kp = kp_min;
+    if (kp > kp_max) kp = kp_max;
+    if (ki < ki_min) ki = ki_min;
+    if (ki > ki_max) ki = ki_max;
+    if (kd < kd_min) kd = kd_min;
+    if (kd > kd_max) kd = kd_max;
+    ki_dt = ki * dt;
+
     // Update history values
     prev_err = err;
     prev_pv = process_val;
     prev_u = u;
     prev_process_val = process_val;
-    
+
     return u;
 }
 
-void AdaptivePIDController::reset()
+template <typename Real>
+void AdaptivePIDControllerT<Real>::reset()
+{
+    prev_err = Real(0.0);
+    prev_pv = Real(0.0);
+    integral = Real(0.0);
+    integral_residue = Real(0.0);
+    prev_u = Real(0.0);
+    prev_process_val = Real(0.0);
+}
+
+template <typename Real>
+void AdaptivePIDControllerT<Real>::setParameters(const AdaptivePIDParameters& params)
+{
+    pending.publish(params);
+}
+
+template <typename Real>
+AdaptivePIDParameters AdaptivePIDControllerT<Real>::parameters() const
+{
+    AdaptivePIDParameters params;
+    params.kp = static_cast<double>(kp);
+    params.ki = static_cast<double>(ki);
+    params.kd = static_cast<double>(kd);
+    params.dt = static_cast<double>(dt);
+    params.gamma = static_cast<double>(gamma);
+    params.kp_min = static_cast<double>(kp_min);
+    params.kp_max = static_cast<double>(kp_max);
+    params.ki_min = static_cast<double>(ki_min);
+    params.ki_max = static_cast<double>(ki_max);
+    params.kd_min = static_cast<double>(kd_min);
+    params.kd_max = static_cast<double>(kd_max);
+    return params;
+}
+
+template <typename Real>
+void AdaptivePIDControllerT<Real>::applyParameters(const AdaptivePIDParameters& params)
+{
+    kp_min = Real(params.kp_min);
+    kp_max = Real(params.kp_max);
+    ki_min = Real(params.ki_min);
+    ki_max = Real(params.ki_max);
+    kd_min = Real(params.kd_min);
+    kd_max = Real(params.kd_max);
+
+    // Published gains limited to the published ranges
+    Real new_kp(params.kp);
+    if (new_kp < kp_min) new_kp = kp_min;
+    if (new_kp > kp_max) new_kp = kp_max;
+    ki = Real(params.ki);
+    if (ki < ki_min) ki = ki_min;
+    if (ki > ki_max) ki = ki_max;
+    kd = Real(params.kd);
+    if (kd < kd_min) kd = kd_min;
+    if (kd > kd_max) kd = kd_max;
+
+    // Bumpless transfer: keep kp * prev_err + integral unchanged
+    integral += (kp - new_kp) * prev_err;
+    kp = new_kp;
+
+    dt = Real(params.dt);
+    ki_dt = Real(static_cast<double>(ki) * params.dt);
+    inv_dt = Real(1.0 / params.dt);
+    gamma = Real(params.gamma);
+}
+
+template <typename Real>
+Real AdaptivePIDControllerT<Real>::* const AdaptivePIDControllerT<Real>::state_fields[19] = {
+    &AdaptivePIDControllerT<Real>::kp, &AdaptivePIDControllerT<Real>::ki, &AdaptivePIDControllerT<Real>::kd,
+    &AdaptivePIDControllerT<Real>::dt, &AdaptivePIDControllerT<Real>::ki_dt, &AdaptivePIDControllerT<Real>::inv_dt,
+    &AdaptivePIDControllerT<Real>::gamma, &AdaptivePIDControllerT<Real>::kp_min,
+    &AdaptivePIDControllerT<Real>::kp_max, &AdaptivePIDControllerT<Real>::ki_min,
+    &AdaptivePIDControllerT<Real>::ki_max, &AdaptivePIDControllerT<Real>::kd_min,
+    &AdaptivePIDControllerT<Real>::kd_max, &AdaptivePIDControllerT<Real>::prev_err,
+    &AdaptivePIDControllerT<Real>::prev_pv, &AdaptivePIDControllerT<Real>::integral,
+    &AdaptivePIDControllerT<Real>::integral_residue, &AdaptivePIDControllerT<Real>::prev_u,
+    &AdaptivePIDControllerT<Real>::prev_process_val
+};
+
+template <typename Real>
+std::size_t AdaptivePIDControllerT<Real>::stateSize() const
+{
+    return controller_state_size<Real, 19>();
+}
+
+template <typename Real>
+std::size_t AdaptivePIDControllerT<Real>::saveState(void* buffer, std::size_t capacity) const
 {
-    prev_err = 0.0;
-    prev_pv = 0.0;
-    integral = 0.0;
-    prev_u = 0.0;
-    prev_process_val = 0.0;
-}
\ No newline at end of file
+    return save_controller_state(*this, state_fields, STATE_ADAPTIVE_PID, buffer, capacity);
+}
+
+template <typename Real>
+bool AdaptivePIDControllerT<Real>::restoreState(const void* buffer, std::size_t size)
+{
+    return restore_controller_state(*this, state_fields, STATE_ADAPTIVE_PID, buffer, size);
+}
+
+template <typename Real>
+bool AdaptivePIDControllerT<Real>::checkState(const void* buffer, std::size_t size) const
+{
+    return check_controller_state<Real, 19>(STATE_ADAPTIVE_PID, buffer, size);
+}
+
+// Explicit instantiations for the supported numeric backends
+template class PIDControllerT<double>;
+template class PIDControllerT<float>;
+template class PIDControllerT<Q16_16>;
+template class PIDControllerT<Q1_31>;
+
+template class IncrementalPIDControllerT<double>;
+template class IncrementalPIDControllerT<float>;
+template class IncrementalPIDControllerT<Q16_16>;
+template class IncrementalPIDControllerT<Q1_31>;
+
+template class FuzzyPIDControllerT<double>;
+template class FuzzyPIDControllerT<float>;
+template class FuzzyPIDControllerT<Q16_16>;
+
+template class AdaptivePIDControllerT<double>;
+template class AdaptivePIDControllerT<float>;
+template class AdaptivePIDControllerT<Q16_16>;
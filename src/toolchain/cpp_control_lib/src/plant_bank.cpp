@@ -0,0 +1,206 @@
+// Batched plant simulator implementation
+#include "plant_bank.hpp"
+#include "noise_generator.hpp"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PLANT_BANK_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define PLANT_BANK_RESTRICT __restrict
+#else
+#define PLANT_BANK_RESTRICT
+#endif
+
+namespace {
+
+// Number of arrays carved out of the backing storage
+const std::size_t kNumArrays = 11;
+
+// Round plant count up so every array starts on an alignment boundary
+std::size_t padded_length(std::size_t n)
+{
+    const std::size_t per_line = PlantBank::alignment / sizeof(double);
+    return ((n + per_line - 1) / per_line) * per_line;
+}
+
+// The kernels evaluate exactly the expressions of system_models.hpp with the
+// constant sub-products precomputed, so results match the scalar models bit
+// for bit. Restrict-qualified parameters let the compiler vectorize them.
+
+// dx/dt = (K*u - x)/T, explicit Euler
+void first_order_kernel(std::size_t n,
+                        const double* PLANT_BANK_RESTRICT alpha,
+                        const double* PLANT_BANK_RESTRICT gain,
+                        double* PLANT_BANK_RESTRICT y,
+                        const double* PLANT_BANK_RESTRICT inputs,
+                        double* PLANT_BANK_RESTRICT outputs)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        double out = y[i] + alpha[i] * (gain[i] * inputs[i] - y[i]);
+        y[i] = out;
+        outputs[i] = out;
+    }
+}
+
+// K*omega_n^2 / (s^2 + 2*zeta*omega_n*s + omega_n^2), semi-implicit Euler
+void second_order_kernel(std::size_t n, double dt,
+                         const double* PLANT_BANK_RESTRICT k_wn2,
+                         const double* PLANT_BANK_RESTRICT two_zeta_wn,
+                         const double* PLANT_BANK_RESTRICT wn2,
+                         double* PLANT_BANK_RESTRICT y,
+                         double* PLANT_BANK_RESTRICT dy,
+                         const double* PLANT_BANK_RESTRICT inputs,
+                         double* PLANT_BANK_RESTRICT outputs)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        double acceleration = k_wn2[i] * inputs[i] - two_zeta_wn[i] * dy[i] - wn2[i] * y[i];
+        double derivative = dy[i] + acceleration * dt;
+        double out = y[i] + derivative * dt;
+        dy[i] = derivative;
+        y[i] = out;
+        outputs[i] = out;
+    }
+}
+
+// Saturation, deadzone, then first-order dynamics. The nonlinearities are
+// written as selects so the loop stays branch-free.
+void nonlinear_kernel(std::size_t n,
+                      const double* PLANT_BANK_RESTRICT alpha,
+                      const double* PLANT_BANK_RESTRICT gain,
+                      const double* PLANT_BANK_RESTRICT limit,
+                      const double* PLANT_BANK_RESTRICT width,
+                      double* PLANT_BANK_RESTRICT y,
+                      const double* PLANT_BANK_RESTRICT inputs,
+                      double* PLANT_BANK_RESTRICT outputs)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        double u = inputs[i];
+        u = u > limit[i] ? limit[i] : u;
+        u = u < -limit[i] ? -limit[i] : u;
+        double above = u - width[i];
+        double below = u + width[i];
+        u = u > width[i] ? above : (u < -width[i] ? below : 0.0);
+        double out = y[i] + alpha[i] * (gain[i] * u - y[i]);
+        y[i] = out;
+        outputs[i] = out;
+    }
+}
+
+} // namespace
+
+PlantBank::PlantBank(PlantType type_val, std::size_t num_plants_val, double dt_val)
+    : plant_type(type_val), num_plants(num_plants_val), dt(dt_val), storage(nullptr),
+      gain(nullptr), time_constant(nullptr), zeta(nullptr), omega_n(nullptr),
+      saturation_limit(nullptr), deadzone_width(nullptr),
+      c0(nullptr), c1(nullptr), c2(nullptr), y(nullptr), dy(nullptr)
+{
+    const std::size_t stride = padded_length(num_plants);
+    storage = new char[kNumArrays * stride * sizeof(double) + alignment];
+
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(storage);
+    base = (base + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    double* arrays = reinterpret_cast<double*>(base);
+
+    gain = arrays;
+    time_constant = arrays + stride;
+    zeta = arrays + 2 * stride;
+    omega_n = arrays + 3 * stride;
+    saturation_limit = arrays + 4 * stride;
+    deadzone_width = arrays + 5 * stride;
+    c0 = arrays + 6 * stride;
+    c1 = arrays + 7 * stride;
+    c2 = arrays + 8 * stride;
+    y = arrays + 9 * stride;
+    dy = arrays + 10 * stride;
+
+    for (std::size_t i = 0; i < num_plants; ++i) {
+        gain[i] = 1.0;
+        time_constant[i] = 1.0;
+        zeta[i] = 0.7;
+        omega_n[i] = 1.0;
+        saturation_limit[i] = 0.5;
+        deadzone_width[i] = 0.1;
+        updateCoefficients(i);
+    }
+    reset();
+}
+
+PlantBank::~PlantBank()
+{
+    delete[] storage;
+}
+
+void PlantBank::setFirstOrder(std::size_t plant, double T_val, double K_val)
+{
+    if (plant >= num_plants) return;
+    time_constant[plant] = T_val;
+    gain[plant] = K_val;
+    updateCoefficients(plant);
+}
+
+void PlantBank::setSecondOrder(std::size_t plant, double K_val, double zeta_val, double omega_n_val)
+{
+    if (plant >= num_plants) return;
+    gain[plant] = K_val;
+    zeta[plant] = zeta_val;
+    omega_n[plant] = omega_n_val;
+    updateCoefficients(plant);
+}
+
+void PlantBank::setNonlinear(std::size_t plant, double K_val, double T_val,
+                             double saturation_limit_val, double deadzone_width_val)
+{
+    if (plant >= num_plants) return;
+    gain[plant] = K_val;
+    time_constant[plant] = T_val;
+    saturation_limit[plant] = saturation_limit_val;
+    deadzone_width[plant] = deadzone_width_val;
+    updateCoefficients(plant);
+}
+
+void PlantBank::perturb(double spread, std::uint64_t seed)
+{
+    Xoshiro256pp rng(seed);
+    double* parameters[] = {gain, time_constant, zeta, omega_n, saturation_limit, deadzone_width};
+    for (std::size_t i = 0; i < num_plants; ++i) {
+        for (int p = 0; p < 6; ++p) {
+            parameters[p][i] *= 1.0 + spread * (2.0 * rng.uniform() - 1.0);
+        }
+        updateCoefficients(i);
+    }
+}
+
+void PlantBank::updateCoefficients(std::size_t plant)
+{
+    if (plant_type == PLANT_SECOND_ORDER) {
+        c0[plant] = gain[plant] * omega_n[plant] * omega_n[plant];
+        c1[plant] = 2 * zeta[plant] * omega_n[plant];
+        c2[plant] = omega_n[plant] * omega_n[plant];
+    } else {
+        c0[plant] = dt / time_constant[plant];
+        c1[plant] = gain[plant];
+        c2[plant] = 0.0;
+    }
+}
+
+void PlantBank::step(const double* inputs, double* outputs)
+{
+    switch (plant_type) {
+    case PLANT_FIRST_ORDER:
+        first_order_kernel(num_plants, c0, c1, y, inputs, outputs);
+        break;
+    case PLANT_SECOND_ORDER:
+        second_order_kernel(num_plants, dt, c0, c1, c2, y, dy, inputs, outputs);
+        break;
+    case PLANT_NONLINEAR:
+        nonlinear_kernel(num_plants, c0, c1, saturation_limit, deadzone_width, y, inputs, outputs);
+        break;
+    }
+}
+
+void PlantBank::reset()
+{
+    for (std::size_t i = 0; i < num_plants; ++i) {
+        y[i] = 0.0;
+        dy[i] = 0.0;
+    }
+}
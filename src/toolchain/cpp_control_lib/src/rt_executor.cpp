@@ -0,0 +1,248 @@
+// Real-time control loop executor implementation
+#include "rt_executor.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+
+namespace {
+
+const std::int64_t kNsPerSec = 1000000000;
+
+std::int64_t to_ns(const timespec& ts)
+{
+    return static_cast<std::int64_t>(ts.tv_sec) * kNsPerSec + ts.tv_nsec;
+}
+
+timespec from_ns(std::int64_t ns)
+{
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / kNsPerSec);
+    ts.tv_nsec = static_cast<long>(ns % kNsPerSec);
+    return ts;
+}
+
+std::int64_t monotonic_now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return to_ns(ts);
+}
+
+void clear_stats(RTGroupStats& stats)
+{
+    stats.activations = 0;
+    stats.overruns = 0;
+    stats.dropped = 0;
+    stats.latency_min = std::numeric_limits<std::int64_t>::max();
+    stats.latency_max = 0;
+    stats.latency_sum = 0;
+    stats.exec_max = 0;
+}
+
+} // namespace
+
+RTExecutor::RTExecutor(const RTExecutorConfig& config_val)
+    : config(config_val), missed_cycles(0), stop_requested(false)
+{
+}
+
+int RTExecutor::addGroup(const std::string& name, unsigned divider)
+{
+    if (divider == 0) {
+        printf("RTExecutor: group %s has zero divider\n", name.c_str());
+        return -1;
+    }
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        unsigned other = groups[i].divider;
+        if (divider % other != 0 && other % divider != 0) {
+            printf("RTExecutor: divider %u of group %s is not harmonic with %u\n", divider, name.c_str(), other);
+            return -1;
+        }
+    }
+
+    Group group;
+    group.name = name;
+    group.divider = divider;
+    clear_stats(group.stats);
+    group.pending = false;
+    group.pending_release = 0;
+    groups.push_back(group);
+
+    int index = static_cast<int>(groups.size()) - 1;
+    order.push_back(index);
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+        return groups[a].divider < groups[b].divider;
+    });
+    return index;
+}
+
+void RTExecutor::addTask(int group, const Task& task)
+{
+    groups[group].tasks.push_back(task);
+}
+
+void RTExecutor::stop()
+{
+    stop_requested.store(true, std::memory_order_relaxed);
+}
+
+void RTExecutor::resetStats()
+{
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        clear_stats(groups[i].stats);
+    }
+    missed_cycles = 0;
+}
+
+bool RTExecutor::setupThread()
+{
+    if (config.lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        printf("RTExecutor: mlockall failed: %s\n", strerror(errno));
+        return false;
+    }
+
+#if defined(__linux__)
+    if (config.cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(config.cpu, &cpus);
+        int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (err != 0) {
+            printf("RTExecutor: pinning to CPU %d failed: %s\n", config.cpu, strerror(err));
+            return false;
+        }
+    }
+#else
+    if (config.cpu >= 0) {
+        printf("RTExecutor: CPU pinning is not supported on this platform\n");
+        return false;
+    }
+#endif
+
+    if (config.priority > 0) {
+        sched_param param;
+        param.sched_priority = config.priority;
+        int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (err != 0) {
+            printf("RTExecutor: SCHED_FIFO priority %d failed: %s\n", config.priority, strerror(err));
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RTExecutor::run(std::uint64_t cycles)
+{
+    if (!setupThread()) {
+        return false;
+    }
+    stop_requested.store(false, std::memory_order_relaxed);
+
+    const std::int64_t period = config.period_ns;
+    std::int64_t deadline = monotonic_now() + period;
+
+    for (std::uint64_t tick = 0; cycles == 0 || tick < cycles; ++tick) {
+        if (stop_requested.load(std::memory_order_relaxed)) {
+            break;
+        }
+
+        // Sleep until the absolute release time of this cycle
+        timespec wakeup = from_ns(deadline);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeup, nullptr) == EINTR) {
+        }
+
+        // Released groups, fastest first. A group released in skipped cycles
+        // runs now, timed against its latest missed release.
+        for (std::size_t k = 0; k < order.size(); ++k) {
+            Group& group = groups[order[k]];
+            std::int64_t release = deadline;
+            if (tick % group.divider == 0) {
+                if (group.pending) {
+                    ++group.stats.dropped;
+                }
+            } else if (group.pending) {
+                release = group.pending_release;
+            } else {
+                continue;
+            }
+            group.pending = false;
+
+            std::int64_t start = monotonic_now();
+            for (std::size_t t = 0; t < group.tasks.size(); ++t) {
+                group.tasks[t]();
+            }
+            std::int64_t end = monotonic_now();
+
+            RTGroupStats& stats = group.stats;
+            std::int64_t latency = start - release;
+            ++stats.activations;
+            stats.latency_min = std::min(stats.latency_min, latency);
+            stats.latency_max = std::max(stats.latency_max, latency);
+            stats.latency_sum += latency;
+            stats.exec_max = std::max(stats.exec_max, end - start);
+            if (end > release + period * static_cast<std::int64_t>(group.divider)) {
+                ++stats.overruns;
+            }
+        }
+
+        // Next release; skip cycles whose release time has already passed,
+        // but never past the end of the run
+        deadline += period;
+        std::int64_t now = monotonic_now();
+        if (now > deadline) {
+            std::uint64_t missed = static_cast<std::uint64_t>((now - deadline) / period + 1);
+            if (cycles != 0 && missed > cycles - tick - 1) {
+                missed = cycles - tick - 1;
+            }
+            std::uint64_t last = tick + missed;
+            for (std::size_t i = 0; i < groups.size(); ++i) {
+                Group& group = groups[i];
+                std::uint64_t releases = last / group.divider - tick / group.divider;
+                if (releases == 0) {
+                    continue;
+                }
+                // Keep the latest skipped release, drop the ones before it
+                std::uint64_t latest = last / group.divider * group.divider;
+                group.stats.dropped += releases - 1;
+                group.pending = true;
+                group.pending_release = deadline + static_cast<std::int64_t>(latest - tick - 1) * period;
+            }
+            deadline += static_cast<std::int64_t>(missed) * period;
+            tick += missed;
+            missed_cycles += missed;
+        }
+    }
+
+    // Releases skipped at the very end of the run never execute
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        if (groups[i].pending) {
+            ++groups[i].stats.dropped;
+            groups[i].pending = false;
+        }
+    }
+    return true;
+}
+
+void RTExecutor::printStats() const
+{
+    printf("Group            Rate(Hz)  Activations  Overruns  Dropped  Latency min/mean/max (us)  Jitter (us)  Exec max (us)\n");
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        const Group& group = groups[i];
+        const RTGroupStats& stats = group.stats;
+        double rate = 1e9 / (static_cast<double>(config.period_ns) * group.divider);
+        printf("%-16s %8.1f  %11llu  %8llu  %7llu  %8.1f/%8.1f/%8.1f  %11.1f  %13.1f\n",
+               group.name.c_str(), rate,
+               static_cast<unsigned long long>(stats.activations),
+               static_cast<unsigned long long>(stats.overruns),
+               static_cast<unsigned long long>(stats.dropped),
+               stats.activations ? stats.latency_min / 1e3 : 0.0, stats.latencyMean() / 1e3,
+               stats.latency_max / 1e3, stats.jitter() / 1e3, stats.exec_max / 1e3);
+    }
+    printf("Missed cycles: %llu\n", static_cast<unsigned long long>(missed_cycles));
+}
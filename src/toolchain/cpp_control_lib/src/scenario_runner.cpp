@@ -0,0 +1,421 @@
+// Concurrent controller x plant x noise scenario matrix runner implementation
+#include "scenario_runner.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include "noise_generator.hpp"
+#include "performance_metrics.hpp"
+#include "thread_pool.hpp"
+
+namespace {
+
+const TunedController kControllers[] = {TUNE_PID, TUNE_INCREMENTAL_PID, TUNE_FUZZY_PID, TUNE_ADAPTIVE_PID};
+const PlantType kPlants[] = {PLANT_FIRST_ORDER, PLANT_SECOND_ORDER, PLANT_NONLINEAR};
+
+std::string trim(const std::string& text)
+{
+    std::size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return std::string();
+    std::size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+std::vector<std::string> split_list(const std::string& text)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        item = trim(item);
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+bool parse_number(const std::string& text, double& value)
+{
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && *end == '\0';
+}
+
+// Unsigned 64-bit integer, all digits, 0 allowed
+bool parse_seed(const std::string& text, std::uint64_t& value)
+{
+    if (text.empty() || text[0] < '0' || text[0] > '9') return false;
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long parsed = std::strtoull(text.c_str(), &end, 10);
+    if (*end != '\0' || errno == ERANGE) return false;
+    value = static_cast<std::uint64_t>(parsed);
+    return true;
+}
+
+bool parse_controller(const std::string& name, TunedController& controller)
+{
+    for (int i = 0; i < 4; ++i) {
+        if (name == scenario_controller_name(kControllers[i])) {
+            controller = kControllers[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parse_plant(const std::string& name, PlantType& plant)
+{
+    for (int i = 0; i < 3; ++i) {
+        if (name == scenario_plant_name(kPlants[i])) {
+            plant = kPlants[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+// Apply one `key = value` setting
+bool apply_setting(ScenarioMatrix& matrix, const std::string& key, const std::string& value)
+{
+    std::vector<std::string> items = split_list(value);
+    double number = 0.0;
+
+    if (key == "controllers") {
+        matrix.controllers.clear();
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            TunedController controller;
+            if (!parse_controller(items[i], controller)) return false;
+            matrix.controllers.push_back(controller);
+        }
+        return !items.empty();
+    }
+    if (key == "plants") {
+        matrix.plants.clear();
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            PlantType plant;
+            if (!parse_plant(items[i], plant)) return false;
+            matrix.plants.push_back(plant);
+        }
+        return !items.empty();
+    }
+    if (key == "noise") {
+        matrix.noise.clear();
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            if (items[i] != "on" && items[i] != "off") return false;
+            matrix.noise.push_back(items[i] == "on");
+        }
+        return !items.empty();
+    }
+    if (key == "seeds") {
+        matrix.seeds.clear();
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            std::uint64_t seed;
+            if (!parse_seed(items[i], seed)) return false;
+            matrix.seeds.push_back(seed);
+        }
+        return !items.empty();
+    }
+    if (key == "durations") {
+        matrix.durations.clear();
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            if (!parse_number(items[i], number) || number <= 0.0) return false;
+            matrix.durations.push_back(number);
+        }
+        return !items.empty();
+    }
+    if (key == "integration") {
+        if (value == "euler") matrix.integration = INTEGRATION_EULER;
+        else if (value == "rk4") matrix.integration = INTEGRATION_RK4;
+        else if (value == "rkf45") matrix.integration = INTEGRATION_RKF45;
+        else return false;
+        return true;
+    }
+    if (key == "output") {
+        if (value == "none") matrix.output = SCENARIO_OUTPUT_NONE;
+        else if (value == "csv") matrix.output = SCENARIO_OUTPUT_CSV;
+        else if (value == "ccol") matrix.output = SCENARIO_OUTPUT_CCOL;
+        else return false;
+        return true;
+    }
+    if (key == "output_prefix") {
+        matrix.output_prefix = value;
+        return true;
+    }
+
+    // Scalar settings
+    if (!parse_number(value, number)) return false;
+    if (key == "dt" && number > 0.0) matrix.dt = number;
+    else if (key == "setpoint") matrix.setpoint = number;
+    else if (key == "kp") matrix.gains.kp = number;
+    else if (key == "ki") matrix.gains.ki = number;
+    else if (key == "kd") matrix.gains.kd = number;
+    else if (key == "gamma") matrix.gains.gamma = number;
+    else if (key == "noise_mean") matrix.noise_config.mean = number;
+    else if (key == "noise_std_dev") matrix.noise_config.std_dev = number;
+    else if (key == "noise_max_impulse") matrix.noise_config.max_impulse_amplitude = number;
+    else if (key == "noise_impulse_probability") matrix.noise_config.impulse_probability = number;
+    else if (key == "threads" && number >= 0.0) matrix.num_threads = static_cast<std::size_t>(number);
+    else return false;
+    return true;
+}
+
+// The test_all_controllers plants
+std::unique_ptr<SystemModel> make_plant(PlantType plant, double dt)
+{
+    switch (plant) {
+    case PLANT_SECOND_ORDER:
+        return std::unique_ptr<SystemModel>(new SecondOrderSystem(1.0, 0.7, 1.0, dt));
+    case PLANT_NONLINEAR:
+        return std::unique_ptr<SystemModel>(new NonlinearSystem(1.0, 1.0, 0.5, 0.1, dt));
+    default:
+        return std::unique_ptr<SystemModel>(new FirstOrderSystem(1.0, 1.0, dt));
+    }
+}
+
+std::string output_file_name(const ScenarioMatrix& matrix, const ScenarioCell& cell)
+{
+    char name[160];
+    if (cell.noise) {
+        snprintf(name, sizeof(name), "%s_with_noise_seed%llu_%gs_%s_response", scenario_plant_name(cell.plant),
+                 static_cast<unsigned long long>(cell.seed), cell.duration, scenario_controller_name(cell.controller));
+    } else {
+        snprintf(name, sizeof(name), "%s_no_noise_%gs_%s_response", scenario_plant_name(cell.plant),
+                 cell.duration, scenario_controller_name(cell.controller));
+    }
+    return matrix.output_prefix + name + (matrix.output == SCENARIO_OUTPUT_CCOL ? ".ccol" : ".csv");
+}
+
+// Running mean and variance (Welford)
+struct Aggregate {
+    std::size_t count;
+    double mean[4];
+    double m2[4];
+
+    Aggregate() : count(0) {
+        for (int i = 0; i < 4; ++i) mean[i] = m2[i] = 0.0;
+    }
+
+    void add(const double* values) {
+        ++count;
+        for (int i = 0; i < 4; ++i) {
+            double delta = values[i] - mean[i];
+            mean[i] += delta / count;
+            m2[i] += delta * (values[i] - mean[i]);
+        }
+    }
+
+    double stddev(int i) const {
+        return count > 1 ? std::sqrt(m2[i] / (count - 1)) : 0.0;
+    }
+};
+
+} // namespace
+
+ScenarioMatrix::ScenarioMatrix()
+    : dt(0.1), setpoint(1.0), noise_config(0.0, 0.05, 0.2, 0.02), integration(INTEGRATION_EULER),
+      output(SCENARIO_OUTPUT_NONE), num_threads(0)
+{
+    controllers.assign(kControllers, kControllers + 4);
+    plants.assign(kPlants, kPlants + 3);
+    noise.push_back(false);
+    noise.push_back(true);
+    seeds.push_back(1);
+    durations.push_back(20.0);
+    gains.kp = 0.5;
+    gains.ki = 0.1;
+    gains.kd = 0.05;
+    gains.gamma = 0.01;
+}
+
+const char* scenario_controller_name(TunedController controller)
+{
+    switch (controller) {
+    case TUNE_INCREMENTAL_PID: return "incremental_pid";
+    case TUNE_FUZZY_PID: return "fuzzy_pid";
+    case TUNE_ADAPTIVE_PID: return "adaptive_pid";
+    default: return "pid";
+    }
+}
+
+const char* scenario_plant_name(PlantType plant)
+{
+    switch (plant) {
+    case PLANT_SECOND_ORDER: return "second_order";
+    case PLANT_NONLINEAR: return "nonlinear";
+    default: return "first_order";
+    }
+}
+
+bool parse_scenario_matrix(std::istream& in, ScenarioMatrix& matrix)
+{
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line)) {
+        ++line_number;
+        std::size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        std::size_t equals = line.find('=');
+        if (equals == std::string::npos ||
+            !apply_setting(matrix, trim(line.substr(0, equals)), trim(line.substr(equals + 1)))) {
+            printf("Invalid scenario config line %d: %s\n", line_number, line.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool load_scenario_matrix(const std::string& path, ScenarioMatrix& matrix)
+{
+    std::ifstream in(path.c_str());
+    if (!in.is_open()) {
+        printf("Failed to open file: %s\n", path.c_str());
+        return false;
+    }
+    return parse_scenario_matrix(in, matrix);
+}
+
+std::vector<ScenarioCell> expand_scenario_matrix(const ScenarioMatrix& matrix)
+{
+    std::vector<ScenarioCell> cells;
+    for (std::size_t d = 0; d < matrix.durations.size(); ++d) {
+        for (std::size_t n = 0; n < matrix.noise.size(); ++n) {
+            std::size_t num_seeds = matrix.noise[n] ? matrix.seeds.size() : 1;
+            for (std::size_t s = 0; s < num_seeds; ++s) {
+                for (std::size_t p = 0; p < matrix.plants.size(); ++p) {
+                    for (std::size_t c = 0; c < matrix.controllers.size(); ++c) {
+                        ScenarioCell cell;
+                        cell.controller = matrix.controllers[c];
+                        cell.plant = matrix.plants[p];
+                        cell.noise = matrix.noise[n];
+                        cell.seed = matrix.noise[n] ? matrix.seeds[s] : 0;
+                        cell.duration = matrix.durations[d];
+                        cells.push_back(cell);
+                    }
+                }
+            }
+        }
+    }
+    return cells;
+}
+
+ScenarioResult run_scenario_cell(const ScenarioMatrix& matrix, const ScenarioCell& cell)
+{
+    std::unique_ptr<Controller> controller = make_tuned_controller(cell.controller, matrix.gains, matrix.dt);
+    std::unique_ptr<SystemModel> plant = make_plant(cell.plant, matrix.dt);
+    plant->set_integration(matrix.integration);
+    NoiseStream noise(matrix.noise_config, cell.seed);
+    PerformanceMetrics metrics;
+
+    ScenarioResult result;
+    result.cell = cell;
+    result.ok = true;
+    if (matrix.output != SCENARIO_OUTPUT_NONE) {
+        result.output_file = output_file_name(matrix, cell);
+        if (matrix.output == SCENARIO_OUTPUT_CCOL) {
+            result.ok = metrics.stream_to_columnar(result.output_file);
+        } else {
+            result.ok = metrics.stream_to_file(result.output_file);
+        }
+    }
+    if (!result.ok) {
+        result.rise_time = result.overshoot = result.settling_time = result.steady_state_error = 0.0;
+        result.iae = result.ise = result.itae = result.control_effort = 0.0;
+        return result;
+    }
+
+    // Same loop as test_all_controllers
+    const int steps = static_cast<int>(cell.duration / matrix.dt);
+    double process_val = 0.0;
+    for (int i = 0; i < steps; ++i) {
+        double t = i * matrix.dt;
+        double u = controller->compute(matrix.setpoint, process_val);
+        double system_output = plant->compute(u);
+        process_val = cell.noise ? system_output + noise.combined() : system_output;
+        metrics.add_data_point(t, matrix.setpoint, process_val, u);
+    }
+
+    result.rise_time = metrics.calculate_rise_time();
+    result.overshoot = metrics.calculate_overshoot();
+    result.settling_time = metrics.calculate_settling_time();
+    result.steady_state_error = metrics.calculate_steady_state_error();
+    result.iae = metrics.calculate_iae();
+    result.ise = metrics.calculate_ise();
+    result.itae = metrics.calculate_itae();
+    result.control_effort = metrics.calculate_control_effort();
+    return result;
+}
+
+std::vector<ScenarioResult> run_scenario_matrix(const ScenarioMatrix& matrix)
+{
+    const std::vector<ScenarioCell> cells = expand_scenario_matrix(matrix);
+    std::vector<ScenarioResult> results(cells.size());
+
+    // Hand out the longest simulations first so they do not trail at the end
+    std::vector<std::size_t> order(cells.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&cells](std::size_t a, std::size_t b) {
+        return cells[a].duration > cells[b].duration;
+    });
+
+    ThreadPool pool(matrix.num_threads);
+    pool.parallelFor(cells.size(), [&](std::size_t k) {
+        std::size_t i = order[k];
+        results[i] = run_scenario_cell(matrix, cells[i]);
+    });
+    return results;
+}
+
+bool write_scenario_results(const std::string& path, const std::vector<ScenarioResult>& results)
+{
+    std::ofstream out(path.c_str());
+    if (!out.is_open()) {
+        printf("Failed to open file: %s\n", path.c_str());
+        return false;
+    }
+    out << "controller,plant,noise,seed,duration,rise_time,overshoot,settling_time,"
+           "steady_state_error,iae,ise,itae,control_effort,output_file\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const ScenarioResult& r = results[i];
+        if (!r.ok) continue;
+        out << scenario_controller_name(r.cell.controller) << "," << scenario_plant_name(r.cell.plant) << ","
+            << (r.cell.noise ? "on" : "off") << "," << r.cell.seed << "," << r.cell.duration << ","
+            << r.rise_time << "," << r.overshoot << "," << r.settling_time << "," << r.steady_state_error << ","
+            << r.iae << "," << r.ise << "," << r.itae << "," << r.control_effort << "," << r.output_file << "\n";
+    }
+    return out.good();
+}
+
+void print_scenario_summary(const std::vector<ScenarioResult>& results)
+{
+    // Group key keeps the matrix order of first appearance
+    std::vector<std::string> keys;
+    std::map<std::string, Aggregate> groups;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const ScenarioResult& r = results[i];
+        if (!r.ok) continue;
+        char key[128];
+        snprintf(key, sizeof(key), "%-15s %-12s %-5s %6gs", scenario_controller_name(r.cell.controller),
+                 scenario_plant_name(r.cell.plant), r.cell.noise ? "on" : "off", r.cell.duration);
+        if (groups.find(key) == groups.end()) keys.push_back(key);
+        const double values[4] = {r.overshoot, r.settling_time, r.iae, r.itae};
+        groups[key].add(values);
+    }
+
+    printf("%-15s %-12s %-5s %7s %5s %22s %22s %22s %22s\n", "controller", "plant", "noise", "time", "runs",
+           "overshoot %", "settling time s", "IAE", "ITAE");
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        const Aggregate& g = groups[keys[i]];
+        printf("%s %5zu", keys[i].c_str(), g.count);
+        for (int m = 0; m < 4; ++m) {
+            printf(" %10.4f +- %-8.4f", g.mean[m], g.stddev(m));
+        }
+        printf("\n");
+    }
+}
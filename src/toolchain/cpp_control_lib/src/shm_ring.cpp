@@ -0,0 +1,91 @@
+// Shared memory mapping implementation
+#include "shm_ring.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+SharedMemory::SharedMemory()
+    : address(nullptr), length(0), owner(false)
+{
+}
+
+SharedMemory::~SharedMemory()
+{
+    close();
+}
+
+bool SharedMemory::create(std::size_t size_val, const std::string& name_val)
+{
+    close();
+    if (name_val.empty()) {
+        void* mapped = mmap(nullptr, size_val, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED) {
+            printf("SharedMemory: anonymous mapping of %zu bytes failed: %s\n", size_val, strerror(errno));
+            return false;
+        }
+        address = mapped;
+        length = size_val;
+        return true;
+    }
+
+    int fd = shm_open(name_val.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        printf("SharedMemory: shm_open %s failed: %s\n", name_val.c_str(), strerror(errno));
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size_val)) != 0) {
+        printf("SharedMemory: resizing %s failed: %s\n", name_val.c_str(), strerror(errno));
+        ::close(fd);
+        shm_unlink(name_val.c_str());
+        return false;
+    }
+    bool mapped = map(fd, size_val);
+    ::close(fd);
+    if (!mapped) {
+        shm_unlink(name_val.c_str());
+        return false;
+    }
+    // ftruncate zero-fills the new object
+    name = name_val;
+    owner = true;
+    return true;
+}
+
+bool SharedMemory::open(std::size_t size_val, const std::string& name_val)
+{
+    close();
+    int fd = shm_open(name_val.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        printf("SharedMemory: shm_open %s failed: %s\n", name_val.c_str(), strerror(errno));
+        return false;
+    }
+    bool mapped = map(fd, size_val);
+    ::close(fd);
+    if (mapped) name = name_val;
+    return mapped;
+}
+
+void SharedMemory::close()
+{
+    if (address) munmap(address, length);
+    if (owner) shm_unlink(name.c_str());
+    address = nullptr;
+    length = 0;
+    name.clear();
+    owner = false;
+}
+
+bool SharedMemory::map(int fd, std::size_t size_val)
+{
+    void* mapped = mmap(nullptr, size_val, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        printf("SharedMemory: mapping of %zu bytes failed: %s\n", size_val, strerror(errno));
+        return false;
+    }
+    address = mapped;
+    length = size_val;
+    return true;
+}
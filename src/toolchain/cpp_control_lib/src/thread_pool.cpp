@@ -0,0 +1,84 @@
+// Fixed-size worker thread pool implementation
+#include "thread_pool.hpp"
+
+ThreadPool::ThreadPool(std::size_t num_threads)
+    : job(nullptr), job_count(0), generation(0), active_workers(0), next_index(0), stopping(false)
+{
+    if (num_threads == 0) {
+        num_threads = std::thread::hardware_concurrency();
+        if (num_threads == 0) num_threads = 1;
+    }
+    for (std::size_t i = 1; i < num_threads; ++i) {
+        workers.push_back(std::thread(&ThreadPool::workerLoop, this));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    job_ready.notify_all();
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn)
+{
+    if (count == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> submit_lock(submit_mutex);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        job_count = count;
+        next_index.store(0, std::memory_order_relaxed);
+        active_workers = workers.size();
+        ++generation;
+    }
+    job_ready.notify_all();
+
+    runJob();
+
+    // Wait until every worker has left the job before fn goes out of scope
+    std::unique_lock<std::mutex> lock(mutex);
+    job_done.wait(lock, [this]() { return active_workers == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::runJob()
+{
+    for (;;) {
+        std::size_t i = next_index.fetch_add(1, std::memory_order_relaxed);
+        if (i >= job_count) {
+            break;
+        }
+        (*job)(i);
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    std::size_t seen_generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            job_ready.wait(lock, [&]() { return stopping || generation != seen_generation; });
+            if (stopping) {
+                return;
+            }
+            seen_generation = generation;
+        }
+
+        runJob();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--active_workers == 0) {
+            job_done.notify_one();
+        }
+    }
+}
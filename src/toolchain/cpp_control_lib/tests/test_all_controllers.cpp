@@ -1,377 +1,60 @@
 // Test all controller types
-#define _USE_MATH_DEFINES  // Enable math constants like M_PI
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <stdexcept>
 #include <string>
 #include <ctime>  // For time function
 #include "pid_controller.hpp"
-
-// System model base class
-class SystemModel {
-public:
-    virtual ~SystemModel() = default;
-    virtual double compute(double input) = 0;
-    virtual void reset() = 0;
-    virtual std::string get_name() const = 0;
-};
-
-// First-order system model
-class FirstOrderSystem : public SystemModel {
-private:
-    double T;  // Time constant
-    double K;  // Gain
-    double prev_input;  // Previous input
-    double prev_output;  // Previous output
-    double dt;  // Sampling time
-
-public:
-    // Constructor
-    FirstOrderSystem(double T_val, double K_val, double dt_val)
-        : T(T_val), K(K_val), dt(dt_val), prev_input(0.0), prev_output(0.0) {}
-    
-    // Calculate system output
-    double compute(double input) override {
-        // Use Euler method to solve first-order differential equation
-        // dx/dt = (K*u - x)/T
-        double output = prev_output + (dt / T) * (K * input - prev_output);
-        
-        // Update history values
-        prev_input = input;
-        prev_output = output;
-        
-        return output;
-    }
-    
-    // Reset system
-    void reset() override {
-        prev_input = 0.0;
-        prev_output = 0.0;
-    }
-    
-    // Get model name
-    std::string get_name() const override {
-        return "FirstOrderSystem";
-    }
-};
-
-// Second-order system model
-class SecondOrderSystem : public SystemModel {
-private:
-    double K;  // Gain
-    double zeta;  // Damping ratio
-    double omega_n;  // Natural frequency
-    double dt;  // Sampling time
-    double prev_input;  // Previous input
-    double prev_output;  // Previous output
-    double prev_derivative;  // Previous derivative
-
-public:
-    // Constructor
-    SecondOrderSystem(double K_val, double zeta_val, double omega_n_val, double dt_val)
-        : K(K_val), zeta(zeta_val), omega_n(omega_n_val), dt(dt_val),
-          prev_input(0.0), prev_output(0.0), prev_derivative(0.0) {}
-    
-    // Calculate system output
-    double compute(double input) override {
-        // Second-order system: G(s) = K * omega_n^2 / (s^2 + 2*zeta*omega_n*s + omega_n^2)
-        // Using Euler method for numerical integration
-        double acceleration = K * omega_n * omega_n * input - 
-                             2 * zeta * omega_n * prev_derivative - 
-                             omega_n * omega_n * prev_output;
-        
-        double derivative = prev_derivative + acceleration * dt;
-        double output = prev_output + derivative * dt;
-        
-        // Update history values
-        prev_input = input;
-        prev_output = output;
-        prev_derivative = derivative;
-        
-        return output;
-    }
-    
-    // Reset system
-    void reset() override {
-        prev_input = 0.0;
-        prev_output = 0.0;
-        prev_derivative = 0.0;
-    }
-    
-    // Get model name
-    std::string get_name() const override {
-        return "SecondOrderSystem";
-    }
-};
-
-// Nonlinear system model (saturation + deadzone)
-class NonlinearSystem : public SystemModel {
-private:
-    double K;  // Gain
-    double T;  // Time constant
-    double saturation_limit;  // Saturation limit
-    double deadzone_width;  // Deadzone width
-    double dt;  // Sampling time
-    double prev_input;  // Previous input
-    double prev_output;  // Previous output
-
-public:
-    // Constructor
-    NonlinearSystem(double K_val, double T_val, double saturation_limit_val, 
-                   double deadzone_width_val, double dt_val)
-        : K(K_val), T(T_val), saturation_limit(saturation_limit_val),
-          deadzone_width(deadzone_width_val), dt(dt_val),
-          prev_input(0.0), prev_output(0.0) {}
-    
-    // Apply saturation nonlinearity
-    double apply_saturation(double input) {
-        if (input > saturation_limit) {
-            return saturation_limit;
-        } else if (input < -saturation_limit) {
-            return -saturation_limit;
-        }
-        return input;
-    }
-    
-    // Apply deadzone nonlinearity
-    double apply_deadzone(double input) {
-        if (input > deadzone_width) {
-            return input - deadzone_width;
-        } else if (input < -deadzone_width) {
-            return input + deadzone_width;
-        }
-        return 0.0;
-    }
-    
-    // Calculate system output
-    double compute(double input) override {
-        // Apply nonlinearities
-        double nonlinear_input = apply_saturation(input);
-        nonlinear_input = apply_deadzone(nonlinear_input);
-        
-        // First-order dynamics with nonlinear input
-        double output = prev_output + (dt / T) * (K * nonlinear_input - prev_output);
-        
-        // Update history values
-        prev_input = input;
-        prev_output = output;
-        
-        return output;
-    }
-    
-    // Reset system
-    void reset() override {
-        prev_input = 0.0;
-        prev_output = 0.0;
-    }
-    
-    // Get model name
-    std::string get_name() const override {
-        return "NonlinearSystem";
-    }
-};
+#include "system_models.hpp"
+#include "performance_metrics.hpp"
+#include "noise_generator.hpp"
 
 // Noise generator class
+// Thin wrapper over NoiseStream; a non-zero seed makes the noisy runs reproducible
 class NoiseGenerator {
 private:
-    double mean;  // Mean value for Gaussian noise
-    double std_dev;  // Standard deviation for Gaussian noise
-    double max_impulse_amplitude;  // Maximum amplitude for impulse noise
-    double impulse_probability;  // Probability of impulse noise
+    NoiseStream stream;
 
 public:
     // Constructor
     NoiseGenerator(double mean_val = 0.0, double std_dev_val = 0.1, 
-                  double max_impulse_amp = 1.0, double impulse_prob = 0.01)
-        : mean(mean_val), std_dev(std_dev_val), 
-          max_impulse_amplitude(max_impulse_amp), impulse_probability(impulse_prob) {
-        // Seed the random number generator
-        srand(static_cast<unsigned int>(time(nullptr)));
+                  double max_impulse_amp = 1.0, double impulse_prob = 0.01, unsigned int seed = 0)
+        : stream(NoiseConfig(mean_val, std_dev_val, max_impulse_amp, impulse_prob)) {
+        reset_seed(seed);
     }
     
     // Generate Gaussian noise
     double generate_gaussian_noise() {
-        // Simple Box-Muller transform for Gaussian noise
-        static bool has_spare = false;
-        static double z1;
-        
-        if (has_spare) {
-            has_spare = false;
-            return mean + std_dev * z1;
-        }
-        
-        has_spare = true;
-        double u1 = static_cast<double>(rand()) / RAND_MAX;
-        double u2 = static_cast<double>(rand()) / RAND_MAX;
-        
-        double z0 = sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
-        z1 = sqrt(-2.0 * log(u1)) * sin(2.0 * M_PI * u2);
-        
-        return mean + std_dev * z0;
+        return stream.gaussian();
     }
     
     // Generate impulse noise
     double generate_impulse_noise() {
-        double prob = static_cast<double>(rand()) / RAND_MAX;
-        if (prob < impulse_probability) {
-            // Generate random impulse amplitude
-            double amplitude = (static_cast<double>(rand()) / RAND_MAX - 0.5) * 2.0 * max_impulse_amplitude;
-            return amplitude;
-        }
-        return 0.0;
+        return stream.impulse();
     }
     
     // Generate combined noise (Gaussian + impulse)
     double generate_combined_noise() {
-        return generate_gaussian_noise() + generate_impulse_noise();
+        return stream.combined();
     }
     
-    // Reset random seed
+    // Reset random seed (0 seeds from the current time)
     void reset_seed(unsigned int new_seed = 0) {
         if (new_seed == 0) {
-            srand(static_cast<unsigned int>(time(nullptr)));
+            stream.seed(static_cast<std::uint64_t>(time(nullptr)));
         } else {
-            srand(new_seed);
+            stream.seed(new_seed);
         }
     }
 };
 
-// Performance metrics calculation class
-class PerformanceMetrics {
-private:
-    std::vector<double> time;
-    std::vector<double> setpoint;
-    std::vector<double> process_val;
-    std::vector<double> output;
-    
-public:
-    // Add data point
-    void add_data_point(double t, double sp, double pv, double u) {
-        time.push_back(t);
-        setpoint.push_back(sp);
-        process_val.push_back(pv);
-        output.push_back(u);
-    }
-    
-    // Calculate rise time (from 10% to 90% of final value)
-    double calculate_rise_time() {
-        if (time.empty() || process_val.empty()) return 0.0;
-        
-        double final_value = setpoint.back();
-        double low_threshold = 0.1 * final_value;
-        double high_threshold = 0.9 * final_value;
-        
-        bool low_crossed = false;
-        double rise_time = 0.0;
-        
-        for (size_t i = 0; i < process_val.size(); ++i) {
-            if (!low_crossed && process_val[i] >= low_threshold) {
-                low_crossed = true;
-                continue;
-            }
-            
-            if (low_crossed && process_val[i] >= high_threshold) {
-                rise_time = time[i];
-                break;
-            }
-        }
-        
-        return rise_time;
-    }
-    
-    // Calculate overshoot percentage
-    double calculate_overshoot() {
-        if (time.empty() || process_val.empty()) return 0.0;
-        
-        double final_value = setpoint.back();
-        double max_value = *std::max_element(process_val.begin(), process_val.end());
-        
-        if (max_value <= final_value) {
-            return 0.0; // No overshoot
-        }
-        
-        double overshoot = ((max_value - final_value) / final_value) * 100.0;
-        return overshoot;
-    }
-    
-    // Calculate settling time (time to enter 2% error band)
-    double calculate_settling_time() {
-        if (time.empty() || process_val.empty()) return 0.0;
-        
-        double final_value = setpoint.back();
-        double tolerance = 0.02 * final_value;
-        double lower_bound = final_value - tolerance;
-        double upper_bound = final_value + tolerance;
-        
-        double settling_time = 0.0;
-        bool settled = false;
-        
-        for (size_t i = 0; i < process_val.size(); ++i) {
-            if (process_val[i] >= lower_bound && process_val[i] <= upper_bound) {
-                // Check if all subsequent points are within error band
-                settled = true;
-                for (size_t j = i; j < process_val.size(); ++j) {
-                    if (process_val[j] < lower_bound || process_val[j] > upper_bound) {
-                        settled = false;
-                        break;
-                    }
-                }
-                
-                if (settled) {
-                    settling_time = time[i];
-                    break;
-                }
-            }
-        }
-        
-        return settling_time;
-    }
-    
-    // Calculate steady state error
-    double calculate_steady_state_error() {
-        if (time.empty() || process_val.empty()) return 0.0;
-        
-        double final_value = setpoint.back();
-        double steady_state_val = process_val.back();
-        
-        return std::abs(final_value - steady_state_val);
-    }
-    
-    // Save data to file
-    void save_to_file(const std::string& filename) {
-        std::ofstream outfile(filename);
-        if (!outfile.is_open()) {
-            std::cerr << "Failed to open file: " << filename << std::endl;
-            return;
-        }
-        
-        // Write header
-        outfile << "time,setpoint,process_val,output\n";
-        
-        // Write data
-        for (size_t i = 0; i < time.size(); ++i) {
-            outfile << time[i] << "," << setpoint[i] << "," << process_val[i] << "," << output[i] << "\n";
-        }
-        
-        outfile.close();
-    }
-    
-    // Print performance metrics
-    void print_metrics(const std::string& controller_name) {
-        std::cout << "\n=== " << controller_name << " Performance Metrics ===" << std::endl;
-        std::cout << "Rise Time: " << calculate_rise_time() << " seconds" << std::endl;
-        std::cout << "Overshoot: " << calculate_overshoot() << "%" << std::endl;
-        std::cout << "Settling Time: " << calculate_settling_time() << " seconds" << std::endl;
-        std::cout << "Steady State Error: " << calculate_steady_state_error() << std::endl;
-    }
-};
-
 // Test function to test all controllers with a given system model and noise configuration
 void test_controllers(SystemModel& system, NoiseGenerator& noise_gen, const std::string& output_prefix, 
                      double dt, double simulation_time, double setpoint, 
-                     double kp, double ki, double kd, bool add_noise = false) {
+                     double kp, double ki, double kd, bool add_noise = false, bool columnar = false) {
     int steps = static_cast<int>(simulation_time / dt);
     
     // Create controller instances
@@ -395,6 +78,19 @@ void test_controllers(SystemModel& system, NoiseGenerator& noise_gen, const std:
     
     std::cout << "\n=== Testing controllers with " << system_name << " (noise: " << (add_noise ? "enabled" : "disabled") << ") ===" << std::endl;
     
+    // Stream data to files with prefix support
+    const char* extension = columnar ? ".ccol" : ".csv";
+    PerformanceMetrics* all_metrics[] = {&pid_metrics, &incremental_pid_metrics, &fuzzy_pid_metrics, &adaptive_pid_metrics};
+    const char* file_names[] = {"pid_response", "incremental_pid_response", "fuzzy_pid_response", "adaptive_pid_response"};
+    for (int k = 0; k < 4; ++k) {
+        std::string filename = full_prefix + file_names[k] + extension;
+        if (columnar) {
+            all_metrics[k]->stream_to_columnar(filename);
+        } else {
+            all_metrics[k]->stream_to_file(filename);
+        }
+    }
+    
     // Test PID controller
     system.reset();
     double process_val_pid = 0.0;
@@ -477,12 +173,6 @@ void test_controllers(SystemModel& system, NoiseGenerator& noise_gen, const std:
     fuzzy_pid_metrics.print_metrics("Fuzzy PID Controller");
     adaptive_pid_metrics.print_metrics("Adaptive PID Controller");
     
-    // Save data to files with prefix support
-    pid_metrics.save_to_file(full_prefix + "pid_response.csv");
-    incremental_pid_metrics.save_to_file(full_prefix + "incremental_pid_response.csv");
-    fuzzy_pid_metrics.save_to_file(full_prefix + "fuzzy_pid_response.csv");
-    adaptive_pid_metrics.save_to_file(full_prefix + "adaptive_pid_response.csv");
-    
     std::cout << "\nData saved with prefix: " << full_prefix << std::endl;
 }
 
@@ -496,6 +186,25 @@ int main(int argc, char* argv[]) {
             output_prefix += "_";
         }
     }
+    // Optional output format: "csv" (default) or "ccol" for columnar binary files
+    bool columnar = argc > 2 && std::string(argv[2]) == "ccol";
+    // Optional noise seed for reproducible noisy runs, 0 = time based
+    unsigned int noise_seed = 0;
+    if (argc > 3) {
+        std::size_t parsed = 0;
+        unsigned long seed = 0;
+        try {
+            seed = std::stoul(argv[3], &parsed);
+        } catch (const std::logic_error&) {
+            parsed = 0;
+        }
+        if (parsed == 0 || argv[3][parsed] != '\0' || seed > 0xFFFFFFFFUL) {
+            std::cerr << "Invalid noise seed: " << argv[3] << std::endl;
+            std::cerr << "Usage: " << argv[0] << " [output_prefix] [csv|ccol] [noise_seed]" << std::endl;
+            return 1;
+        }
+        noise_seed = static_cast<unsigned int>(seed);
+    }
     
     // Simulation parameters for basic tests
     double dt = 0.1;  // Sampling time (seconds)
@@ -509,7 +218,7 @@ int main(int argc, char* argv[]) {
     double kd = 0.05;
     
     // Create noise generator
-    NoiseGenerator noise_gen(0.0, 0.05, 0.2, 0.02);  // Mean, std_dev, max_impulse, impulse_prob
+    NoiseGenerator noise_gen(0.0, 0.05, 0.2, 0.02, noise_seed);  // Mean, std_dev, max_impulse, impulse_prob, seed
     
     // Create system models
     FirstOrderSystem first_order_sys(1.0, 1.0, dt);  // Time constant, gain, dt
@@ -520,24 +229,26 @@ int main(int argc, char* argv[]) {
     
     // Test 1: Basic tests without noise
     std::cout << "\n--- Test 1: Basic tests without noise ---" << std::endl;
-    test_controllers(first_order_sys, noise_gen, output_prefix, dt, simulation_time, setpoint, kp, ki, kd, false);
-    test_controllers(second_order_sys, noise_gen, output_prefix, dt, simulation_time, setpoint, kp, ki, kd, false);
-    test_controllers(nonlinear_sys, noise_gen, output_prefix, dt, simulation_time, setpoint, kp, ki, kd, false);
+    test_controllers(first_order_sys, noise_gen, output_prefix, dt, simulation_time, setpoint, kp, ki, kd, false, columnar);
+    test_controllers(second_order_sys, noise_gen, output_prefix, dt, simulation_time, setpoint, kp, ki, kd, false, columnar);
+    test_controllers(nonlinear_sys, noise_gen, output_prefix, dt, simulation_time, setpoint, kp, ki, kd, false, columnar);
     
     // Test 2: Tests with noise
     std::cout << "\n--- Test 2: Tests with noise ---" << std::endl;
-    test_controllers(first_order_sys, noise_gen, output_prefix, dt, simulation_time, setpoint, kp, ki, kd, true);
-    test_controllers(second_order_sys, noise_gen, output_prefix, dt, simulation_time, setpoint, kp, ki, kd, true);
-    test_controllers(nonlinear_sys, noise_gen, output_prefix, dt, simulation_time, setpoint, kp, ki, kd, true);
+    test_controllers(first_order_sys, noise_gen, output_prefix, dt, simulation_time, setpoint, kp, ki, kd, true, columnar);
+    test_controllers(second_order_sys, noise_gen, output_prefix, dt, simulation_time, setpoint, kp, ki, kd, true, columnar);
+    test_controllers(nonlinear_sys, noise_gen, output_prefix, dt, simulation_time, setpoint, kp, ki, kd, true, columnar);
     
     // Test 3: Long-term stability test with first-order system
     std::cout << "\n--- Test 3: Long-term stability test (100 seconds) ---" << std::endl;
-    test_controllers(first_order_sys, noise_gen, output_prefix, dt, long_simulation_time, setpoint, kp, ki, kd, true);
+    test_controllers(first_order_sys, noise_gen, output_prefix, dt, long_simulation_time, setpoint, kp, ki, kd, true, columnar);
     
     std::cout << "\n=== All tests completed successfully! ===" << std::endl;
     std::cout << "\nGenerated CSV files can be analyzed using MATLAB scripts for detailed performance evaluation." << std::endl;
     std::cout << "Use command line argument to specify different prefixes and avoid file overwriting." << std::endl;
     std::cout << "Example: test_all_controllers.exe run1" << std::endl;
+    std::cout << "Add \"ccol\" as second argument to write columnar binary files instead of CSV (see tools/read_ccol.py)." << std::endl;
+    std::cout << "A third argument sets the noise seed, e.g. test_all_controllers.exe run1 csv 42" << std::endl;
     
     return 0;
 }
\ No newline at end of file
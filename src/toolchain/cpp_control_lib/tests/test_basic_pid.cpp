@@ -0,0 +1,92 @@
+// BasicPID test - policy-based PID against PIDController and policy behavior checks
+#include <cstdio>
+#include <cmath>
+#include "pid_controller.hpp"
+#include "basic_pid.hpp"
+
+static int failures = 0;
+
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        printf("FAILED: %s\n", message);
+        ++failures;
+    }
+}
+
+int main() {
+    printf("BasicPID Test\n");
+
+    const double kp = 2.0, ki = 1.0, kd = 0.5, dt = 0.01;
+    const double setpoint = 1.0;
+    const int steps = 500;
+
+    // Default policies must reproduce PIDController
+    {
+        PIDController reference(kp, ki, kd, dt);
+        StaticPID pid(kp, ki, kd, dt);
+        ControllerAdapter<StaticPID> adapted(StaticPID(kp, ki, kd, dt));
+        Controller& virtual_pid = adapted;
+
+        double pv = 0.0;
+        double max_diff = 0.0;
+        for (int i = 0; i < steps; ++i) {
+            double expected = reference.compute(setpoint, pv);
+            double output = pid.compute(setpoint, pv);
+            double adapted_output = virtual_pid.compute(setpoint, pv);
+            max_diff = std::fmax(max_diff, std::fabs(output - expected));
+            max_diff = std::fmax(max_diff, std::fabs(adapted_output - expected));
+            pv += dt * (expected - pv);
+        }
+        printf("Default policies max difference: %.3e\n", max_diff);
+        check(max_diff < 1e-9, "default policies diverge from PIDController");
+    }
+
+    // Output clamp keeps output within limits
+    {
+        BasicPID<double, DerivativeOnMeasurement, NoAntiWindup, OutputClamp> pid(
+            kp, ki, kd, dt, NoAntiWindup<double>(), OutputClamp<double>(-0.5, 0.5));
+        double pv = 0.0;
+        for (int i = 0; i < steps; ++i) {
+            double output = pid.compute(setpoint, pv);
+            check(output <= 0.5 && output >= -0.5, "output clamp exceeded");
+            pv += dt * (output - pv);
+        }
+    }
+
+    // Integral clamp bounds the accumulated integral on a plant that cannot respond
+    {
+        BasicPID<float, NoDerivative, IntegralClamp> pid(
+            0.0f, 10.0f, 0.0f, 0.01f, IntegralClamp<float>(-0.2f, 0.2f));
+        float output = 0.0f;
+        for (int i = 0; i < steps; ++i) {
+            output = pid.compute(1.0f, 0.0f);
+        }
+        check(std::fabs(output - 0.2f) < 1e-6f, "integral clamp not applied");
+    }
+
+    // Conditional integration freezes the integral while saturated
+    {
+        BasicPID<double, DerivativeOnError, ConditionalIntegration, OutputClamp> pid(
+            1.0, 10.0, 0.0, dt, ConditionalIntegration<double>(), OutputClamp<double>(-1.0, 1.0));
+        for (int i = 0; i < steps; ++i) {
+            pid.compute(5.0, 0.0);  // Saturated: integral must stay at zero
+        }
+        double output = pid.compute(0.5, 0.0);  // Unsaturated: p = 0.5, integral = 0.05
+        check(std::fabs(output - 0.55) < 1e-9, "conditional integration wound up while saturated");
+    }
+
+    // Reset clears integral and derivative history
+    {
+        StaticPID pid(kp, ki, kd, dt);
+        double first = pid.compute(setpoint, 0.0);
+        pid.compute(setpoint, 0.3);
+        pid.reset();
+        check(std::fabs(pid.compute(setpoint, 0.0) - first) < 1e-12, "reset did not clear state");
+    }
+
+    if (failures != 0) {
+        return 1;
+    }
+    printf("Test completed\n");
+    return 0;
+}
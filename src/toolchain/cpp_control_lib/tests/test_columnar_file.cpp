@@ -0,0 +1,186 @@
+// Columnar file test - round trip, chunking, alignment and corrupt file rejection
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "columnar_file.hpp"
+#include "performance_metrics.hpp"
+
+static int failures = 0;
+
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        printf("FAILED: %s\n", message);
+        ++failures;
+    }
+}
+
+static std::vector<unsigned char> read_bytes(const char* path) {
+    std::vector<unsigned char> bytes;
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr) return bytes;
+    unsigned char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + n);
+    }
+    fclose(f);
+    return bytes;
+}
+
+static void write_bytes(const char* path, const std::vector<unsigned char>& bytes, size_t size) {
+    FILE* f = fopen(path, "wb");
+    if (f == nullptr) return;
+    fwrite(bytes.data(), 1, size, f);
+    fclose(f);
+}
+
+int main() {
+    printf("Columnar File Test\n");
+    const char* path = "test_columnar_file.ccol";
+    const char* corrupt_path = "test_columnar_file_corrupt.ccol";
+
+    // Mixed column types over three full chunks and one partial chunk
+    const int rows = 1000 * 3 + 123;
+    ColumnarWriter writer;
+    check(writer.addColumn("time", COLUMN_FLOAT64) == 0, "add float64 column");
+    check(writer.addColumn("value", COLUMN_FLOAT32) == 1, "add float32 column");
+    check(writer.addColumn("step", COLUMN_INT32) == 2, "add int32 column");
+    check(writer.addColumn("counter", COLUMN_INT64) == 3, "add int64 column");
+    check(writer.open(path, 1000), "open writer");
+    check(writer.addColumn("late", COLUMN_FLOAT64) == -1, "column added after open");
+    for (int i = 0; i < rows; ++i) {
+        double row[4] = {i * 0.001, i * 0.5, static_cast<double>(-i), static_cast<double>(i) * 1000000.0};
+        writer.appendRow(row);
+    }
+    check(writer.numRows() == static_cast<uint64_t>(rows), "writer row count");
+    check(writer.close(), "close writer");
+
+    ColumnarReader reader;
+    check(reader.open(path), "open reader");
+    check(reader.numColumns() == 4 && reader.numRows() == static_cast<uint64_t>(rows), "reader dimensions");
+    check(reader.numChunks() == 4 && reader.chunkRows(0) == 1000 && reader.chunkRows(3) == 123, "chunk layout");
+    check(reader.columnName(2) == "step" && reader.columnType(2) == COLUMN_INT32, "column metadata");
+    check(reader.findColumn("counter") == 3 && reader.findColumn("missing") == -1, "find column");
+
+    bool aligned = true;
+    for (size_t k = 0; k < reader.numChunks(); ++k) {
+        for (size_t c = 0; c < reader.numColumns(); ++c) {
+            aligned = aligned && reinterpret_cast<uintptr_t>(reader.chunkData(k, c)) % columnar_block_alignment == 0;
+        }
+    }
+    check(aligned, "column blocks aligned");
+
+    const float* values = reader.chunkColumn<float>(2, 1);
+    check(values != nullptr && values[7] == 2007 * 0.5f, "typed chunk access");
+    check(reader.chunkColumn<double>(2, 1) == nullptr, "typed access with wrong type");
+    const int64_t* counters = reader.chunkColumn<int64_t>(3, 3);
+    check(counters != nullptr && counters[122] == 3122000000LL, "int64 values");
+
+    std::vector<double> time, step;
+    check(reader.readColumn(0, time) && reader.readColumn(2, step), "read columns");
+    bool same = time.size() == static_cast<size_t>(rows) && step.size() == static_cast<size_t>(rows);
+    for (int i = 0; same && i < rows; ++i) {
+        same = time[i] == i * 0.001 && step[i] == -i;
+    }
+    check(same, "column round trip");
+    reader.close();
+
+    // Truncated and corrupted files are rejected
+    std::vector<unsigned char> bytes = read_bytes(path);
+    write_bytes(corrupt_path, bytes, bytes.size() - 8);
+    check(!reader.open(corrupt_path), "truncated file accepted");
+    write_bytes(corrupt_path, bytes, 32);
+    check(!reader.open(corrupt_path), "header-only file accepted");
+    std::vector<unsigned char> corrupt = bytes;
+    corrupt[0] = 'X';
+    write_bytes(corrupt_path, corrupt, corrupt.size());
+    check(!reader.open(corrupt_path), "bad magic accepted");
+    corrupt = bytes;
+    const ColumnarFileHeader* header = reinterpret_cast<const ColumnarFileHeader*>(bytes.data());
+    size_t first_offset = header->directory_offset + 4 * sizeof(ColumnarColumnInfo) + sizeof(uint64_t);
+    corrupt[first_offset + 5] = 0xff;
+    write_bytes(corrupt_path, corrupt, corrupt.size());
+    check(!reader.open(corrupt_path), "block offset past end accepted");
+    corrupt = bytes;
+    ColumnarColumnInfo* info = reinterpret_cast<ColumnarColumnInfo*>(corrupt.data() + header->directory_offset);
+    info[1].type = 0;
+    info[1].element_size = 0;
+    write_bytes(corrupt_path, corrupt, corrupt.size());
+    check(!reader.open(corrupt_path), "unknown column type with zero element size accepted");
+    corrupt = bytes;
+    info = reinterpret_cast<ColumnarColumnInfo*>(corrupt.data() + header->directory_offset);
+    info[2].type = 99;
+    write_bytes(corrupt_path, corrupt, corrupt.size());
+    check(!reader.open(corrupt_path), "unknown column type accepted");
+    corrupt = bytes;
+    reinterpret_cast<ColumnarFileHeader*>(corrupt.data())->num_chunks = UINT64_MAX / 2;
+    write_bytes(corrupt_path, corrupt, corrupt.size());
+    check(!reader.open(corrupt_path), "oversized chunk count accepted");
+    corrupt = bytes;
+    std::swap(corrupt[offsetof(ColumnarFileHeader, byte_order)], corrupt[offsetof(ColumnarFileHeader, byte_order) + 3]);
+    std::swap(corrupt[offsetof(ColumnarFileHeader, byte_order) + 1], corrupt[offsetof(ColumnarFileHeader, byte_order) + 2]);
+    write_bytes(corrupt_path, corrupt, corrupt.size());
+    check(!reader.open(corrupt_path), "file of the other byte order accepted");
+    remove(corrupt_path);
+
+    // Unfinished file: the placeholder header is never valid
+    {
+        ColumnarWriter unfinished;
+        unfinished.addColumn("x", COLUMN_FLOAT64);
+        unfinished.open(corrupt_path, 16);
+        for (int i = 0; i < 40; ++i) {
+            double x = i;
+            unfinished.appendRow(&x);
+        }
+        check(!reader.open(corrupt_path), "unfinished file accepted");
+    }
+    check(reader.open(corrupt_path) && reader.numRows() == 40, "file closed by destructor");
+    reader.close();
+    remove(corrupt_path);
+
+    // Out-of-range and NaN values saturate in integer columns
+    {
+        ColumnarWriter limits;
+        limits.addColumn("i32", COLUMN_INT32);
+        limits.addColumn("i64", COLUMN_INT64);
+        check(limits.open(corrupt_path), "open limits writer");
+        const double inf = std::numeric_limits<double>::infinity();
+        const double inputs[] = {1e300, -1e300, inf, -inf, std::numeric_limits<double>::quiet_NaN(), -2.7};
+        for (double x : inputs) {
+            double row[2] = {x, x};
+            limits.appendRow(row);
+        }
+        check(limits.close(), "close limits writer");
+    }
+    check(reader.open(corrupt_path), "open limits file");
+    const int32_t* i32 = reader.chunkColumn<int32_t>(0, 0);
+    const int64_t* i64 = reader.chunkColumn<int64_t>(0, 1);
+    check(i32 != nullptr && i32[0] == INT32_MAX && i32[1] == INT32_MIN && i32[2] == INT32_MAX &&
+          i32[3] == INT32_MIN && i32[4] == 0 && i32[5] == -2, "int32 saturation");
+    check(i64 != nullptr && i64[0] == INT64_MAX && i64[1] == INT64_MIN && i64[2] == INT64_MAX &&
+          i64[3] == INT64_MIN && i64[4] == 0 && i64[5] == -2, "int64 saturation");
+    reader.close();
+    remove(corrupt_path);
+
+    // PerformanceMetrics streams its samples to a columnar file
+    {
+        PerformanceMetrics metrics;
+        check(metrics.stream_to_columnar(path), "stream metrics to columnar file");
+        for (int i = 0; i < 100; ++i) {
+            metrics.add_data_point(i * 0.1, 1.0, i * 0.01, 2.0);
+        }
+    }
+    check(reader.open(path) && reader.numRows() == 100 && reader.findColumn("process_val") == 2, "metrics columnar file");
+    check(reader.readColumn(2, step) && step[50] == 0.5, "metrics process values");
+    reader.close();
+    remove(path);
+
+    if (failures != 0) {
+        return 1;
+    }
+    printf("Test completed\n");
+    return 0;
+}
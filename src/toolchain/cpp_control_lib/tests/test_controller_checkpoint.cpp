@@ -0,0 +1,149 @@
+// Controller checkpoint test - bumpless warm restart from snapshots and files
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "controller_checkpoint.hpp"
+#include "pid_controller.hpp"
+
+static int failures = 0;
+
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        printf("FAILED: %s\n", message);
+        ++failures;
+    }
+}
+
+// Drive a controller through a closed loop so integrals, history and adapted gains are non-trivial
+template <typename Real>
+static double run_steps(ControllerT<Real>& controller, double process_val, int steps) {
+    for (int i = 0; i < steps; ++i) {
+        double u = static_cast<double>(controller.compute(Real(1.0), Real(process_val)));
+        process_val += 0.1 * (u - process_val);
+    }
+    return process_val;
+}
+
+// A restored controller produces exactly the outputs of the original
+template <typename Real>
+static bool resumes_identically(ControllerT<Real>& original, ControllerT<Real>& restarted) {
+    double pv = run_steps(original, 0.0, 100);
+    std::vector<unsigned char> snapshot(original.stateSize());
+    if (original.saveState(snapshot.data(), snapshot.size()) != snapshot.size()) return false;
+    if (!restarted.restoreState(snapshot.data(), snapshot.size())) return false;
+
+    for (int i = 0; i < 50; ++i) {
+        Real a = original.compute(Real(1.0), Real(pv));
+        Real b = restarted.compute(Real(1.0), Real(pv));
+        if (!(a == b)) return false;
+        pv += 0.1 * (static_cast<double>(a) - pv);
+    }
+    return true;
+}
+
+int main() {
+    printf("Controller Checkpoint Test\n");
+
+    // Restarted controllers are constructed with different gains; the snapshot overrides them
+    PIDController pid(0.5, 0.1, 0.05, 0.1), pid_restart(1.0, 1.0, 1.0, 0.1);
+    check(resumes_identically<double>(pid, pid_restart), "PID restart");
+    IncrementalPIDController inc(0.5, 0.1, 0.05, 0.1), inc_restart(1.0, 1.0, 1.0, 0.1);
+    check(resumes_identically<double>(inc, inc_restart), "incremental PID restart");
+    FuzzyPIDController fuzzy(0.5, 0.1, 0.05, 0.1), fuzzy_restart(1.0, 1.0, 1.0, 0.1);
+    check(resumes_identically<double>(fuzzy, fuzzy_restart), "fuzzy PID restart");
+    AdaptivePIDController adaptive(0.5, 0.1, 0.05, 0.1), adaptive_restart(0.5, 0.1, 0.05, 0.1);
+    check(resumes_identically<double>(adaptive, adaptive_restart), "adaptive PID restart");
+    PIDControllerQ16 pid_q16(0.5, 0.1, 0.05, 0.1), pid_q16_restart(1.0, 1.0, 1.0, 0.1);
+    check(resumes_identically<Q16_16>(pid_q16, pid_q16_restart), "Q16.16 PID restart");
+
+    // Mismatched snapshots are rejected without touching the controller
+    std::vector<unsigned char> snapshot(pid.stateSize());
+    pid.saveState(snapshot.data(), snapshot.size());
+    check(!adaptive.restoreState(snapshot.data(), snapshot.size()), "restored PID snapshot into adaptive");
+    PIDControllerF pid_float(0.5, 0.1, 0.05, 0.1);
+    check(!pid_float.restoreState(snapshot.data(), snapshot.size()), "restored double snapshot into float");
+    check(!pid_restart.restoreState(snapshot.data(), snapshot.size() - 1), "restored truncated snapshot");
+    check(pid.saveState(snapshot.data(), snapshot.size() - 1) == 0, "saved into a short buffer");
+
+    // Hundreds of controllers through a checkpoint file
+    const std::size_t num_controllers = 600;
+    std::vector<std::unique_ptr<Controller> > running, restarted;
+    std::vector<Controller*> running_ptrs, restarted_ptrs;
+    for (std::size_t i = 0; i < num_controllers; ++i) {
+        double kp = 0.5 + 0.001 * i;
+        switch (i % 4) {
+        case 0: running.emplace_back(new PIDController(kp, 0.1, 0.05, 0.1)); break;
+        case 1: running.emplace_back(new IncrementalPIDController(kp, 0.1, 0.05, 0.1)); break;
+        case 2: running.emplace_back(new FuzzyPIDController(kp, 0.1, 0.05, 0.1)); break;
+        default: running.emplace_back(new AdaptivePIDController(kp, 0.1, 0.05, 0.1)); break;
+        }
+        switch (i % 4) {
+        case 0: restarted.emplace_back(new PIDController(kp, 0.1, 0.05, 0.1)); break;
+        case 1: restarted.emplace_back(new IncrementalPIDController(kp, 0.1, 0.05, 0.1)); break;
+        case 2: restarted.emplace_back(new FuzzyPIDController(kp, 0.1, 0.05, 0.1)); break;
+        default: restarted.emplace_back(new AdaptivePIDController(kp, 0.1, 0.05, 0.1)); break;
+        }
+        run_steps(*running.back(), 0.01 * i, 20 + i % 7);
+        running_ptrs.push_back(running.back().get());
+        restarted_ptrs.push_back(restarted.back().get());
+    }
+
+    ControllerCheckpoint checkpoint;
+    check(checkpoint.capture(running_ptrs.data(), num_controllers), "capture failed");
+    check(checkpoint.saveFile("controller_checkpoint.bin"), "save file failed");
+
+    ControllerCheckpoint loaded;
+    check(loaded.loadFile("controller_checkpoint.bin"), "load file failed");
+    check(loaded.size() == num_controllers, "loaded controller count");
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool restored = loaded.restore(restarted_ptrs.data(), num_controllers);
+    double restore_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    check(restored, "restore failed");
+    printf("Checkpoint: %zu controllers, %zu bytes, restored in %.1f us\n",
+           num_controllers, loaded.data().size(), restore_us);
+    check(restore_us < 1000.0, "restoring took longer than 1 ms");
+
+    bool identical = true;
+    for (std::size_t i = 0; i < num_controllers; ++i) {
+        if (running[i]->compute(1.0, 0.3) != restarted[i]->compute(1.0, 0.3)) identical = false;
+    }
+    check(identical, "restored controllers diverge");
+
+    // Controller order must match the capture
+    std::swap(restarted_ptrs[0], restarted_ptrs[1]);
+    check(!loaded.restore(restarted_ptrs.data(), num_controllers), "restored into reordered controllers");
+    check(!loaded.restore(restarted_ptrs.data(), num_controllers - 1), "restored with wrong count");
+    std::swap(restarted_ptrs[0], restarted_ptrs[1]);
+
+    // A mismatch near the end leaves every controller untouched
+    for (std::size_t i = 0; i < num_controllers; ++i) {
+        restarted[i]->reset();
+    }
+    ControllerCheckpoint before;
+    check(before.capture(restarted_ptrs.data(), num_controllers), "capture before failed");
+    std::swap(restarted_ptrs[num_controllers - 2], restarted_ptrs[num_controllers - 1]);
+    check(!loaded.restore(restarted_ptrs.data(), num_controllers), "restored with late mismatch");
+    std::swap(restarted_ptrs[num_controllers - 2], restarted_ptrs[num_controllers - 1]);
+    ControllerCheckpoint after;
+    check(after.capture(restarted_ptrs.data(), num_controllers), "capture after failed");
+    check(after.data() == before.data(), "failed restore modified controllers");
+
+    // Corruption is detected by the checksum
+    FILE* file = fopen("controller_checkpoint.bin", "r+b");
+    if (file) {
+        fseek(file, 100, SEEK_SET);
+        fputc(0x5A, file);
+        fclose(file);
+    }
+    check(!loaded.loadFile("controller_checkpoint.bin"), "loaded corrupted file");
+    remove("controller_checkpoint.bin");
+
+    if (failures != 0) {
+        return 1;
+    }
+    printf("Test completed\n");
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Co-simulation test - shared-memory ring and controller/plant loop over it
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <unistd.h>
+#include "cosim.hpp"
+#include "pid_controller.hpp"
+#include "shm_ring.hpp"
+
+static int failures = 0;
+
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        printf("FAILED: %s\n", message);
+        ++failures;
+    }
+}
+
+static void check_run(CosimMode mode, const char* label) {
+    CosimConfig config;
+    config.mode = mode;
+    config.duration = 0.5;
+    const double dt = config.period_ns * 1e-9;
+
+    // Fast first-order position loop that settles well within the run
+    CosimResult result = run_cosimulation(config,
+        [dt]() { return std::unique_ptr<Controller>(new PIDController(2.0, 40.0, 0.0, dt)); },
+        [dt]() { return std::unique_ptr<SystemModel>(new FirstOrderSystem(0.05, 1.0, dt)); });
+    printf("\n%s mode\n", label);
+    print_cosim_result(result);
+
+    check(result.ok, "co-simulation completed");
+    check(result.cycles == 500, "cycle count");
+    check(result.plant_wakeup.count() == 500 && result.controller_wakeup.count() == 500, "wake-ups recorded");
+    check(result.loop_delay.count() > 400, "loop delays recorded");
+    check(result.ring_wait.count() > 800, "ring waits recorded");
+    // A command is applied at the plant release after its sample at the earliest
+    check(result.loop_delay.min() > 0 && result.loop_delay.mean() >= 0.5 * config.period_ns, "loop delay too short");
+    check(result.loop_delay.percentile(0.5) <= result.loop_delay.max(), "percentile above maximum");
+    check(result.dropped == 0, "ring overflow");
+    check(std::fabs(result.cosim.steady_state_error) < 0.02, "closed loop settles");
+    check(std::fabs(result.ideal.steady_state_error) < 0.02, "inline reference settles");
+    // Without late samples the co-simulation is the inline loop exactly
+    if (result.stale_measurements == 0 && result.late_commands == 0) {
+        check(result.max_deviation == 0.0, "on-time run differs from inline loop");
+    }
+}
+
+int main() {
+    printf("Co-simulation Test\n");
+
+    // Ring order, full and empty behaviour
+    ShmRing<int, 4> ring;
+    int value = 0;
+    check(!ring.pop(value), "pop from empty ring");
+    for (int i = 0; i < 4; ++i) check(ring.push(i), "push into ring with space");
+    check(!ring.push(4), "push into full ring");
+    check(ring.size() == 4, "ring size");
+    check(ring.pop(value) && value == 0, "FIFO order");
+    check(ring.push(4), "push after pop");
+    check(ring.popLatest(value) == 4 && value == 4, "popLatest keeps newest");
+    check(ring.size() == 0 && !ring.pop(value), "ring drained");
+
+    // Producer and consumer threads over an anonymous shared mapping
+    SharedMemory memory;
+    check(memory.create(sizeof(ShmRing<std::uint64_t, 64>)), "anonymous mapping");
+    if (memory.data()) {
+        ShmRing<std::uint64_t, 64>* shared = new (memory.data()) ShmRing<std::uint64_t, 64>();
+        const std::uint64_t count = 200000;
+        std::thread producer([shared, count]() {
+            for (std::uint64_t i = 0; i < count; ++i) {
+                while (!shared->push(i)) std::this_thread::yield();
+            }
+        });
+        bool in_order = true;
+        for (std::uint64_t expected = 0; expected < count;) {
+            std::uint64_t item;
+            if (shared->pop(item)) {
+                in_order = in_order && item == expected;
+                ++expected;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        check(in_order, "cross-thread order");
+    }
+
+    // Named object seen through a second mapping
+    SharedMemory named;
+    SharedMemory attached;
+    char name[64];
+    snprintf(name, sizeof(name), "/test_cosim_%d", static_cast<int>(getpid()));
+    check(named.create(4096, name), "named mapping");
+    check(attached.open(4096, name), "open named mapping");
+    if (named.data() && attached.data()) {
+        strcpy(static_cast<char*>(named.data()), "joint");
+        check(strcmp(static_cast<const char*>(attached.data()), "joint") == 0, "named mapping shared");
+    }
+
+    check_run(COSIM_THREAD, "Thread");
+    check_run(COSIM_PROCESS, "Process");
+
+    if (failures != 0) {
+        return 1;
+    }
+    printf("Test completed\n");
+    return 0;
+}
@@ -0,0 +1,96 @@
+// Fixed-point test - conversion, saturation and controller integrator behavior
+#include <cstdio>
+#include <cmath>
+#include "fixed_point.hpp"
+#include "pid_controller.hpp"
+
+static int failures = 0;
+
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        printf("FAILED: %s\n", message);
+        ++failures;
+    }
+}
+
+int main() {
+    printf("Fixed-Point Test\n");
+
+    // Conversion round trip within half a resolution step
+    check(std::fabs(static_cast<double>(Q16_16(1.2345)) - 1.2345) <= 0.5 / 65536.0, "Q16.16 conversion");
+    check(std::fabs(static_cast<double>(Q1_31(-0.75)) + 0.75) <= 1e-9, "Q1.31 conversion");
+
+    // Arithmetic
+    check(std::fabs(static_cast<double>(Q16_16(1.5) * Q16_16(-2.25)) + 3.375) < 1e-4, "Q16.16 multiply");
+    check(std::fabs(static_cast<double>(Q16_16(3.0) / Q16_16(4.0)) - 0.75) < 1e-4, "Q16.16 divide");
+    check(std::fabs(static_cast<double>(Q1_31(0.5) * Q1_31(-0.5)) + 0.25) < 1e-9, "Q1.31 multiply");
+
+    // Saturation instead of wrap-around
+    check(Q16_16(40000.0) == Q16_16::max(), "Q16.16 conversion saturates");
+    check(Q16_16(30000.0) + Q16_16(30000.0) == Q16_16::max(), "Q16.16 add saturates");
+    check(Q16_16(-30000.0) - Q16_16(30000.0) == Q16_16::min(), "Q16.16 subtract saturates");
+    check(Q1_31(1.0) == Q1_31::max(), "Q1.31 one saturates");
+    check(Q1_31(-1.0) * Q1_31(-1.0) == Q1_31::max(), "Q1.31 multiply saturates");
+    check(-Q1_31::min() == Q1_31::max(), "Q1.31 negate saturates");
+
+    // A PID integrator driven by a constant error clips at the range limit
+    PIDControllerQ16 pid(0.0, 100.0, 0.0, 1.0);
+    Q16_16 output;
+    for (int i = 0; i < 1000; ++i) {
+        output = pid.compute(Q16_16(100.0), Q16_16(0.0));
+    }
+    check(output == Q16_16::max(), "Q16.16 integrator saturates");
+    output = pid.compute(Q16_16(-100.0), Q16_16(0.0));
+    check(output > Q16_16(0.0), "Q16.16 integrator wrapped around");
+
+    // At dt = 0.001 a small error times ki * dt is below one Q16.16 step;
+    // the integrator must still accumulate it (ki * dt itself is 0.7% off in Q16.16)
+    PIDControllerQ16 slow(0.0, 1.0, 0.0, 0.001);
+    for (int i = 0; i < 1000; ++i) {
+        output = slow.compute(Q16_16(0.005), Q16_16(0.0));
+    }
+    check(std::fabs(static_cast<double>(output) - 0.005) < 5e-5, "Q16.16 integrator drops small errors");
+
+    // Closed loop at 1 kHz with a load offset: the steady-state error is integrated out
+    PIDControllerQ16 loop(2.0, 1.0, 0.0, 0.001);
+    double plant = 0.0;
+    double err = 0.0;
+    for (int i = 0; i < 20000; ++i) {
+        double u = static_cast<double>(loop.compute(Q16_16(0.5), Q16_16(plant)));
+        plant += 0.001 * (u - plant - 0.02);
+        err = 0.5 - plant;
+    }
+    check(std::fabs(err) < 1e-4, "Q16.16 PID leaves a steady-state error at dt = 0.001");
+
+    // Q1.31 position PID on signals normalized into [-1, 1) follows the double reference
+    PIDController normalized(0.5, 0.2, 0.0, 0.001);
+    PIDControllerQ31 q31(0.5, 0.2, 0.0, 0.001);
+    double pv31 = 0.0;
+    double max_diff31 = 0.0;
+    for (int i = 0; i < 5000; ++i) {
+        double u = normalized.compute(0.4, pv31);
+        double u31 = static_cast<double>(q31.compute(Q1_31(0.4), Q1_31(pv31)));
+        max_diff31 = std::fmax(max_diff31, std::fabs(u - u31));
+        pv31 += 0.001 * (u - pv31);
+    }
+    check(max_diff31 < 1e-6, "Q1.31 PID diverges from double reference");
+
+    // Float controller follows the double reference closely
+    PIDController reference(0.5, 0.1, 0.05, 0.1);
+    PIDControllerF single(0.5, 0.1, 0.05, 0.1);
+    double pv = 0.0;
+    double max_diff = 0.0;
+    for (int i = 0; i < 200; ++i) {
+        double u = reference.compute(1.0, pv);
+        float uf = single.compute(1.0f, static_cast<float>(pv));
+        max_diff = std::fmax(max_diff, std::fabs(u - uf));
+        pv += 0.1 * (u - pv);
+    }
+    check(max_diff < 1e-5, "float PID diverges from double reference");
+
+    if (failures != 0) {
+        return 1;
+    }
+    printf("Test completed\n");
+    return 0;
+}
@@ -0,0 +1,104 @@
+// FuzzySurface test - interpolated surface against direct Mamdani inference
+#include <cstdio>
+#include <cmath>
+#include "fuzzy_surface.hpp"
+#include "pid_controller.hpp"
+
+// Rule tables of FuzzyPIDController
+static const int kp_rules[7][7] = {
+    {3, 3, 2, 2, 2, 1, 0},
+    {3, 3, 2, 2, 1, 1, -1},
+    {2, 2, 2, 1, 0, -1, -2},
+    {2, 1, 0, -1, -1, -2, -2},
+    {1, 1, 0, -1, -2, -2, -2},
+    {1, 0, -1, -2, -2, -3, -3},
+    {0, 0, -1, -2, -3, -3, -3}
+};
+static const int ki_rules[7][7] = {
+    {-3, -3, -3, -2, -2, -1, 0},
+    {-3, -3, -2, -2, -1, 0, 0},
+    {-2, -2, -1, -1, 0, 1, 1},
+    {-2, -1, 0, 1, 1, 2, 2},
+    {-1, 0, 1, 1, 2, 2, 3},
+    {0, 0, 1, 2, 2, 3, 3},
+    {0, 1, 2, 2, 3, 3, 3}
+};
+static const int kd_rules[7][7] = {
+    {2, 1, -1, -2, -2, -2, 0},
+    {2, 1, -1, -2, -2, -1, 0},
+    {1, 1, -1, -1, -1, -1, 0},
+    {1, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0},
+    {0, 1, 1, 1, 1, 1, 2},
+    {0, 2, 2, 2, 1, 1, 2}
+};
+
+int main() {
+    printf("FuzzySurface Test\n");
+    int failures = 0;
+
+    // Physical range 1.5 exercises the input normalization
+    const double e_range = 1.5;
+    const double ec_range = 1.5;
+    FuzzySurface surface;
+    surface.build(kp_rules, ki_rules, kd_rules, e_range, ec_range);
+
+    // Sweep a grid offset from the sample nodes and compare with direct inference
+    double max_diff = 0.0;
+    for (int i = -40; i <= 40; ++i) {
+        for (int j = -40; j <= 40; ++j) {
+            double e = i * 0.0371;
+            double ec = j * 0.0371;
+            double kp, ki, kd;
+            double rkp, rki, rkd;
+            surface.evaluate(e, ec, kp, ki, kd);
+            FuzzySurface::infer(kp_rules, ki_rules, kd_rules, e * 3.0 / e_range, ec * 3.0 / ec_range,
+                                1.0, rkp, rki, rkd);
+            max_diff = std::fmax(max_diff, std::fabs(kp - rkp));
+            max_diff = std::fmax(max_diff, std::fabs(ki - rki));
+            max_diff = std::fmax(max_diff, std::fabs(kd - rkd));
+        }
+    }
+    printf("Max interpolation error (universe units): %.4f\n", max_diff);
+    if (max_diff > 0.05) {
+        printf("FAILED: interpolation error too large\n");
+        ++failures;
+    }
+
+    // Inputs beyond the range clamp to the surface edge
+    double kp_edge, ki_edge, kd_edge, kp_far, ki_far, kd_far;
+    surface.evaluate(e_range, -ec_range, kp_edge, ki_edge, kd_edge);
+    surface.evaluate(10.0 * e_range, -10.0 * ec_range, kp_far, ki_far, kd_far);
+    if (std::fabs(kp_edge - kp_far) > 1e-9 || std::fabs(ki_edge - ki_far) > 1e-9 ||
+        std::fabs(kd_edge - kd_far) > 1e-9) {
+        printf("FAILED: out-of-range inputs not clamped\n");
+        ++failures;
+    }
+
+    // NaN inputs must stay on the grid
+    double kp_nan, ki_nan, kd_nan;
+    surface.evaluate(std::nan(""), std::nan(""), kp_nan, ki_nan, kd_nan);
+    if (!(std::fabs(kp_nan) <= 3.0)) {
+        printf("FAILED: NaN input left the surface\n");
+        ++failures;
+    }
+
+    // Closed loop with the smooth controller on a first-order plant
+    FuzzyPIDController fuzzy_pid(2.0, 1.0, 0.1, 0.01, FuzzyPIDController::SMOOTH);
+    double process_val = 0.0;
+    for (int i = 0; i < 1000; ++i) {
+        double output = fuzzy_pid.compute(1.0, process_val);
+        process_val += 0.01 * (output - process_val);
+    }
+    printf("Smooth fuzzy PID final value: %.4f\n", process_val);
+    if (std::fabs(process_val - 1.0) > 0.05) {
+        printf("FAILED: smooth fuzzy PID did not converge\n");
+        ++failures;
+    }
+
+    if (failures != 0) {
+        return 1;
+    }
+    printf("Test completed\n");
+    return 0;
+}
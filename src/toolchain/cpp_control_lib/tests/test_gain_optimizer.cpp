@@ -0,0 +1,77 @@
+// Gain optimizer test - thread pool coverage, early stopping and deterministic tuning
+#include <atomic>
+#include <cstdio>
+#include <vector>
+#include "gain_optimizer.hpp"
+#include "thread_pool.hpp"
+
+static int failures = 0;
+
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        printf("FAILED: %s\n", message);
+        ++failures;
+    }
+}
+
+int main() {
+    printf("Gain Optimizer Test\n");
+
+    // Every index runs exactly once, across repeated jobs
+    ThreadPool pool(4);
+    std::vector<std::atomic<int> > hits(1000);
+    for (int job = 0; job < 3; ++job) {
+        for (std::size_t i = 0; i < hits.size(); ++i) hits[i].store(0);
+        pool.parallelFor(hits.size(), [&](std::size_t i) { hits[i].fetch_add(1); });
+        bool once = true;
+        for (std::size_t i = 0; i < hits.size(); ++i) once = once && hits[i].load() == 1;
+        check(once, "parallelFor did not run every index exactly once");
+    }
+
+    GainOptimizerConfig config = default_optimizer_config(TUNE_PID);
+    config.grid_points = 3;
+    config.num_starts = 3;
+    config.max_iterations = 40;
+    std::vector<TuningScenario> scenarios = default_tuning_scenarios(config.dt);
+    scenarios.resize(1);  // First-order plant only to keep the test fast
+
+    GainSet baseline;
+    baseline.kp = 0.5;
+    baseline.ki = 0.1;
+    baseline.kd = 0.05;
+    baseline.gamma = 0.01;
+    double baseline_cost = evaluate_gains(config, scenarios, baseline);
+
+    // Early stopping returns a cost above the cutoff
+    bool stopped = false;
+    double partial = evaluate_gains(config, scenarios, baseline, 0.5 * baseline_cost, &stopped);
+    check(stopped && partial > 0.5 * baseline_cost && partial <= baseline_cost, "early stop bound");
+
+    config.num_threads = 1;
+    GainOptimizerResult serial = optimize_gains(config, scenarios);
+    config.num_threads = 3;
+    GainOptimizerResult parallel = optimize_gains(config, scenarios);
+    config.num_threads = 6;
+    GainOptimizerResult vertex_parallel = optimize_gains(config, scenarios);
+
+    printf("Baseline cost %.4f, tuned cost %.4f (kp=%.3f ki=%.3f kd=%.3f), %zu evaluations, %zu stopped early\n",
+           baseline_cost, serial.best_cost, serial.best.kp, serial.best.ki, serial.best.kd,
+           serial.evaluations, serial.early_stops);
+    check(serial.best_cost < 0.5 * baseline_cost, "tuned gains not better than hand-picked gains");
+    check(serial.early_stops > 0, "no candidate was stopped early");
+    check(serial.best_cost == parallel.best_cost && serial.best.kp == parallel.best.kp &&
+          serial.best.ki == parallel.best.ki && serial.best.kd == parallel.best.kd,
+          "result depends on the number of threads");
+    check(serial.best_cost == vertex_parallel.best_cost && serial.best.kp == vertex_parallel.best.kp &&
+          serial.best.ki == vertex_parallel.best.ki && serial.best.kd == vertex_parallel.best.kd &&
+          serial.evaluations == vertex_parallel.evaluations,
+          "result changes with parallel vertex evaluation");
+    check(serial.best.kp >= config.lower.kp && serial.best.kp <= config.upper.kp &&
+          serial.best.kd >= config.lower.kd && serial.best.kd <= config.upper.kd, "gains outside search box");
+
+    if (failures != 0) {
+        return 1;
+    }
+    printf("Test completed\n");
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Noise generator test - distribution, stream independence and reproducibility
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "noise_generator.hpp"
+#include "thread_pool.hpp"
+
+static int failures = 0;
+
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        printf("FAILED: %s\n", message);
+        ++failures;
+    }
+}
+
+// Sum of a short noisy run, standing in for one Monte Carlo simulation
+static double run_result(std::uint64_t run) {
+    NoiseStream noise(NoiseConfig(), 7, run);
+    double sum = 0.0;
+    for (int i = 0; i < 1000; ++i) sum += noise.combined();
+    return sum;
+}
+
+int main() {
+    printf("Noise Generator Test\n");
+
+    // Standard normal moments and tail mass from one million samples
+    const int n = 1000000;
+    std::vector<double> z(n);
+    NoiseStream normal(NoiseConfig(0.0, 1.0, 0.0, 0.0), 1234);
+    normal.fillGaussian(z.data(), z.size());
+    double sum = 0.0, sum2 = 0.0, sum4 = 0.0;
+    int within_1 = 0, beyond_3 = 0, beyond_4 = 0;
+    for (int i = 0; i < n; ++i) {
+        sum += z[i];
+        sum2 += z[i] * z[i];
+        sum4 += z[i] * z[i] * z[i] * z[i];
+        if (std::fabs(z[i]) < 1.0) ++within_1;
+        if (std::fabs(z[i]) > 3.0) ++beyond_3;
+        if (std::fabs(z[i]) > 4.0) ++beyond_4;
+    }
+    double mean = sum / n, var = sum2 / n - mean * mean;
+    printf("mean %.5f, variance %.5f, kurtosis %.4f, P(|z|<1) %.5f, P(|z|>3) %.6f, P(|z|>4) %.7f\n",
+           mean, var, sum4 / n / (var * var), within_1 / double(n), beyond_3 / double(n), beyond_4 / double(n));
+    check(std::fabs(mean) < 0.005, "normal mean");
+    check(std::fabs(var - 1.0) < 0.01, "normal variance");
+    check(std::fabs(sum4 / n / (var * var) - 3.0) < 0.05, "normal kurtosis");
+    check(std::fabs(within_1 / double(n) - 0.682689) < 0.002, "normal mass within one sigma");
+    check(std::fabs(beyond_3 / double(n) - 0.0026998) < 0.0004, "normal tail beyond three sigma");
+    check(beyond_4 > 20 && beyond_4 < 130, "normal tail beyond four sigma");
+
+    // Mean and std_dev scaling, impulse rate and amplitude bound
+    NoiseStream noise(NoiseConfig(0.5, 0.05, 0.2, 0.02), 99);
+    noise.fillGaussian(z.data(), z.size());
+    sum = sum2 = 0.0;
+    for (int i = 0; i < n; ++i) {
+        sum += z[i];
+        sum2 += z[i] * z[i];
+    }
+    mean = sum / n;
+    check(std::fabs(mean - 0.5) < 0.001 && std::fabs(std::sqrt(sum2 / n - mean * mean) - 0.05) < 0.001,
+          "scaled Gaussian");
+    noise.fillImpulse(z.data(), z.size());
+    int impulses = 0;
+    bool bounded = true;
+    for (int i = 0; i < n; ++i) {
+        if (z[i] != 0.0) ++impulses;
+        bounded = bounded && std::fabs(z[i]) <= 0.2;
+    }
+    check(std::fabs(impulses / double(n) - 0.02) < 0.001 && bounded, "impulse rate and amplitude");
+
+    // Batches reproduce the scalar sequence of the same stream
+    NoiseStream scalar(NoiseConfig(), 5, 3), batch(NoiseConfig(), 5, 3);
+    std::vector<double> buffer(3000);
+    batch.fillGaussian(buffer.data(), 1000);
+    batch.fillImpulse(buffer.data() + 1000, 1000);
+    batch.fillCombined(buffer.data() + 2000, 1000);
+    bool same = true;
+    for (int i = 0; i < 1000; ++i) same = same && buffer[i] == scalar.gaussian();
+    for (int i = 1000; i < 2000; ++i) same = same && buffer[i] == scalar.impulse();
+    for (int i = 2000; i < 3000; ++i) same = same && buffer[i] == scalar.combined();
+    check(same, "batch matches scalar sequence");
+
+    // Streams of one seed are uncorrelated and differ from other seeds
+    NoiseStream a(NoiseConfig(0.0, 1.0, 0.0, 0.0), 42, 0), b(NoiseConfig(0.0, 1.0, 0.0, 0.0), 42, 1);
+    double cross = 0.0;
+    for (int i = 0; i < n; ++i) cross += a.standardNormal() * b.standardNormal();
+    check(std::fabs(cross / n) < 0.005, "streams uncorrelated");
+    Xoshiro256pp r1(1, 0), r2(2, 0), r3(1, 0);
+    check(r1.next() != r2.next(), "seeds differ");
+    r3.next();
+    r1.jump();
+    r3.jump();
+    check(r1.next() == r3.next(), "jump is deterministic");
+
+    // Parallel Monte Carlo runs give the serial results regardless of scheduling
+    const std::size_t runs = 64;
+    std::vector<double> serial(runs), parallel(runs);
+    for (std::size_t r = 0; r < runs; ++r) serial[r] = run_result(r);
+    ThreadPool pool(4);
+    pool.parallelFor(runs, [&parallel](std::size_t r) { parallel[r] = run_result(r); });
+    check(serial == parallel, "parallel runs reproducible");
+
+    if (failures != 0) {
+        return 1;
+    }
+    printf("Test completed\n");
+    return 0;
+}
@@ -0,0 +1,112 @@
+// ODE solver test - RK4 order, RKF45 error control and plant integration methods
+#include <cmath>
+#include <cstdio>
+#include "ode_solvers.hpp"
+#include "system_models.hpp"
+
+static int failures = 0;
+
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        printf("FAILED: %s\n", message);
+        ++failures;
+    }
+}
+
+// y' = -y, y(0) = 1
+struct Decay {
+    void operator()(double, const double* y, double* dy) const { dy[0] = -y[0]; }
+};
+
+// Harmonic oscillator y'' = -y
+struct Oscillator {
+    void operator()(double, const double* y, double* dy) const {
+        dy[0] = y[1];
+        dy[1] = -y[0];
+    }
+};
+
+static double rk4_error(double h) {
+    Decay f;
+    double y = 1.0;
+    int steps = static_cast<int>(std::lround(2.0 / h));
+    for (int i = 0; i < steps; ++i) rk4_step<1>(f, i * h, &y, h);
+    return std::fabs(y - std::exp(-2.0));
+}
+
+// Unit step response of the second-order plant
+static double second_order_step(double K, double zeta, double wn, double t) {
+    double wd = wn * std::sqrt(1.0 - zeta * zeta);
+    return K * (1.0 - std::exp(-zeta * wn * t) * (std::cos(wd * t) + zeta / std::sqrt(1.0 - zeta * zeta) * std::sin(wd * t)));
+}
+
+static double plant_error(SystemModel& plant, double dt) {
+    double max_error = 0.0;
+    int steps = static_cast<int>(std::lround(10.0 / dt));
+    for (int i = 1; i <= steps; ++i) {
+        double y = plant.compute(1.0);
+        max_error = std::fmax(max_error, std::fabs(y - second_order_step(1.0, 0.3, 2.0, i * dt)));
+    }
+    return max_error;
+}
+
+int main() {
+    printf("ODE Solver Test\n");
+
+    // RK4 is fourth order: halving h divides the error by about 16
+    double ratio = rk4_error(0.1) / rk4_error(0.05);
+    printf("RK4 error ratio for halved step: %.2f\n", ratio);
+    check(ratio > 14.0 && ratio < 18.0, "RK4 convergence order");
+
+    // RKF45 meets its tolerance over a long interval with few steps
+    Oscillator osc;
+    double y[2] = {1.0, 0.0};
+    double h = 0.1;
+    OdeStats stats;
+    rkf45_integrate<2>(osc, 0.0, 10.0, y, h, Rkf45Options(1e-8), &stats);
+    double err = std::fabs(y[0] - std::cos(10.0)) + std::fabs(y[1] + std::sin(10.0));
+    printf("RKF45 error %.3e, %zu accepted, %zu rejected, %zu evaluations\n",
+           err, stats.accepted, stats.rejected, stats.evaluations);
+    check(err < 1e-6, "RKF45 accuracy");
+    check(stats.evaluations == 6 * (stats.accepted + stats.rejected), "RKF45 evaluation count");
+    check(stats.accepted < 500, "RKF45 adapts its step");
+
+    // Plant methods: Euler is the default and unchanged, RK4 and RKF45 are far more accurate
+    const double dt = 0.1;
+    SecondOrderSystem euler(1.0, 0.3, 2.0, dt), rk4(1.0, 0.3, 2.0, dt), rkf45(1.0, 0.3, 2.0, dt);
+    rk4.set_integration(INTEGRATION_RK4);
+    rkf45.set_integration(INTEGRATION_RKF45, 1e-9);
+    check(euler.get_integration() == INTEGRATION_EULER, "Euler default");
+    double euler_err = plant_error(euler, dt);
+    double rk4_err = plant_error(rk4, dt);
+    double rkf45_err = plant_error(rkf45, dt);
+    printf("Second-order step, dt = %.2f: Euler %.3e, RK4 %.3e, RKF45 %.3e (%zu evaluations)\n",
+           dt, euler_err, rk4_err, rkf45_err, rkf45.integration_stats().evaluations);
+    check(rk4_err < euler_err / 100.0, "RK4 plant accuracy");
+    check(rkf45_err < 1e-7, "RKF45 plant accuracy");
+    check(euler.integration_stats().evaluations == 0 && rk4.integration_stats().evaluations == 400,
+          "plant evaluation counts");
+
+    // Reset restarts the same trajectory
+    rkf45.reset();
+    double first = rkf45.compute(1.0);
+    rkf45.reset();
+    check(rkf45.compute(1.0) == first, "reset restarts RKF45 plant");
+
+    // First-order and nonlinear plants with a held input
+    FirstOrderSystem first_order(0.5, 2.0, dt);
+    first_order.set_integration(INTEGRATION_RKF45, 1e-10);
+    double out = 0.0;
+    for (int i = 0; i < 10; ++i) out = first_order.compute(1.0);
+    check(std::fabs(out - 2.0 * (1.0 - std::exp(-1.0 / 0.5))) < 1e-8, "first-order RKF45");
+    NonlinearSystem nonlinear(1.0, 1.0, 0.5, 0.1, dt);
+    nonlinear.set_integration(INTEGRATION_RK4);
+    for (int i = 0; i < 10; ++i) out = nonlinear.compute(2.0);
+    check(std::fabs(out - 0.4 * (1.0 - std::exp(-1.0))) < 1e-6, "nonlinear RK4");
+
+    if (failures != 0) {
+        return 1;
+    }
+    printf("Test completed\n");
+    return 0;
+}
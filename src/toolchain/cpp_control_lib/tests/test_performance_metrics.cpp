@@ -0,0 +1,140 @@
+// Performance metrics test - streaming accumulator against stored-sample reference
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "performance_metrics.hpp"
+#include "pid_controller.hpp"
+#include "system_models.hpp"
+
+static int failures = 0;
+
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        printf("FAILED: %s\n", message);
+        ++failures;
+    }
+}
+
+// Step response metrics computed from stored samples
+struct Reference {
+    std::vector<double> time;
+    std::vector<double> process_val;
+    double final_value;
+
+    double rise_time() const {
+        bool low_crossed = false;
+        for (size_t i = 0; i < process_val.size(); ++i) {
+            if (!low_crossed && process_val[i] >= 0.1 * final_value) {
+                low_crossed = true;
+                continue;
+            }
+            if (low_crossed && process_val[i] >= 0.9 * final_value) return time[i];
+        }
+        return 0.0;
+    }
+
+    double overshoot() const {
+        double max_value = *std::max_element(process_val.begin(), process_val.end());
+        return max_value <= final_value ? 0.0 : (max_value - final_value) / final_value * 100.0;
+    }
+
+    double settling_time() const {
+        double lower = final_value * 0.98, upper = final_value * 1.02;
+        for (size_t i = 0; i < process_val.size(); ++i) {
+            bool settled = true;
+            for (size_t j = i; j < process_val.size(); ++j) {
+                if (process_val[j] < lower || process_val[j] > upper) {
+                    settled = false;
+                    break;
+                }
+            }
+            if (settled) return time[i];
+        }
+        return 0.0;
+    }
+};
+
+static void compare_response(SystemModel& plant, Controller& controller, double noise_amplitude, const char* name) {
+    const double dt = 0.1;
+    const double setpoint = 1.0;
+    PerformanceMetrics metrics;
+    Reference reference;
+    reference.final_value = setpoint;
+
+    double pv = 0.0;
+    double iae = 0.0, ise = 0.0, itae = 0.0, effort = 0.0;
+    unsigned int state = 12345;
+    for (int i = 0; i < 300; ++i) {
+        double t = i * dt;
+        double u = controller.compute(setpoint, pv);
+        state = state * 1103515245u + 12345u;
+        double noise = noise_amplitude * ((state >> 16) / 32768.0 - 1.0);
+        pv = plant.compute(u) + noise;
+
+        metrics.add_data_point(t, setpoint, pv, u);
+        reference.time.push_back(t);
+        reference.process_val.push_back(pv);
+        if (i > 0) {
+            double e = std::fabs(setpoint - pv);
+            iae += e * dt;
+            ise += e * e * dt;
+            itae += t * e * dt;
+            effort += u * u * dt;
+        }
+    }
+
+    char message[128];
+    snprintf(message, sizeof(message), "%s rise time", name);
+    check(metrics.calculate_rise_time() == reference.rise_time(), message);
+    snprintf(message, sizeof(message), "%s overshoot", name);
+    check(metrics.calculate_overshoot() == reference.overshoot(), message);
+    snprintf(message, sizeof(message), "%s settling time", name);
+    check(metrics.calculate_settling_time() == reference.settling_time(), message);
+    snprintf(message, sizeof(message), "%s steady state error", name);
+    check(metrics.calculate_steady_state_error() == std::fabs(setpoint - pv), message);
+    snprintf(message, sizeof(message), "%s integrals", name);
+    check(std::fabs(metrics.calculate_iae() - iae) < 1e-9 && std::fabs(metrics.calculate_ise() - ise) < 1e-9 &&
+          std::fabs(metrics.calculate_itae() - itae) < 1e-9 && std::fabs(metrics.calculate_control_effort() - effort) < 1e-9,
+          message);
+}
+
+int main() {
+    printf("Performance Metrics Test\n");
+
+    // Underdamped response that overshoots and settles
+    SecondOrderSystem second_order(1.0, 0.3, 1.0, 0.1);
+    PIDController pid(1.0, 0.3, 0.1, 0.1);
+    compare_response(second_order, pid, 0.0, "underdamped");
+
+    // Noise keeps leaving and re-entering the settling band
+    FirstOrderSystem first_order(1.0, 1.0, 0.1);
+    PIDController noisy_pid(2.0, 1.0, 0.0, 0.1);
+    compare_response(first_order, noisy_pid, 0.03, "noisy");
+
+    // Never reaches the setpoint
+    NonlinearSystem nonlinear(1.0, 1.0, 0.5, 0.1, 0.1);
+    PIDController saturated_pid(0.5, 0.1, 0.05, 0.1);
+    compare_response(nonlinear, saturated_pid, 0.0, "saturated");
+
+    // A setpoint change restarts the step response metrics
+    PerformanceMetrics metrics;
+    metrics.add_data_point(0.0, 1.0, 0.0, 0.0);
+    metrics.add_data_point(1.0, 1.0, 1.5, 0.0);
+    metrics.add_data_point(2.0, 1.0, 1.0, 0.0);
+    metrics.add_data_point(3.0, 2.0, 1.0, 0.0);
+    metrics.add_data_point(4.0, 2.0, 2.0, 0.0);
+    check(metrics.calculate_overshoot() == 0.0, "overshoot carried over a setpoint change");
+    check(metrics.calculate_settling_time() == 4.0, "settling time after setpoint change");
+    check(metrics.calculate_steady_state_error() == 0.0, "steady state error after setpoint change");
+    check(std::fabs(metrics.calculate_iae() - 1.5) < 1e-12, "IAE spans the whole run");
+
+    metrics.reset();
+    check(metrics.sample_count() == 0 && metrics.calculate_iae() == 0.0, "reset");
+
+    if (failures != 0) {
+        return 1;
+    }
+    printf("Test completed\n");
+    return 0;
+}
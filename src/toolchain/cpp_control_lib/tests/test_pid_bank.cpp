@@ -0,0 +1,64 @@
+// PIDBank test - compare batched bank against independent PIDController objects
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "pid_controller.hpp"
+#include "pid_bank.hpp"
+
+int main() {
+    printf("PIDBank Test\n");
+
+    const std::size_t num_joints = 13;  // Not a multiple of the SIMD width on purpose
+    const double dt = 0.01;
+    const int steps = 500;
+
+    PIDBank bank(num_joints, 2.0, 1.0, 0.5, dt);
+    std::vector<PIDController> reference;
+    for (std::size_t j = 0; j < num_joints; ++j) {
+        double kp = 2.0 + 0.1 * j;
+        double ki = 1.0 + 0.05 * j;
+        double kd = 0.5 + 0.01 * j;
+        bank.setGains(j, kp, ki, kd);
+        reference.push_back(PIDController(kp, ki, kd, dt));
+    }
+
+    std::vector<double> setpoints(num_joints);
+    std::vector<double> process_vals(num_joints, 0.0);
+    std::vector<double> outputs(num_joints);
+    for (std::size_t j = 0; j < num_joints; ++j) {
+        setpoints[j] = 0.5 + 0.1 * j;
+    }
+
+    double max_diff = 0.0;
+    for (int i = 0; i < steps; ++i) {
+        bank.compute(setpoints.data(), process_vals.data(), outputs.data());
+        for (std::size_t j = 0; j < num_joints; ++j) {
+            double expected = reference[j].compute(setpoints[j], process_vals[j]);
+            double diff = std::fabs(outputs[j] - expected);
+            if (diff > max_diff) max_diff = diff;
+
+            // Simple first-order system model: G(s) = 1/(s+1)
+            process_vals[j] += dt * (outputs[j] - process_vals[j]);
+        }
+    }
+
+    printf("Joints: %zu, Steps: %d, Max output difference: %.3e\n", num_joints, steps, max_diff);
+    if (max_diff > 1e-9) {
+        printf("FAILED: bank output diverges from PIDController\n");
+        return 1;
+    }
+
+    bank.reset();
+    for (std::size_t j = 0; j < num_joints; ++j) {
+        process_vals[j] = 0.0;
+    }
+    bank.compute(setpoints.data(), process_vals.data(), outputs.data());
+    PIDController fresh(2.0 + 0.1 * 3, 1.0 + 0.05 * 3, 0.5 + 0.01 * 3, dt);
+    if (std::fabs(outputs[3] - fresh.compute(setpoints[3], 0.0)) > 1e-12) {
+        printf("FAILED: reset did not clear joint state\n");
+        return 1;
+    }
+
+    printf("Test completed\n");
+    return 0;
+}
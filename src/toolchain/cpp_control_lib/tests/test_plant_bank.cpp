@@ -0,0 +1,90 @@
+// PlantBank test - compare batched plants against the scalar system models
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "plant_bank.hpp"
+#include "system_models.hpp"
+
+static int failures = 0;
+
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        printf("FAILED: %s\n", message);
+        ++failures;
+    }
+}
+
+// Drive bank and scalar models with the same inputs; outputs must be identical
+static bool matches_models(PlantBank& bank, std::vector<std::unique_ptr<SystemModel> >& models, int steps) {
+    const std::size_t n = bank.size();
+    std::vector<double> inputs(n), outputs(n);
+    for (int k = 0; k < steps; ++k) {
+        for (std::size_t i = 0; i < n; ++i) {
+            // Inputs sweep through saturation and deadzone
+            inputs[i] = 0.8 * ((k * 7 + i * 3) % 41 - 20) / 20.0;
+        }
+        bank.step(inputs.data(), outputs.data());
+        for (std::size_t i = 0; i < n; ++i) {
+            if (outputs[i] != models[i]->compute(inputs[i]) || outputs[i] != bank.output(i)) return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    printf("PlantBank Test\n");
+
+    const std::size_t n = 13;  // Not a multiple of the SIMD width on purpose
+    const double dt = 0.01;
+
+    PlantBank first(PLANT_FIRST_ORDER, n, dt);
+    PlantBank second(PLANT_SECOND_ORDER, n, dt);
+    PlantBank nonlinear(PLANT_NONLINEAR, n, dt);
+    std::vector<std::unique_ptr<SystemModel> > first_models, second_models, nonlinear_models;
+    for (std::size_t i = 0; i < n; ++i) {
+        first.setFirstOrder(i, 0.5 + 0.1 * i, 1.0 + 0.05 * i);
+        first_models.push_back(std::unique_ptr<SystemModel>(new FirstOrderSystem(0.5 + 0.1 * i, 1.0 + 0.05 * i, dt)));
+        second.setSecondOrder(i, 1.0 + 0.05 * i, 0.2 + 0.07 * i, 1.0 + 0.3 * i);
+        second_models.push_back(std::unique_ptr<SystemModel>(
+            new SecondOrderSystem(1.0 + 0.05 * i, 0.2 + 0.07 * i, 1.0 + 0.3 * i, dt)));
+        nonlinear.setNonlinear(i, 1.0 + 0.05 * i, 0.5 + 0.1 * i, 0.3 + 0.02 * i, 0.05 + 0.01 * i);
+        nonlinear_models.push_back(std::unique_ptr<SystemModel>(
+            new NonlinearSystem(1.0 + 0.05 * i, 0.5 + 0.1 * i, 0.3 + 0.02 * i, 0.05 + 0.01 * i, dt)));
+    }
+    check(matches_models(first, first_models, 500), "first-order plants match FirstOrderSystem");
+    check(matches_models(second, second_models, 500), "second-order plants match SecondOrderSystem");
+    check(matches_models(nonlinear, nonlinear_models, 500), "nonlinear plants match NonlinearSystem");
+
+    // Reset clears all state
+    second.reset();
+    for (std::size_t i = 0; i < n; ++i) second_models[i]->reset();
+    check(matches_models(second, second_models, 50), "reset");
+
+    // Nominal parameters are those of test_all_controllers
+    PlantBank nominal(PLANT_NONLINEAR, 3, 0.1);
+    std::vector<std::unique_ptr<SystemModel> > nominal_models;
+    for (int i = 0; i < 3; ++i) {
+        nominal_models.push_back(std::unique_ptr<SystemModel>(new NonlinearSystem(1.0, 1.0, 0.5, 0.1, 0.1)));
+    }
+    check(matches_models(nominal, nominal_models, 100), "nominal parameters");
+
+    // Perturbation is reproducible and changes every plant
+    PlantBank a(PLANT_SECOND_ORDER, 100, dt), b(PLANT_SECOND_ORDER, 100, dt), c(PLANT_SECOND_ORDER, 100, dt);
+    a.perturb(0.2, 11);
+    b.perturb(0.2, 11);
+    std::vector<double> inputs(100, 1.0), out_a(100), out_b(100), out_c(100);
+    for (int k = 0; k < 100; ++k) {
+        a.step(inputs.data(), out_a.data());
+        b.step(inputs.data(), out_b.data());
+        c.step(inputs.data(), out_c.data());
+    }
+    bool distinct = true;
+    for (std::size_t i = 0; i < 100; ++i) distinct = distinct && out_a[i] != out_c[i];
+    check(out_a == out_b && distinct, "reproducible perturbation");
+
+    if (failures != 0) {
+        return 1;
+    }
+    printf("Test completed\n");
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Scenario runner test - config parsing, matrix expansion and thread-count independence
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include "performance_metrics.hpp"
+#include "pid_controller.hpp"
+#include "scenario_runner.hpp"
+#include "system_models.hpp"
+
+static int failures = 0;
+
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        printf("FAILED: %s\n", message);
+        ++failures;
+    }
+}
+
+static bool same_results(const std::vector<ScenarioResult>& a, const std::vector<ScenarioResult>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].cell.controller != b[i].cell.controller || a[i].cell.seed != b[i].cell.seed ||
+            a[i].itae != b[i].itae || a[i].overshoot != b[i].overshoot || a[i].control_effort != b[i].control_effort) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    printf("Scenario Runner Test\n");
+
+    std::istringstream config(
+        "# comment line\n"
+        "controllers = pid, adaptive_pid\n"
+        "plants = first_order, nonlinear   # trailing comment\n"
+        "noise = off, on\n"
+        "seeds = 3, 4, 5\n"
+        "durations = 5, 10\n"
+        "dt = 0.05\n"
+        "kp = 0.8\n"
+        "output = none\n");
+    ScenarioMatrix matrix;
+    check(parse_scenario_matrix(config, matrix), "parse config");
+    check(matrix.controllers.size() == 2 && matrix.controllers[1] == TUNE_ADAPTIVE_PID, "controllers");
+    check(matrix.plants.size() == 2 && matrix.plants[1] == PLANT_NONLINEAR, "plants");
+    check(matrix.seeds.size() == 3 && matrix.seeds[2] == 5 && matrix.dt == 0.05 && matrix.gains.kp == 0.8,
+          "numeric settings");
+    check(matrix.gains.ki == 0.1, "unset values keep defaults");
+
+    // Noise-free cells are not repeated per seed: 2 durations x (1 + 3 seeds) x 2 plants x 2 controllers
+    std::vector<ScenarioCell> cells = expand_scenario_matrix(matrix);
+    check(cells.size() == 32, "matrix expansion");
+
+    std::istringstream bad_key("controllers = pid\nunknown = 1\n");
+    ScenarioMatrix rejected;
+    check(!parse_scenario_matrix(bad_key, rejected), "unknown key rejected");
+    std::istringstream bad_value("plants = first_order, third_order\n");
+    check(!parse_scenario_matrix(bad_value, rejected), "unknown plant rejected");
+
+    // Seeds are full 64-bit integers and 0 is a valid seed
+    std::istringstream seeds("seeds = 0, 18446744073709551615, 9007199254740993\n");
+    ScenarioMatrix seeded;
+    check(parse_scenario_matrix(seeds, seeded) && seeded.seeds.size() == 3 && seeded.seeds[0] == 0 &&
+          seeded.seeds[1] == 18446744073709551615ULL && seeded.seeds[2] == 9007199254740993ULL, "seed parsing");
+    const char* bad_seeds[] = {"seeds = -1\n", "seeds = 1.5\n", "seeds = 18446744073709551616\n", "seeds = 7x\n"};
+    for (int i = 0; i < 4; ++i) {
+        std::istringstream bad_seed(bad_seeds[i]);
+        check(!parse_scenario_matrix(bad_seed, rejected), "invalid seed rejected");
+    }
+
+    // Results do not depend on the number of threads
+    matrix.num_threads = 1;
+    std::vector<ScenarioResult> serial = run_scenario_matrix(matrix);
+    matrix.num_threads = 4;
+    std::vector<ScenarioResult> parallel = run_scenario_matrix(matrix);
+    check(same_results(serial, parallel), "parallel results match serial results");
+
+    // Controllers in one plant/noise/seed cell see the same noise; seeds differ
+    check(serial[4].cell.noise && serial[4].cell.seed == 3 && serial[8].cell.seed == 4 &&
+          serial[4].itae != serial[8].itae, "seeds change the noise");
+
+    // A noise-free cell reproduces the test_all_controllers loop
+    PIDController pid(0.8, 0.1, 0.05, 0.05);
+    FirstOrderSystem plant(1.0, 1.0, 0.05);
+    PerformanceMetrics metrics;
+    double process_val = 0.0;
+    for (int i = 0; i < static_cast<int>(5.0 / 0.05); ++i) {
+        double u = pid.compute(1.0, process_val);
+        process_val = plant.compute(u);
+        metrics.add_data_point(i * 0.05, 1.0, process_val, u);
+    }
+    check(serial[0].cell.controller == TUNE_PID && serial[0].cell.plant == PLANT_FIRST_ORDER &&
+          serial[0].itae == metrics.calculate_itae(), "cell matches the reference loop");
+    check(serial[0].ok, "cell without output failed");
+
+    // A cell whose output file cannot be opened fails
+    ScenarioMatrix unwritable = matrix;
+    unwritable.output = SCENARIO_OUTPUT_CSV;
+    unwritable.output_prefix = "missing_directory/";
+    ScenarioResult failed = run_scenario_cell(unwritable, cells[0]);
+    check(!failed.ok && failed.itae == 0.0, "unwritable output did not fail the cell");
+    unwritable.output = SCENARIO_OUTPUT_CCOL;
+    check(!run_scenario_cell(unwritable, cells[0]).ok, "unwritable columnar output did not fail the cell");
+
+    if (failures != 0) {
+        return 1;
+    }
+    printf("Test completed\n");
+    return 0;
+}
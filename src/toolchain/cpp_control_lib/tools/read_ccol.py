@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""Reader and CSV converter for columnar binary result files (.ccol).
+
+The file is memory-mapped and each column block is used in place: with
+numpy installed every column is returned as a numpy array (one copy per
+column to join the chunks), otherwise as a memoryview-backed list.
+See include/columnar_file.hpp for the file layout.
+
+Usage:
+    read_ccol.py FILE.ccol              print a summary of the columns
+    read_ccol.py FILE.ccol OUT.csv      convert to CSV
+"""
+
+import mmap
+import struct
+import sys
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+HEADER_SIZE = 64
+BYTE_ORDER_OFFSET = 40
+BYTE_ORDERS = {b"\x04\x03\x02\x01": "<", b"\x01\x02\x03\x04": ">"}
+TYPES = {1: "d", 2: "f", 3: "i", 4: "q"}
+NATIVE_ORDER = "<" if sys.byteorder == "little" else ">"
+
+
+def read_ccol(path):
+    """Return an ordered list of (name, values) pairs for every column."""
+    with open(path, "rb") as f:
+        data = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    if len(data) < HEADER_SIZE:
+        raise ValueError("not a columnar file: %s" % path)
+    # Values are in the writer's byte order, given by the header's byte order mark
+    order = BYTE_ORDERS.get(data[BYTE_ORDER_OFFSET:BYTE_ORDER_OFFSET + 4])
+    header = struct.Struct((order or "<") + "4sIIIQQQ24x")
+    magic, version, num_columns, _, num_rows, num_chunks, directory_offset = header.unpack_from(data, 0)
+    if magic != b"CCOL" or version != 2 or order is None:
+        raise ValueError("not a columnar file: %s" % path)
+
+    column_info = struct.Struct(order + "40sII")
+    columns = []
+    offset = directory_offset
+    for _ in range(num_columns):
+        name, type_id, element_size = column_info.unpack_from(data, offset)
+        if type_id not in TYPES or struct.calcsize(TYPES[type_id]) != element_size:
+            raise ValueError("unknown column type %d" % type_id)
+        columns.append((name.rstrip(b"\0").decode("utf-8", "replace"), type_id, element_size))
+        offset += column_info.size
+    stride = 1 + num_columns
+    index = struct.unpack_from("%s%dQ" % (order, num_chunks * stride), data, offset)
+
+    view = memoryview(data)
+    result = []
+    for c, (name, type_id, element_size) in enumerate(columns):
+        blocks = []
+        for k in range(num_chunks):
+            rows = index[k * stride]
+            start = index[k * stride + 1 + c]
+            end = start + rows * element_size
+            if end > len(data):
+                raise ValueError("truncated columnar file: %s" % path)
+            if numpy is not None:
+                blocks.append(numpy.frombuffer(data, dtype=order + TYPES[type_id], count=rows, offset=start))
+            elif order == NATIVE_ORDER:
+                blocks.append(view[start:end].cast(TYPES[type_id]))
+            else:
+                blocks.append(struct.unpack_from("%s%d%s" % (order, rows, TYPES[type_id]), data, start))
+        if numpy is not None:
+            values = numpy.concatenate(blocks) if blocks else numpy.empty(0, order + TYPES[type_id])
+        else:
+            values = [v for block in blocks for v in block]
+        if len(values) != num_rows:
+            raise ValueError("row count mismatch in %s" % path)
+        result.append((name, values))
+    return result
+
+
+def write_csv(columns, path):
+    with open(path, "w") as out:
+        out.write(",".join(name for name, _ in columns) + "\n")
+        for row in zip(*(values for _, values in columns)):
+            out.write(",".join(repr(float(v)) if isinstance(v, float) else str(v) for v in row) + "\n")
+
+
+def main(argv):
+    if len(argv) not in (2, 3):
+        sys.stderr.write(__doc__)
+        return 1
+    columns = read_ccol(argv[1])
+    if len(argv) == 3:
+        write_csv(columns, argv[2])
+        return 0
+    for name, values in columns:
+        if len(values):
+            print("%-20s rows=%d first=%s last=%s" % (name, len(values), values[0], values[-1]))
+        else:
+            print("%-20s rows=0" % name)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,86 @@
+// Co-simulation tool - controller and plant exchanging JointData_t at 1 kHz
+//
+// Usage: run_cosim [thread|process] [controller] [plant] [seconds] [offset_us] [priority] [output.csv]
+// Controllers and plants use the scenario config names (pid, first_order, ...).
+// A priority above 0 runs both sides with SCHED_FIFO, which needs privileges.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "cosim.hpp"
+#include "gain_optimizer.hpp"
+#include "scenario_runner.hpp"
+
+int main(int argc, char* argv[]) {
+    CosimConfig config;
+    config.duration = 10.0;
+    TunedController controller_type = TUNE_PID;
+    PlantType plant_type = PLANT_FIRST_ORDER;
+
+    bool valid = true;
+    if (argc > 1) {
+        if (strcmp(argv[1], "process") == 0) {
+            config.mode = COSIM_PROCESS;
+        } else if (strcmp(argv[1], "thread") != 0) {
+            valid = false;
+        }
+    }
+    if (argc > 2) {
+        const TunedController controllers[] = {TUNE_PID, TUNE_INCREMENTAL_PID, TUNE_FUZZY_PID, TUNE_ADAPTIVE_PID};
+        bool found = false;
+        for (int i = 0; i < 4; ++i) {
+            if (strcmp(argv[2], scenario_controller_name(controllers[i])) == 0) {
+                controller_type = controllers[i];
+                found = true;
+            }
+        }
+        valid = valid && found;
+    }
+    if (argc > 3) {
+        const PlantType plants[] = {PLANT_FIRST_ORDER, PLANT_SECOND_ORDER, PLANT_NONLINEAR};
+        bool found = false;
+        for (int i = 0; i < 3; ++i) {
+            if (strcmp(argv[3], scenario_plant_name(plants[i])) == 0) {
+                plant_type = plants[i];
+                found = true;
+            }
+        }
+        valid = valid && found;
+    }
+    if (argc > 4) config.duration = atof(argv[4]);
+    if (argc > 5) config.controller_offset_ns = atol(argv[5]) * 1000;
+    if (argc > 6) config.plant_priority = config.controller_priority = atoi(argv[6]);
+    if (argc > 7) config.output_file = argv[7];
+    if (!valid || config.duration <= 0.0 || config.controller_offset_ns < 0 ||
+        config.controller_offset_ns >= config.period_ns) {
+        fprintf(stderr, "Usage: %s [thread|process] [controller] [plant] [seconds] [offset_us] [priority] [output.csv]\n",
+                argv[0]);
+        return 1;
+    }
+
+    // Gains for the 1 kHz loop; the plants are the test_all_controllers plants
+    GainSet gains;
+    gains.kp = 2.0;
+    gains.ki = 1.0;
+    gains.kd = 0.05;
+    gains.gamma = 0.01;
+    const double dt = config.period_ns * 1e-9;
+
+    CosimResult result = run_cosimulation(config,
+        [&]() { return make_tuned_controller(controller_type, gains, dt); },
+        [&]() -> std::unique_ptr<SystemModel> {
+            switch (plant_type) {
+            case PLANT_SECOND_ORDER:
+                return std::unique_ptr<SystemModel>(new SecondOrderSystem(1.0, 0.7, 1.0, dt));
+            case PLANT_NONLINEAR:
+                return std::unique_ptr<SystemModel>(new NonlinearSystem(1.0, 1.0, 0.5, 0.1, dt));
+            default:
+                return std::unique_ptr<SystemModel>(new FirstOrderSystem(1.0, 1.0, dt));
+            }
+        });
+
+    printf("%s / %s, plant in a %s, controller offset %ld us\n", scenario_controller_name(controller_type),
+           scenario_plant_name(plant_type), config.mode == COSIM_PROCESS ? "process" : "thread",
+           config.controller_offset_ns / 1000);
+    print_cosim_result(result);
+    return result.ok ? 0 : 1;
+}
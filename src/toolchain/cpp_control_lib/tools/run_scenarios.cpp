@@ -0,0 +1,54 @@
+// Scenario matrix tool - run controller x plant x noise x seed cells in parallel
+//
+// Usage: run_scenarios [config] [threads]
+// Without a config file the test_all_controllers matrix is run.
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "scenario_runner.hpp"
+
+int main(int argc, char* argv[]) {
+    ScenarioMatrix matrix;
+    if (argc > 1 && !load_scenario_matrix(argv[1], matrix)) {
+        fprintf(stderr, "Usage: %s [config] [threads]\n", argv[0]);
+        return 1;
+    }
+    if (argc > 2) {
+        // A positive thread count with no trailing characters
+        char* end = nullptr;
+        errno = 0;
+        long threads = strtol(argv[2], &end, 10);
+        if (end == argv[2] || *end != '\0' || errno == ERANGE || threads < 1) {
+            fprintf(stderr, "Invalid thread count: %s\n", argv[2]);
+            fprintf(stderr, "Usage: %s [config] [threads]\n", argv[0]);
+            return 1;
+        }
+        matrix.num_threads = static_cast<std::size_t>(threads);
+    }
+
+    std::size_t num_cells = expand_scenario_matrix(matrix).size();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<ScenarioResult> results = run_scenario_matrix(matrix);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t num_failed = 0;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        if (!results[i].ok) {
+            fprintf(stderr, "Cell failed, cannot write %s\n", results[i].output_file.c_str());
+            ++num_failed;
+        }
+    }
+
+    print_scenario_summary(results);
+    std::string results_file = matrix.output_prefix + "scenario_results.csv";
+    if (!write_scenario_results(results_file, results)) {
+        return 1;
+    }
+    printf("\n%zu cells in %.3f s, results saved to %s\n", num_cells, seconds, results_file.c_str());
+    if (num_failed != 0) {
+        fprintf(stderr, "%zu of %zu cells failed\n", num_failed, num_cells);
+        return 1;
+    }
+    return 0;
+}
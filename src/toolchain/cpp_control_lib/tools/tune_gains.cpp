@@ -0,0 +1,54 @@
+// Gain tuning tool - optimize controller gains over the test_all_controllers plants
+//
+// Usage: tune_gains [pid|incremental|fuzzy|adaptive] [threads]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "gain_optimizer.hpp"
+
+int main(int argc, char* argv[]) {
+    TunedController controller = TUNE_PID;
+    const char* name = argc > 1 ? argv[1] : "pid";
+    if (strcmp(name, "pid") == 0) {
+        controller = TUNE_PID;
+    } else if (strcmp(name, "incremental") == 0) {
+        controller = TUNE_INCREMENTAL_PID;
+    } else if (strcmp(name, "fuzzy") == 0) {
+        controller = TUNE_FUZZY_PID;
+    } else if (strcmp(name, "adaptive") == 0) {
+        controller = TUNE_ADAPTIVE_PID;
+    } else {
+        fprintf(stderr, "Usage: %s [pid|incremental|fuzzy|adaptive] [threads]\n", argv[0]);
+        return 1;
+    }
+
+    GainOptimizerConfig config = default_optimizer_config(controller);
+    if (argc > 2) {
+        config.num_threads = static_cast<std::size_t>(atoi(argv[2]));
+    }
+    std::vector<TuningScenario> scenarios = default_tuning_scenarios(config.dt);
+
+    // Hand-picked gains of test_all_controllers for reference
+    GainSet baseline;
+    baseline.kp = 0.5;
+    baseline.ki = 0.1;
+    baseline.kd = 0.05;
+    baseline.gamma = 0.01;
+    double baseline_cost = evaluate_gains(config, scenarios, baseline);
+
+    GainOptimizerResult result = optimize_gains(config, scenarios);
+
+    printf("Controller: %s\n", name);
+    printf("Baseline gains: kp=%.4f ki=%.4f kd=%.4f gamma=%.4f cost=%.4f\n",
+           baseline.kp, baseline.ki, baseline.kd, baseline.gamma, baseline_cost);
+    printf("Tuned gains:    kp=%.4f ki=%.4f kd=%.4f gamma=%.4f cost=%.4f\n",
+           result.best.kp, result.best.ki, result.best.kd, result.best.gamma, result.best_cost);
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        std::vector<TuningScenario> single(1, scenarios[i]);
+        printf("  %-18s baseline %.4f  tuned %.4f\n", scenarios[i].name.c_str(),
+               evaluate_gains(config, single, baseline), evaluate_gains(config, single, result.best));
+    }
+    printf("Evaluations: %zu (%zu stopped early), %.2f s\n",
+           result.evaluations, result.early_stops, result.elapsed_seconds);
+    return 0;
+}